@@ -0,0 +1,15 @@
+#ifndef BS_BENCH_H
+#define BS_BENCH_H
+
+#include "bs/common.h"
+
+/* Each bench times the optimized path against its reference, prints one line per run and returns
+ * false if any result differed from the reference. */
+double bs_bench_now_millis(void);
+bool bs_bench_motion(size_t instance_count, size_t frame_count);
+bool bs_bench_solid(size_t moving_count, size_t static_count, size_t frame_count);
+bool bs_bench_mask(size_t pair_count, size_t frame_count);
+bool bs_bench_load(const char *game_path);
+bool bs_bench_decode(const char *game_path);
+
+#endif
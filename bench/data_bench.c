@@ -0,0 +1,488 @@
+#include "bench.h"
+
+#include "bs/data/form_reader.h"
+#include "bs/vm/vm.h"
+#include "data/form_reader_internal.h"
+#include "vm/vm_internal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool strings_equal(const char *lhs, const char *rhs) {
+  if (lhs == NULL || rhs == NULL) {
+    return lhs == rhs;
+  }
+  return strcmp(lhs, rhs) == 0;
+}
+
+static bool asset_index_equal(const bs_asset_index *lhs, const bs_asset_index *rhs) {
+  return lhs->table_offset == rhs->table_offset && lhs->count == rhs->count;
+}
+
+static bool floats_equal(float lhs, float rhs) {
+  return memcmp(&lhs, &rhs, sizeof(float)) == 0;
+}
+
+static bool sprites_equal(const bs_sprite_data *a, const bs_sprite_data *b) {
+  if (!strings_equal(a->name, b->name) ||
+      a->width != b->width ||
+      a->height != b->height ||
+      a->margin_left != b->margin_left ||
+      a->margin_right != b->margin_right ||
+      a->margin_top != b->margin_top ||
+      a->margin_bottom != b->margin_bottom ||
+      a->origin_x != b->origin_x ||
+      a->origin_y != b->origin_y ||
+      a->subimage_count != b->subimage_count ||
+      a->collision_mask_type != b->collision_mask_type ||
+      a->collision_mask_count != b->collision_mask_count ||
+      a->collision_mask_stride != b->collision_mask_stride ||
+      (a->collision_masks == NULL) != (b->collision_masks == NULL)) {
+    return false;
+  }
+  if (a->subimage_count > 0 &&
+      memcmp(a->tpag_indices, b->tpag_indices, a->subimage_count * sizeof(int32_t)) != 0) {
+    return false;
+  }
+  return a->collision_masks == NULL ||
+         memcmp(a->collision_masks, b->collision_masks,
+                a->collision_mask_count * (size_t)a->height * a->collision_mask_stride * sizeof(uint64_t)) == 0;
+}
+
+static bool paths_equal(const bs_path_data *a, const bs_path_data *b) {
+  return strings_equal(a->name, b->name) &&
+         a->is_smooth == b->is_smooth &&
+         a->is_closed == b->is_closed &&
+         a->precision == b->precision &&
+         a->point_count == b->point_count &&
+         (a->point_count == 0 ||
+          memcmp(a->points, b->points, a->point_count * sizeof(bs_path_point_data)) == 0);
+}
+
+static bool fonts_equal(const bs_font_data *a, const bs_font_data *b) {
+  return strings_equal(a->name, b->name) &&
+         strings_equal(a->display_name, b->display_name) &&
+         a->em_size == b->em_size &&
+         a->tpag_index == b->tpag_index &&
+         floats_equal(a->scale_x, b->scale_x) &&
+         floats_equal(a->scale_y, b->scale_y) &&
+         a->glyph_count == b->glyph_count &&
+         (a->glyph_count == 0 ||
+          memcmp(a->glyphs, b->glyphs, a->glyph_count * sizeof(bs_font_glyph_data)) == 0);
+}
+
+static bool objects_equal(const bs_game_object_data *a, const bs_game_object_data *b) {
+  if (!strings_equal(a->name, b->name) ||
+      a->sprite_index != b->sprite_index ||
+      a->visible != b->visible ||
+      a->solid != b->solid ||
+      a->depth != b->depth ||
+      a->persistent != b->persistent ||
+      a->parent_id != b->parent_id ||
+      a->mask_id != b->mask_id ||
+      a->event_type_count != b->event_type_count) {
+    return false;
+  }
+  for (size_t type = 0; type < a->event_type_count; type++) {
+    const bs_object_event_list *la = &a->events[type];
+    const bs_object_event_list *lb = &b->events[type];
+    if (la->entry_count != lb->entry_count) {
+      return false;
+    }
+    for (size_t e = 0; e < la->entry_count; e++) {
+      const bs_event_entry *ea = &la->entries[e];
+      const bs_event_entry *eb = &lb->entries[e];
+      if (ea->subtype != eb->subtype ||
+          ea->action_count != eb->action_count ||
+          (ea->action_count > 0 &&
+           memcmp(ea->actions, eb->actions, ea->action_count * sizeof(bs_event_action)) != 0)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool room_backgrounds_equal(const bs_room_background_data *a, const bs_room_background_data *b) {
+  return a->enabled == b->enabled &&
+         a->foreground == b->foreground &&
+         a->bg_def_index == b->bg_def_index &&
+         a->x == b->x &&
+         a->y == b->y &&
+         a->tile_x == b->tile_x &&
+         a->tile_y == b->tile_y &&
+         a->speed_x == b->speed_x &&
+         a->speed_y == b->speed_y &&
+         a->stretch == b->stretch;
+}
+
+static bool room_views_equal(const bs_room_view_data *a, const bs_room_view_data *b) {
+  return a->enabled == b->enabled &&
+         a->view_x == b->view_x &&
+         a->view_y == b->view_y &&
+         a->view_w == b->view_w &&
+         a->view_h == b->view_h &&
+         a->port_x == b->port_x &&
+         a->port_y == b->port_y &&
+         a->port_w == b->port_w &&
+         a->port_h == b->port_h &&
+         a->border_h == b->border_h &&
+         a->border_v == b->border_v &&
+         a->speed_h == b->speed_h &&
+         a->speed_v == b->speed_v &&
+         a->follow_object_id == b->follow_object_id;
+}
+
+static bool rooms_equal(const bs_room_data *a, const bs_room_data *b) {
+  if (!strings_equal(a->name, b->name) ||
+      !strings_equal(a->caption, b->caption) ||
+      a->width != b->width ||
+      a->height != b->height ||
+      a->speed != b->speed ||
+      a->persistent != b->persistent ||
+      a->bg_color != b->bg_color ||
+      a->draw_bg_color != b->draw_bg_color ||
+      a->creation_code_id != b->creation_code_id ||
+      a->flags != b->flags ||
+      a->background_count != b->background_count ||
+      a->view_count != b->view_count ||
+      a->instance_count != b->instance_count ||
+      a->tile_count != b->tile_count) {
+    return false;
+  }
+  for (size_t i = 0; i < a->background_count; i++) {
+    if (!room_backgrounds_equal(&a->backgrounds[i], &b->backgrounds[i])) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < a->view_count; i++) {
+    if (!room_views_equal(&a->views[i], &b->views[i])) {
+      return false;
+    }
+  }
+  return (a->instance_count == 0 ||
+          memcmp(a->instances, b->instances, a->instance_count * sizeof(bs_room_instance_data)) == 0) &&
+         (a->tile_count == 0 ||
+          memcmp(a->tiles, b->tiles, a->tile_count * sizeof(bs_room_tile_data)) == 0);
+}
+
+/* The lazily parsed assets only have their index built by the chunk parsers; this forces every
+ * record through its accessor on both sides and compares what comes back. A record that fails on
+ * one side must fail on the other. */
+static bool lazy_assets_equal(const bs_game_data *lhs, const bs_game_data *rhs) {
+  for (size_t i = 0; i < lhs->sprite_count; i++) {
+    const bs_sprite_data *a = bs_game_data_sprite(lhs, (int32_t)i);
+    const bs_sprite_data *b = bs_game_data_sprite(rhs, (int32_t)i);
+    if ((a == NULL) != (b == NULL) || (a != NULL && !sprites_equal(a, b))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < lhs->path_count; i++) {
+    const bs_path_data *a = bs_game_data_path(lhs, (int32_t)i);
+    const bs_path_data *b = bs_game_data_path(rhs, (int32_t)i);
+    if ((a == NULL) != (b == NULL) || (a != NULL && !paths_equal(a, b))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < lhs->font_count; i++) {
+    const bs_font_data *a = bs_game_data_font(lhs, (int32_t)i);
+    const bs_font_data *b = bs_game_data_font(rhs, (int32_t)i);
+    if ((a == NULL) != (b == NULL) || (a != NULL && !fonts_equal(a, b))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < lhs->object_count; i++) {
+    const bs_game_object_data *a = bs_game_data_object(lhs, (int32_t)i);
+    const bs_game_object_data *b = bs_game_data_object(rhs, (int32_t)i);
+    if ((a == NULL) != (b == NULL) || (a != NULL && !objects_equal(a, b))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < lhs->room_count; i++) {
+    const bs_room_data *a = bs_game_data_room(lhs, (int32_t)i);
+    const bs_room_data *b = bs_game_data_room(rhs, (int32_t)i);
+    if ((a == NULL) != (b == NULL) || (a != NULL && !rooms_equal(a, b))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Deep comparison of everything the chunk parsers produce. */
+static bool chunk_contents_equal(const bs_game_data *lhs, const bs_game_data *rhs) {
+  if (lhs->string_count != rhs->string_count ||
+      lhs->texture_page_item_count != rhs->texture_page_item_count ||
+      lhs->texture_page_count != rhs->texture_page_count ||
+      lhs->background_count != rhs->background_count ||
+      lhs->code_entry_count != rhs->code_entry_count ||
+      lhs->sound_count != rhs->sound_count ||
+      lhs->audio_data_count != rhs->audio_data_count ||
+      lhs->script_count != rhs->script_count ||
+      lhs->variable_count != rhs->variable_count ||
+      lhs->function_count != rhs->function_count ||
+      lhs->sprite_count != rhs->sprite_count ||
+      lhs->path_count != rhs->path_count ||
+      lhs->font_count != rhs->font_count ||
+      lhs->object_count != rhs->object_count ||
+      lhs->room_count != rhs->room_count) {
+    return false;
+  }
+
+  if (lhs->gen8.bytecode_version != rhs->gen8.bytecode_version ||
+      lhs->gen8.game_id != rhs->gen8.game_id ||
+      lhs->gen8.window_width != rhs->gen8.window_width ||
+      lhs->gen8.window_height != rhs->gen8.window_height ||
+      lhs->gen8.room_order_count != rhs->gen8.room_order_count ||
+      !strings_equal(lhs->gen8.game_name, rhs->gen8.game_name) ||
+      !strings_equal(lhs->gen8.display_name, rhs->gen8.display_name)) {
+    return false;
+  }
+  if (lhs->gen8.room_order_count > 0 &&
+      memcmp(lhs->gen8.room_order, rhs->gen8.room_order, lhs->gen8.room_order_count * sizeof(uint32_t)) != 0) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs->string_count; i++) {
+    if (!strings_equal(lhs->strings[i], rhs->strings[i])) {
+      return false;
+    }
+  }
+
+  if (lhs->texture_page_item_count > 0 &&
+      (memcmp(lhs->texture_page_items, rhs->texture_page_items,
+              lhs->texture_page_item_count * sizeof(bs_texture_page_item_data)) != 0 ||
+       memcmp(lhs->texture_page_item_offsets, rhs->texture_page_item_offsets,
+              lhs->texture_page_item_count * sizeof(uint32_t)) != 0)) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs->texture_page_count; i++) {
+    if (lhs->texture_pages[i].png_offset != rhs->texture_pages[i].png_offset ||
+        lhs->texture_pages[i].png_length != rhs->texture_pages[i].png_length) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->background_count; i++) {
+    if (!strings_equal(lhs->backgrounds[i].name, rhs->backgrounds[i].name) ||
+        lhs->backgrounds[i].tpag_index != rhs->backgrounds[i].tpag_index) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->code_entry_count; i++) {
+    const bs_code_entry_data *a = &lhs->code_entries[i];
+    const bs_code_entry_data *b = &rhs->code_entries[i];
+    if (a->raw_offset != b->raw_offset ||
+        !strings_equal(a->name, b->name) ||
+        a->locals_count != b->locals_count ||
+        a->arguments_count != b->arguments_count ||
+        a->bytecode_absolute_offset != b->bytecode_absolute_offset ||
+        a->bytecode_length != b->bytecode_length ||
+        a->bytecode != b->bytecode) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->sound_count; i++) {
+    const bs_sound_data *a = &lhs->sounds[i];
+    const bs_sound_data *b = &rhs->sounds[i];
+    if (!strings_equal(a->name, b->name) ||
+        a->kind != b->kind ||
+        !strings_equal(a->extension, b->extension) ||
+        !strings_equal(a->file_name, b->file_name) ||
+        a->flags != b->flags ||
+        memcmp(&a->volume, &b->volume, sizeof(float)) != 0 ||
+        a->group_id != b->group_id ||
+        a->audio_id != b->audio_id) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->audio_data_count; i++) {
+    if (lhs->audio_data[i].data_offset != rhs->audio_data[i].data_offset ||
+        lhs->audio_data[i].length != rhs->audio_data[i].length ||
+        lhs->audio_data[i].format != rhs->audio_data[i].format) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->script_count; i++) {
+    if (!strings_equal(lhs->scripts[i].name, rhs->scripts[i].name) ||
+        lhs->scripts[i].code_id != rhs->scripts[i].code_id) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->variable_count; i++) {
+    const bs_variable_data *a = &lhs->variables[i];
+    const bs_variable_data *b = &rhs->variables[i];
+    if (!strings_equal(a->name, b->name) ||
+        a->instance_type != b->instance_type ||
+        a->var_id != b->var_id ||
+        a->occurrence_count != b->occurrence_count ||
+        a->first_occurrence_offset != b->first_occurrence_offset) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lhs->function_count; i++) {
+    const bs_function_data *a = &lhs->functions[i];
+    const bs_function_data *b = &rhs->functions[i];
+    if (!strings_equal(a->name, b->name) ||
+        a->occurrence_count != b->occurrence_count ||
+        a->first_occurrence_offset != b->first_occurrence_offset) {
+      return false;
+    }
+  }
+
+  return asset_index_equal(&lhs->sprite_assets, &rhs->sprite_assets) &&
+         asset_index_equal(&lhs->path_assets, &rhs->path_assets) &&
+         asset_index_equal(&lhs->font_assets, &rhs->font_assets) &&
+         asset_index_equal(&lhs->object_assets, &rhs->object_assets) &&
+         asset_index_equal(&lhs->room_assets, &rhs->room_assets) &&
+         lazy_assets_equal(lhs, rhs);
+}
+
+
+/* Re-parses the chunks at 1/2/4/8 threads into scratch copies and checks each against the data
+ * that was actually loaded. */
+bool bs_bench_load(const char *game_path) {
+  const size_t thread_counts[] = {1u, 2u, 4u, 8u};
+  bs_game_data loaded;
+  double baseline_millis = 0.0;
+  bool all_identical = true;
+
+  if (!bs_form_reader_read(game_path, &loaded)) {
+    fprintf(stderr, "Failed to load %s\n", game_path);
+    return false;
+  }
+
+  for (size_t k = 0; k < sizeof(thread_counts) / sizeof(thread_counts[0]); k++) {
+    bs_game_data scratch;
+    double start_millis = 0.0;
+    double elapsed_millis = 0.0;
+    bool identical = false;
+    bool ok = false;
+
+    start_millis = bs_bench_now_millis();
+    ok = bs_form_reader_reparse(&loaded, thread_counts[k], &scratch);
+    elapsed_millis = bs_bench_now_millis() - start_millis;
+    if (k == 0) {
+      baseline_millis = elapsed_millis;
+    }
+    identical = ok && chunk_contents_equal(&loaded, &scratch);
+    all_identical = all_identical && identical;
+
+    printf("  [LOAD BENCH] threads=%zu %.2f ms speedup=%.2fx %s\n",
+           thread_counts[k],
+           elapsed_millis,
+           (elapsed_millis > 0.0) ? (baseline_millis / elapsed_millis) : 1.0,
+           !ok ? "FAILED" : (identical ? "identical" : "MISMATCH"));
+
+    bs_form_reader_free_reparse(&scratch);
+  }
+
+  bs_game_data_free(&loaded);
+  return all_identical;
+}
+
+static bool decoded_entries_equal(const bs_decoded_code *lhs, const bs_decoded_code *rhs, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (lhs[i].instruction_count != rhs[i].instruction_count) {
+      return false;
+    }
+    for (size_t j = 0; j < lhs[i].instruction_count; j++) {
+      const bs_instruction *a = &lhs[i].instructions[j];
+      const bs_instruction *b = &rhs[i].instructions[j];
+      if (lhs[i].instruction_offsets[j] != rhs[i].instruction_offsets[j] ||
+          a->opcode != b->opcode ||
+          a->type1 != b->type1 ||
+          a->type2 != b->type2 ||
+          a->extra != b->extra ||
+          a->raw_operand != b->raw_operand ||
+          a->variable_index != b->variable_index ||
+          a->variable_type != b->variable_type ||
+          a->function_index != b->function_index ||
+          a->int_value != b->int_value ||
+          a->long_value != b->long_value ||
+          memcmp(&a->double_value, &b->double_value, sizeof(double)) != 0 ||
+          memcmp(&a->float_value, &b->float_value, sizeof(float)) != 0 ||
+          a->string_index != b->string_index) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+/* Times eager decode + resolution at 1/2/4/8 threads and checks each run against the
+ * single-threaded output. */
+bool bs_bench_decode(const char *game_path) {
+  const size_t thread_counts[] = {1u, 2u, 4u, 8u};
+  bs_game_data game_data;
+  bs_vm vm;
+  size_t entry_count = 0;
+  bs_decoded_code *baseline = NULL;
+  double baseline_millis = 0.0;
+  bool all_identical = true;
+
+  if (!bs_form_reader_read(game_path, &game_data)) {
+    fprintf(stderr, "Failed to load %s\n", game_path);
+    return false;
+  }
+  bs_vm_init(&vm, &game_data);
+  if (!vm.initialized) {
+    fprintf(stderr, "Failed to initialize VM for %s\n", game_path);
+    bs_game_data_free(&game_data);
+    return false;
+  }
+  entry_count = game_data.code_entry_count;
+
+  for (size_t k = 0; k < sizeof(thread_counts) / sizeof(thread_counts[0]) && entry_count > 0; k++) {
+    bs_decoded_code *scratch = (bs_decoded_code *)calloc(entry_count, sizeof(bs_decoded_code));
+    double start_millis = 0.0;
+    double elapsed_millis = 0.0;
+    bool ok = false;
+    bool identical = true;
+
+    if (scratch == NULL) {
+      all_identical = false;
+      break;
+    }
+
+    start_millis = bs_bench_now_millis();
+    ok = bs_vm_decode_all(&vm, scratch, thread_counts[k]);
+    elapsed_millis = bs_bench_now_millis() - start_millis;
+    if (ok && baseline != NULL) {
+      identical = decoded_entries_equal(baseline, scratch, entry_count);
+    }
+    all_identical = all_identical && ok && identical;
+
+    printf("  [VM INIT BENCH] threads=%zu %.2f ms speedup=%.2fx %s\n",
+           thread_counts[k],
+           elapsed_millis,
+           (ok && elapsed_millis > 0.0 && baseline != NULL) ? (baseline_millis / elapsed_millis) : 1.0,
+           !ok ? "FAILED" : (identical ? "identical" : "MISMATCH"));
+
+    if (ok && baseline == NULL) {
+      baseline = scratch;
+      baseline_millis = elapsed_millis;
+      continue;
+    }
+    bs_vm_free_decoded(scratch, entry_count);
+    free(scratch);
+    if (!ok) {
+      break;
+    }
+  }
+
+  if (baseline != NULL) {
+    bs_vm_free_decoded(baseline, entry_count);
+    free(baseline);
+  }
+  bs_vm_dispose(&vm);
+  bs_game_data_free(&game_data);
+  return all_identical;
+}
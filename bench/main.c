@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+double bs_bench_now_millis(void) {
+  struct timespec ts;
+  if (timespec_get(&ts, TIME_UTC) == TIME_UTC) {
+    return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+  }
+  return 0.0;
+}
+
+static int usage(const char *program) {
+  fprintf(stderr, "usage: %s <motion|solid|mask|runtime> | <load|decode> <game_path>\n", program);
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  const char *bench = (argc > 1) ? argv[1] : NULL;
+  const char *game_path = (argc > 2) ? argv[2] : NULL;
+  bool ok = true;
+  if (bench == NULL) {
+    return usage(argv[0]);
+  }
+
+  if (strcmp(bench, "motion") == 0) {
+    ok = bs_bench_motion(10000, 600);
+  } else if (strcmp(bench, "solid") == 0) {
+    ok = bs_bench_solid(1000, 2000, 300);
+  } else if (strcmp(bench, "mask") == 0) {
+    ok = bs_bench_mask(2000, 300);
+  } else if (strcmp(bench, "runtime") == 0) {
+    ok = bs_bench_motion(10000, 600);
+    ok = bs_bench_solid(1000, 2000, 300) && ok;
+    ok = bs_bench_mask(2000, 300) && ok;
+  } else if (strcmp(bench, "load") == 0 && game_path != NULL) {
+    ok = bs_bench_load(game_path);
+  } else if (strcmp(bench, "decode") == 0 && game_path != NULL) {
+    ok = bs_bench_decode(game_path);
+  } else {
+    return usage(argv[0]);
+  }
+  return ok ? 0 : 1;
+}
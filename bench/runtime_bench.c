@@ -0,0 +1,368 @@
+#include "bench.h"
+
+#include "bs/runtime/collision_mask.h"
+#include "bs/runtime/instance_pool.h"
+#include "bs/runtime/sweep_list.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const double k_pi = 3.14159265358979323846;
+
+/* The per-instance loop motion.c replaced. */
+static void integrate_reference(bs_instance_motion_columns *motion, size_t slot_count) {
+  for (size_t slot = 0; slot < slot_count; slot++) {
+    if (!motion->active[slot]) {
+      continue;
+    }
+    if (motion->gravity[slot] != 0.0) {
+      const double dir_rad = motion->gravity_direction[slot] * (k_pi / 180.0);
+      const double hspeed = motion->hspeed[slot] + motion->gravity[slot] * cos(dir_rad);
+      const double vspeed = motion->vspeed[slot] - motion->gravity[slot] * sin(dir_rad);
+      motion->hspeed[slot] = hspeed;
+      motion->vspeed[slot] = vspeed;
+      motion->speed[slot] = sqrt(hspeed * hspeed + vspeed * vspeed);
+      motion->direction[slot] = fmod((atan2(-vspeed, hspeed) * (180.0 / k_pi)) + 360.0, 360.0);
+    }
+    if (motion->friction[slot] != 0.0 && motion->speed[slot] != 0.0) {
+      const double new_speed = motion->speed[slot] - motion->friction[slot];
+      if (new_speed <= 0.0) {
+        motion->speed[slot] = 0.0;
+        motion->hspeed[slot] = 0.0;
+        motion->vspeed[slot] = 0.0;
+      } else {
+        const double dir_rad = motion->direction[slot] * (k_pi / 180.0);
+        motion->speed[slot] = new_speed;
+        motion->hspeed[slot] = new_speed * cos(dir_rad);
+        motion->vspeed[slot] = -new_speed * sin(dir_rad);
+      }
+    }
+    if (motion->hspeed[slot] != 0.0 || motion->vspeed[slot] != 0.0) {
+      motion->x[slot] += motion->hspeed[slot];
+      motion->y[slot] += motion->vspeed[slot];
+    }
+  }
+}
+
+/* A mix of constant-velocity, gravity, friction and stationary instances, with every eighth one
+ * destroyed so inactive slots are interleaved the way they are mid-room. */
+static bool fill_benchmark_pool(bs_instance_pool *pool, size_t instance_count) {
+  uint32_t seed = 12345u;
+
+  for (size_t i = 0; i < instance_count; i++) {
+    bs_instance_motion motion = {0};
+    bs_instance *instance = bs_instance_pool_acquire(pool, (int32_t)(100000 + i));
+    double speed = 0.0;
+    double direction = 0.0;
+    if (instance == NULL) {
+      return false;
+    }
+    seed = seed * 1103515245u + 12345u;
+    direction = (double)(seed >> 16) * (360.0 / 65536.0);
+    speed = (double)((seed >> 8) & 0xffu) / 32.0;
+    motion.x = (double)(i % 640u);
+    motion.y = (double)((i / 640u) * 4u);
+    motion.gravity_direction = 270.0;
+    motion.image_speed = 1.0;
+    switch (i % 4u) {
+      case 0:
+        motion.gravity = 0.25;
+        break;
+      case 1:
+        motion.friction = 0.01;
+        break;
+      case 2:
+        break;
+      default:
+        speed = 0.0;
+        break;
+    }
+    motion.speed = speed;
+    motion.direction = direction;
+    motion.hspeed = speed * cos(direction * (k_pi / 180.0));
+    motion.vspeed = -speed * sin(direction * (k_pi / 180.0));
+    bs_instance_pool_store_motion(instance, &motion);
+    if (i % 8u == 7u) {
+      instance->destroyed = true;
+      bs_instance_pool_mark_released(pool, instance);
+    }
+  }
+  return true;
+}
+
+static bool columns_equal(const double *lhs, const double *rhs, size_t count) {
+  return memcmp(lhs, rhs, count * sizeof(double)) == 0;
+}
+
+bool bs_bench_motion(size_t instance_count, size_t frame_count) {
+  bs_instance_pool reference;
+  bs_instance_pool batched;
+  double start_millis = 0.0;
+  double reference_millis = 0.0;
+  double batched_millis = 0.0;
+  bool identical = false;
+
+  bs_instance_pool_init(&reference);
+  bs_instance_pool_init(&batched);
+  if (!fill_benchmark_pool(&reference, instance_count) || !fill_benchmark_pool(&batched, instance_count)) {
+    printf("  [MOTION BENCH] instances=%zu FAILED (out of memory)\n", instance_count);
+    bs_instance_pool_dispose(&reference);
+    bs_instance_pool_dispose(&batched);
+    return false;
+  }
+
+  start_millis = bs_bench_now_millis();
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    integrate_reference(&reference.motion, reference.slot_count);
+  }
+  reference_millis = bs_bench_now_millis() - start_millis;
+
+  start_millis = bs_bench_now_millis();
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    bs_instance_motion_integrate(&batched.motion, batched.slot_count);
+  }
+  batched_millis = bs_bench_now_millis() - start_millis;
+
+  identical = columns_equal(reference.motion.x, batched.motion.x, batched.slot_count) &&
+              columns_equal(reference.motion.y, batched.motion.y, batched.slot_count) &&
+              columns_equal(reference.motion.hspeed, batched.motion.hspeed, batched.slot_count) &&
+              columns_equal(reference.motion.vspeed, batched.motion.vspeed, batched.slot_count) &&
+              columns_equal(reference.motion.speed, batched.motion.speed, batched.slot_count) &&
+              columns_equal(reference.motion.direction, batched.motion.direction, batched.slot_count);
+
+  printf("  [MOTION BENCH] instances=%zu frames=%zu reference=%.2f ms batched=%.2f ms speedup=%.2fx %s\n",
+         instance_count,
+         frame_count,
+         reference_millis,
+         batched_millis,
+         (batched_millis > 0.0) ? (reference_millis / batched_millis) : 1.0,
+         identical ? "identical" : "MISMATCH");
+
+  bs_instance_pool_dispose(&reference);
+  bs_instance_pool_dispose(&batched);
+  return identical;
+}
+
+static bool brute_force_overlap(const bs_bbox *boxes, size_t count, const bs_bbox *bbox, size_t skip) {
+  for (size_t i = 0; i < count; i++) {
+    if (i != skip &&
+        bbox->left < boxes[i].right &&
+        bbox->right > boxes[i].left &&
+        bbox->top < boxes[i].bottom &&
+        bbox->bottom > boxes[i].top) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* moving_count 16x16 boxes drift through a field of static_count solids. Each
+ * frame the list is refreshed and every moving box asks whether it hits a solid, as
+ * resolve_solid_overlaps does; the answers are checked against a brute-force scan. */
+bool bs_bench_solid(size_t moving_count, size_t static_count, size_t frame_count) {
+  const size_t total = moving_count + static_count;
+  bs_bbox *boxes = (bs_bbox *)malloc(total * sizeof(bs_bbox));
+  double *velocity = (double *)malloc(moving_count * 2u * sizeof(double));
+  bool *hits = (bool *)malloc(moving_count * sizeof(bool));
+  bs_sweep_list list;
+  uint32_t seed = 2463534242u;
+  double sweep_millis = 0.0;
+  double brute_millis = 0.0;
+  size_t hit_count = 0;
+  size_t mismatch_count = 0;
+
+  bs_sweep_list_init(&list);
+  if (boxes == NULL || velocity == NULL || hits == NULL) {
+    printf("  [SOLID BENCH] FAILED (out of memory)\n");
+    free(boxes);
+    free(velocity);
+    free(hits);
+    return false;
+  }
+
+  for (size_t i = 0; i < total; i++) {
+    double x = 0.0;
+    double y = 0.0;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    x = (double)(seed % 4096u);
+    y = (double)((seed >> 12) % 2048u);
+    boxes[i].left = x;
+    boxes[i].top = y;
+    boxes[i].right = x + 16.0;
+    boxes[i].bottom = y + 16.0;
+    if (i < moving_count) {
+      velocity[i * 2u] = (double)((int32_t)(seed % 7u) - 3);
+      velocity[i * 2u + 1u] = (double)((int32_t)((seed >> 3) % 7u) - 3);
+    }
+  }
+
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    double start_millis = 0.0;
+    for (size_t i = 0; i < moving_count; i++) {
+      boxes[i].left += velocity[i * 2u];
+      boxes[i].right += velocity[i * 2u];
+      boxes[i].top += velocity[i * 2u + 1u];
+      boxes[i].bottom += velocity[i * 2u + 1u];
+    }
+
+    start_millis = bs_bench_now_millis();
+    bs_sweep_list_begin_update(&list);
+    for (size_t i = 0; i < total; i++) {
+      (void)bs_sweep_list_set(&list, (uint32_t)i, &boxes[i]);
+    }
+    bs_sweep_list_end_update(&list);
+    for (size_t i = 0; i < moving_count; i++) {
+      hits[i] = bs_sweep_list_any_overlap(&list, &boxes[i], (uint32_t)i);
+    }
+    sweep_millis += bs_bench_now_millis() - start_millis;
+
+    start_millis = bs_bench_now_millis();
+    for (size_t i = 0; i < moving_count; i++) {
+      hits[i] = (brute_force_overlap(boxes, total, &boxes[i], i) != hits[i]);
+    }
+    brute_millis += bs_bench_now_millis() - start_millis;
+    for (size_t i = 0; i < moving_count; i++) {
+      mismatch_count += hits[i] ? 1u : 0u;
+      hit_count += bs_sweep_list_any_overlap(&list, &boxes[i], (uint32_t)i) ? 1u : 0u;
+    }
+  }
+
+  printf("  [SOLID BENCH] moving=%zu static=%zu frames=%zu hits=%zu brute=%.2f ms sweep=%.2f ms speedup=%.2fx %s\n",
+         moving_count,
+         static_count,
+         frame_count,
+         hit_count,
+         brute_millis,
+         sweep_millis,
+         (sweep_millis > 0.0) ? (brute_millis / sweep_millis) : 1.0,
+         (mismatch_count == 0) ? "identical" : "MISMATCH");
+
+  bs_sweep_list_dispose(&list);
+  free(boxes);
+  free(velocity);
+  free(hits);
+  return mismatch_count == 0;
+}
+
+/* Reference test: samples both masks at every pixel centre of the room pixels region touches. */
+static bool masks_overlap_by_pixel(const bs_collision_mask *a, const bs_collision_mask *b, const bs_bbox *region) {
+  const int64_t left = (int64_t)floor(region->left);
+  const int64_t top = (int64_t)floor(region->top);
+  const int64_t right = (int64_t)ceil(region->right) - 1;
+  const int64_t bottom = (int64_t)ceil(region->bottom) - 1;
+  for (int64_t j = top; j <= bottom; j++) {
+    for (int64_t i = left; i <= right; i++) {
+      if (bs_collision_mask_covers(a, (double)i + 0.5, (double)j + 0.5) &&
+          bs_collision_mask_covers(b, (double)i + 0.5, (double)j + 0.5)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void fill_disc(uint64_t *rows, size_t stride, int32_t size, uint32_t seed) {
+  const double centre = (double)size / 2.0;
+  const double radius = centre - (double)(seed % 4u);
+  for (int32_t y = 0; y < size; y++) {
+    for (int32_t x = 0; x < size; x++) {
+      const double dx = (double)x + 0.5 - centre;
+      const double dy = (double)y + 0.5 - centre;
+      if ((dx * dx) + (dy * dy) <= radius * radius) {
+        rows[(size_t)y * stride + (size_t)(x >> 6)] |= (uint64_t)1 << (x & 63);
+      }
+    }
+  }
+}
+
+/* pair_count pairs of unscaled 48x48 disc masks are placed at random overlapping
+ * offsets each frame and tested over their box intersection with the word path, then with the
+ * per-pixel reference; the answers must agree. */
+bool bs_bench_mask(size_t pair_count, size_t frame_count) {
+  const int32_t size = 48;
+  const size_t stride = ((size_t)size + 63u) / 64u;
+  uint64_t *rows = (uint64_t *)calloc((size_t)size * stride * 2u, sizeof(uint64_t));
+  bs_collision_mask *masks = (bs_collision_mask *)malloc(pair_count * 2u * sizeof(bs_collision_mask));
+  bs_bbox *regions = (bs_bbox *)malloc(pair_count * sizeof(bs_bbox));
+  bool *hits = (bool *)malloc(pair_count * sizeof(bool));
+  uint32_t seed = 88172645u;
+  double word_millis = 0.0;
+  double pixel_millis = 0.0;
+  size_t hit_count = 0;
+  size_t mismatch_count = 0;
+
+  if (rows == NULL || masks == NULL || regions == NULL || hits == NULL) {
+    printf("  [MASK BENCH] FAILED (out of memory)\n");
+    free(rows);
+    free(masks);
+    free(regions);
+    free(hits);
+    return false;
+  }
+  fill_disc(rows, stride, size, 1u);
+  fill_disc(rows + (size_t)size * stride, stride, size, 3u);
+
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    double start_millis = 0.0;
+    for (size_t p = 0; p < pair_count; p++) {
+      for (size_t side = 0; side < 2u; side++) {
+        bs_collision_mask *mask = &masks[p * 2u + side];
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        memset(mask, 0, sizeof(*mask));
+        mask->rows = rows + side * (size_t)size * stride;
+        mask->stride = stride;
+        mask->width = size;
+        mask->height = size;
+        mask->margin_right = size - 1;
+        mask->margin_bottom = size - 1;
+        mask->origin_x = size / 2;
+        mask->origin_y = size / 2;
+        mask->x = 1000.0 + (double)(seed % 96u) + ((side == 0) ? 0.0 : 0.25 * (double)((seed >> 8) % 4u));
+        mask->y = 1000.0 + (double)((seed >> 12) % 96u);
+        mask->xscale = 1.0;
+        mask->yscale = 1.0;
+      }
+      regions[p].left = fmax(masks[p * 2u].x, masks[p * 2u + 1u].x) - (double)(size / 2);
+      regions[p].right = fmin(masks[p * 2u].x, masks[p * 2u + 1u].x) + (double)(size / 2);
+      regions[p].top = fmax(masks[p * 2u].y, masks[p * 2u + 1u].y) - (double)(size / 2);
+      regions[p].bottom = fmin(masks[p * 2u].y, masks[p * 2u + 1u].y) + (double)(size / 2);
+    }
+
+    start_millis = bs_bench_now_millis();
+    for (size_t p = 0; p < pair_count; p++) {
+      hits[p] = regions[p].left < regions[p].right && regions[p].top < regions[p].bottom &&
+                bs_collision_masks_overlap(&masks[p * 2u], &masks[p * 2u + 1u], &regions[p]);
+    }
+    word_millis += bs_bench_now_millis() - start_millis;
+
+    start_millis = bs_bench_now_millis();
+    for (size_t p = 0; p < pair_count; p++) {
+      const bool reference = regions[p].left < regions[p].right && regions[p].top < regions[p].bottom &&
+                             masks_overlap_by_pixel(&masks[p * 2u], &masks[p * 2u + 1u], &regions[p]);
+      mismatch_count += (reference != hits[p]) ? 1u : 0u;
+      hit_count += hits[p] ? 1u : 0u;
+    }
+    pixel_millis += bs_bench_now_millis() - start_millis;
+  }
+
+  printf("  [MASK BENCH] pairs=%zu frames=%zu hits=%zu per_pixel=%.2f ms words=%.2f ms speedup=%.2fx %s\n",
+         pair_count,
+         frame_count,
+         hit_count,
+         pixel_millis,
+         word_millis,
+         (word_millis > 0.0) ? (pixel_millis / word_millis) : 1.0,
+         (mismatch_count == 0) ? "identical" : "MISMATCH");
+
+  free(rows);
+  free(masks);
+  free(regions);
+  free(hits);
+  return mismatch_count == 0;
+}
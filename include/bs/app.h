@@ -3,6 +3,14 @@
 
 #include "bs/common.h"
 
+typedef struct bs_run_options {
+  const char *game_path;
+  int frame_count;
+  const char *load_json_path;
+} bs_run_options;
+
 int bs_run(const char *game_path, int frame_count);
+int bs_run_with_options(const bs_run_options *options);
+int bs_build_image(const char *game_path, const char *image_path);
 
 #endif
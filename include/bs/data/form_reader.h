@@ -2,6 +2,7 @@
 #define BS_DATA_FORM_READER_H
 
 #include "bs/common.h"
+#include "bs/load_stats.h"
 
 typedef struct bs_chunk_info {
   char tag[5];
@@ -39,6 +40,11 @@ typedef struct bs_texture_page_data {
   uint32_t png_length;
 } bs_texture_page_data;
 
+#define BS_SPRITE_MASK_PRECISE 1
+
+/* collision_masks holds collision_mask_count masks of height rows each, collision_mask_stride
+ * 64-bit words per row, pixel x of a row in bit (x & 63) of word (x >> 6). Only precise sprites
+ * carry masks; the rest collide by their margin rectangle. */
 typedef struct bs_sprite_data {
   char *name;
   int32_t width;
@@ -52,6 +58,9 @@ typedef struct bs_sprite_data {
   int32_t *tpag_indices;
   size_t subimage_count;
   int32_t collision_mask_type;
+  uint64_t *collision_masks;
+  size_t collision_mask_count;
+  size_t collision_mask_stride;
 } bs_sprite_data;
 
 typedef struct bs_background_data {
@@ -243,6 +252,47 @@ typedef struct bs_room_data {
   size_t tile_count;
 } bs_room_data;
 
+typedef struct bs_arena_block bs_arena_block;
+
+/* Bump allocator owning parsed records; released a block at a time, never per record. next_block
+ * is the capacity of the next regular block, 0 for the default. */
+typedef struct bs_arena {
+  bs_arena_block *head;
+  size_t next_block;
+  size_t used_bytes;
+  size_t reserved_bytes;
+  size_t block_count;
+  size_t allocation_count;
+} bs_arena;
+
+/* One arena per chunk parser, so parallel parsers and lazy record parsing never share one. */
+typedef enum bs_data_arena {
+  BS_DATA_ARENA_STRG = 0,
+  BS_DATA_ARENA_GEN8,
+  BS_DATA_ARENA_TPAG,
+  BS_DATA_ARENA_TXTR,
+  BS_DATA_ARENA_SPRT,
+  BS_DATA_ARENA_BGND,
+  BS_DATA_ARENA_PATH,
+  BS_DATA_ARENA_FONT,
+  BS_DATA_ARENA_SOND,
+  BS_DATA_ARENA_AUDO,
+  BS_DATA_ARENA_CODE,
+  BS_DATA_ARENA_OBJT,
+  BS_DATA_ARENA_ROOM,
+  BS_DATA_ARENA_SCPT,
+  BS_DATA_ARENA_VARI,
+  BS_DATA_ARENA_FUNC,
+  BS_DATA_ARENA_COUNT
+} bs_data_arena;
+
+/* Offset index over a pointer-list chunk; records are parsed into the owning cache on first access. */
+typedef struct bs_asset_index {
+  uint32_t table_offset;
+  uint8_t *states;
+  size_t count;
+} bs_asset_index;
+
 typedef struct bs_code_entry_data {
   uint32_t raw_offset;
   char *name;
@@ -250,13 +300,18 @@ typedef struct bs_code_entry_data {
   uint16_t arguments_count;
   uint32_t bytecode_absolute_offset;
   uint32_t bytecode_length;
-  uint8_t *bytecode;
+  const uint8_t *bytecode;
 } bs_code_entry_data;
 
 typedef struct bs_game_data {
   char game_path[1024];
-  uint8_t *file_data;
+  const uint8_t *file_data;
   size_t file_size;
+  bool file_mapped;
+  void *file_mapping;
+
+  bs_arena *arenas;
+  bs_load_stats load_stats;
 
   uint32_t form_size;
   bs_chunk_info *chunks;
@@ -274,16 +329,19 @@ typedef struct bs_game_data {
   bs_texture_page_data *texture_pages;
   size_t texture_page_count;
 
-  bs_sprite_data *sprites;
+  bs_sprite_data *sprite_cache;
+  bs_asset_index sprite_assets;
   size_t sprite_count;
 
   bs_background_data *backgrounds;
   size_t background_count;
 
-  bs_path_data *paths;
+  bs_path_data *path_cache;
+  bs_asset_index path_assets;
   size_t path_count;
 
-  bs_font_data *fonts;
+  bs_font_data *font_cache;
+  bs_asset_index font_assets;
   size_t font_count;
 
   bs_code_entry_data *code_entries;
@@ -304,14 +362,32 @@ typedef struct bs_game_data {
   bs_function_data *functions;
   size_t function_count;
 
-  bs_game_object_data *objects;
+  bs_game_object_data *object_cache;
+  bs_asset_index object_assets;
   size_t object_count;
 
-  bs_room_data *rooms;
+  bs_room_data *room_cache;
+  bs_asset_index room_assets;
   size_t room_count;
 } bs_game_data;
 
 bool bs_form_reader_read(const char *path, bs_game_data *out_data);
 void bs_game_data_free(bs_game_data *data);
 
+/* Lazy asset accessors: parse the record on first use and return NULL when out of range or malformed.
+ * Despite the const data they mutate it: the first lookup of an asset writes its cache slot, its
+ * state byte and the chunk arena. They must not run concurrently with each other. Lookups of an
+ * asset already returned (or already found malformed) only read, so worker threads may repeat
+ * those once the asset was looked up before they started. */
+const bs_sprite_data *bs_game_data_sprite(const bs_game_data *data, int32_t index);
+const bs_path_data *bs_game_data_path(const bs_game_data *data, int32_t index);
+const bs_font_data *bs_game_data_font(const bs_game_data *data, int32_t index);
+const bs_game_object_data *bs_game_data_object(const bs_game_data *data, int32_t index);
+const bs_room_data *bs_game_data_room(const bs_game_data *data, int32_t index);
+bool bs_game_data_room_persistent(const bs_game_data *data, int32_t index);
+/* parent_id of an object without parsing it; -1 when out of range or malformed. */
+int32_t bs_game_data_object_parent(const bs_game_data *data, int32_t index);
+size_t bs_game_data_materialized_asset_count(const bs_game_data *data);
+size_t bs_game_data_arena_bytes(const bs_game_data *data, size_t *out_reserved, size_t *out_allocations);
+
 #endif
@@ -0,0 +1,36 @@
+#ifndef BS_LOAD_STATS_H
+#define BS_LOAD_STATS_H
+
+#include "bs/common.h"
+
+#include <stdio.h>
+
+#define BS_LOAD_STATS_MAX_PHASES 48u
+
+/* One timed startup step. millis is wall time; batched steps (decode) keep their slowest batch in
+ * max_millis. items counts records, batches or references depending on the step. Detail phases
+ * break down the top-level phase before them and are left out of totals. */
+typedef struct bs_load_phase {
+  char stage[12];
+  char name[28];
+  double millis;
+  double max_millis;
+  size_t items;
+  size_t allocations;
+  size_t bytes;
+  bool detail;
+} bs_load_phase;
+
+typedef struct bs_load_stats {
+  bs_load_phase phases[BS_LOAD_STATS_MAX_PHASES];
+  size_t phase_count;
+} bs_load_stats;
+
+void bs_load_stats_reset(bs_load_stats *stats);
+bs_load_phase *bs_load_stats_add(bs_load_stats *stats, const char *stage, const char *name, double millis);
+const bs_load_phase *bs_load_stats_find(const bs_load_stats *stats, const char *stage, const char *name);
+void bs_load_stats_append(bs_load_stats *dst, const bs_load_stats *src);
+bool bs_load_stats_write_json(const bs_load_stats *stats, const char *game_path, FILE *out);
+bool bs_load_stats_dump_json(const bs_load_stats *stats, const char *game_path, const char *out_path);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef BS_PLATFORM_SYSTEM_H
+#define BS_PLATFORM_SYSTEM_H
+
+#include "bs/common.h"
+
+/* Online processors, or 1 if the platform cannot tell. */
+size_t bs_system_processor_count(void);
+
+/* Worker threads for a parallel phase: env_name's value when it is a positive number, otherwise
+ * one per processor when threads are available. Clamped to [1, max_threads]. */
+size_t bs_system_thread_count(const char *env_name, size_t max_threads);
+
+/* A whole file mapped read-only. mapping is the platform's handle for it, if it needs one. */
+typedef struct bs_file_view {
+  const uint8_t *bytes;
+  size_t size;
+  void *mapping;
+} bs_file_view;
+
+/* Maps path read-only. Returns false if the file is missing or empty or the platform cannot map
+ * files; callers then read it into memory instead. */
+bool bs_system_map_file(const char *path, bs_file_view *out_view);
+void bs_system_unmap_file(bs_file_view *view);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef BS_RUNTIME_BBOX_H
+#define BS_RUNTIME_BBOX_H
+
+#include "bs/common.h"
+
+typedef struct bs_bbox {
+  double left;
+  double right;
+  double top;
+  double bottom;
+} bs_bbox;
+
+#endif
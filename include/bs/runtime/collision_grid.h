@@ -0,0 +1,80 @@
+#ifndef BS_RUNTIME_COLLISION_GRID_H
+#define BS_RUNTIME_COLLISION_GRID_H
+
+#include "bs/runtime/bbox.h"
+
+/* Boxes spanning more cells than this go on the grid's wide list and are returned by every query. */
+#define BS_COLLISION_GRID_MAX_SPAN 64
+#define BS_COLLISION_GRID_MIN_CELL 64.0
+#define BS_COLLISION_GRID_MAX_AXIS 128
+
+typedef struct bs_collision_cell {
+  uint32_t *entries;
+  size_t count;
+  size_t capacity;
+} bs_collision_cell;
+
+/* Where one entry currently sits: an inclusive cell range, the wide list, or nowhere. moved is set
+ * while the entry is queued on the grid's moved list. */
+typedef struct bs_collision_grid_entry {
+  int32_t column_min;
+  int32_t row_min;
+  int32_t column_max;
+  int32_t row_max;
+  bool placed;
+  bool wide;
+  bool moved;
+} bs_collision_grid_entry;
+
+/* Uniform grid over the room used as a broadphase. Entries are caller-chosen dense indices; a
+ * query returns, in ascending order, every entry whose cells touch the box, which is a superset of
+ * the entries that overlap it. Coordinates outside the room clamp to the border cells. */
+typedef struct bs_collision_grid {
+  bs_collision_cell *cells;
+  size_t cell_capacity;
+  int32_t columns;
+  int32_t rows;
+  double cell_width;
+  double cell_height;
+  bs_collision_cell wide;
+  bs_collision_grid_entry *entries;
+  uint32_t *marks;
+  size_t entry_count;
+  size_t entry_capacity;
+  uint32_t stamp;
+  uint32_t *results;
+  size_t result_capacity;
+  uint32_t *moved;
+  size_t moved_count;
+  uint8_t *changed;
+  size_t changed_capacity;
+  bool tracking_changes;
+  bool changed_everywhere;
+} bs_collision_grid;
+
+/* Per-thread scratch for bs_collision_grid_read. */
+typedef struct bs_collision_grid_reader {
+  uint32_t *marks;
+  uint32_t *results;
+  size_t capacity;
+  uint32_t stamp;
+} bs_collision_grid_reader;
+
+void bs_collision_grid_init(bs_collision_grid *grid);
+void bs_collision_grid_dispose(bs_collision_grid *grid);
+bool bs_collision_grid_reset(bs_collision_grid *grid, double width, double height, size_t entry_count);
+bool bs_collision_grid_place(bs_collision_grid *grid, uint32_t entry, const bs_bbox *bbox);
+const uint32_t *bs_collision_grid_query(bs_collision_grid *grid, const bs_bbox *bbox, size_t *out_count);
+void bs_collision_grid_note_moved(bs_collision_grid *grid, uint32_t entry);
+const uint32_t *bs_collision_grid_drain_moved(bs_collision_grid *grid, size_t *out_count);
+void bs_collision_grid_reader_init(bs_collision_grid_reader *reader);
+void bs_collision_grid_reader_dispose(bs_collision_grid_reader *reader);
+const uint32_t *bs_collision_grid_read(const bs_collision_grid *grid,
+                                       bs_collision_grid_reader *reader,
+                                       const bs_bbox *bbox,
+                                       size_t *out_count);
+void bs_collision_grid_track_changes(bs_collision_grid *grid, bool enabled);
+bool bs_collision_grid_region_changed(const bs_collision_grid *grid, const bs_bbox *bbox);
+void bs_collision_grid_mark_changed(bs_collision_grid *grid, const bs_bbox *bbox);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef BS_RUNTIME_COLLISION_MASK_H
+#define BS_RUNTIME_COLLISION_MASK_H
+
+#include "bs/runtime/bbox.h"
+
+/* A sprite mask placed in the room at (x, y) with the given scale. rows points at the sprite's
+ * packed bitset (see bs_sprite_data); when it is NULL the mask is the sprite's margin rectangle. */
+typedef struct bs_collision_mask {
+  const uint64_t *rows;
+  size_t stride;
+  int32_t width;
+  int32_t height;
+  int32_t margin_left;
+  int32_t margin_top;
+  int32_t margin_right;
+  int32_t margin_bottom;
+  int32_t origin_x;
+  int32_t origin_y;
+  double x;
+  double y;
+  double xscale;
+  double yscale;
+} bs_collision_mask;
+
+bool bs_collision_mask_covers(const bs_collision_mask *mask, double px, double py);
+bool bs_collision_masks_overlap(const bs_collision_mask *a, const bs_collision_mask *b, const bs_bbox *region);
+bool bs_collision_mask_hits_rectangle(const bs_collision_mask *mask, const bs_bbox *region);
+bool bs_collision_mask_hits_circle(const bs_collision_mask *mask,
+                                   const bs_bbox *region,
+                                   double cx,
+                                   double cy,
+                                   double radius);
+bool bs_collision_mask_hits_line(const bs_collision_mask *mask, double x1, double y1, double x2, double y2);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef BS_RUNTIME_DRAW_LIST_H
+#define BS_RUNTIME_DRAW_LIST_H
+
+#include "bs/common.h"
+
+typedef enum bs_draw_item_kind {
+  BS_DRAW_ITEM_TILE = 0,
+  BS_DRAW_ITEM_INSTANCE = 1,
+  BS_DRAW_ITEM_KIND_COUNT = 2
+} bs_draw_item_kind;
+
+#define BS_DRAW_KEY_NONE UINT32_MAX
+
+/* One tile layer or instance in the draw order. key is the runner's tile layer index or the
+ * instance's pool slot; order breaks ties within a kind (creation sequence for instances). A removed
+ * entry keeps its place and key, with removed set, until the next sort. */
+typedef struct bs_draw_entry {
+  int32_t depth;
+  uint32_t kind;
+  uint32_t key;
+  uint32_t removed;
+  uint64_t order;
+} bs_draw_entry;
+
+/* Tile layers and instances in draw order: depth descending, tiles before instances at one depth,
+ * then by order, which is how the per-depth scans drew them. entries[0, sorted_count) is in order;
+ * changes append to the unsorted tail after it, and bs_draw_list_sort merges the tail back in once
+ * per frame. positions maps each kind's key to its entry. */
+typedef struct bs_draw_list {
+  bs_draw_entry *entries;
+  size_t count;
+  size_t sorted_count;
+  size_t capacity;
+  size_t removed_count;
+  bs_draw_entry *scratch;
+  size_t scratch_capacity;
+  uint32_t *positions[BS_DRAW_ITEM_KIND_COUNT];
+  size_t key_capacity[BS_DRAW_ITEM_KIND_COUNT];
+} bs_draw_list;
+
+void bs_draw_list_init(bs_draw_list *list);
+void bs_draw_list_dispose(bs_draw_list *list);
+bool bs_draw_list_set(bs_draw_list *list, bs_draw_item_kind kind, uint32_t key, int32_t depth, uint64_t order);
+void bs_draw_list_remove(bs_draw_list *list, bs_draw_item_kind kind, uint32_t key);
+void bs_draw_list_remove_kind(bs_draw_list *list, bs_draw_item_kind kind);
+bool bs_draw_list_sort(bs_draw_list *list);
+bool bs_draw_list_moved(const bs_draw_list *list, const bs_draw_entry *entry);
+
+#endif
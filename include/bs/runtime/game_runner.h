@@ -3,6 +3,11 @@
 
 #include "bs/common.h"
 #include "bs/data/form_reader.h"
+#include "bs/runtime/collision_grid.h"
+#include "bs/runtime/collision_mask.h"
+#include "bs/runtime/draw_list.h"
+#include "bs/runtime/instance_pool.h"
+#include "bs/runtime/sweep_list.h"
 #include "bs/vm/vm.h"
 
 typedef enum bs_event_type {
@@ -20,6 +25,8 @@ typedef enum bs_event_type {
   BS_EVENT_TRIGGER = 11
 } bs_event_type;
 
+#define BS_EVENT_TYPE_COUNT 12
+
 typedef enum bs_other_event_subtype {
   BS_OTHER_OUTSIDE_ROOM = 0,
   BS_OTHER_GAME_START = 2,
@@ -29,64 +36,28 @@ typedef enum bs_other_event_subtype {
   BS_OTHER_ANIMATION_END = 7
 } bs_other_event_subtype;
 
-typedef struct bs_instance {
-  int32_t id;
-  int32_t object_index;
-  double x;
-  double y;
-  double xprevious;
-  double yprevious;
-  double xstart;
-  double ystart;
-  double hspeed;
-  double vspeed;
-  double speed;
-  double direction;
-  double friction;
-  double gravity;
-  double gravity_direction;
-  int32_t mask_index;
-  int32_t sprite_index;
+/* The current room's tiles at one depth. tiles holds their room tile indices in room order, and the
+ * grid is keyed by position in that list, so a view query comes back in the order the tiles draw.
+ * Without a grid every tile of the layer is tested against the view. */
+typedef struct bs_tile_layer {
   int32_t depth;
-  bool visible;
-  bool solid;
-  bool persistent;
-  double image_index;
-  double image_speed;
-  double image_xscale;
-  double image_yscale;
-  double image_angle;
-  double image_alpha;
-  double image_single;
-  int32_t image_blend;
-  int32_t path_index;
-  double path_position;
-  double path_speed;
-  int32_t path_end_action;
-  double path_orientation;
-  double path_scale;
-  double path_x_offset;
-  double path_y_offset;
-  int32_t alarm[12];
-
-  int32_t *variable_indices;
-  double *variable_values;
-  size_t variable_count;
-  size_t variable_capacity;
-
-  bool has_been_marked_as_outside_room;
-  bool destroyed;
-} bs_instance;
-
-typedef struct bs_bbox {
-  double left;
-  double right;
-  double top;
-  double bottom;
-} bs_bbox;
+  const uint32_t *tiles;
+  size_t tile_count;
+  bs_collision_grid grid;
+  bool grid_ready;
+} bs_tile_layer;
+
+/* What the last frame's draw pass did with the room's tiles: layers walked, tiles the view queries
+ * returned, and how many of those were inside the view and reached draw_tile. */
+typedef struct bs_tile_draw_stats {
+  size_t layers_drawn;
+  size_t tiles_visited;
+  size_t tiles_drawn;
+} bs_tile_draw_stats;
 
 typedef struct bs_saved_room_state {
   bs_instance *instances;
+  bs_instance_motion *motion;
   size_t instance_count;
 } bs_saved_room_state;
 
@@ -207,6 +178,118 @@ typedef struct bs_audio_backend {
   bs_audio_get_track_position_callback get_track_position;
 } bs_audio_backend;
 
+/* A resolved (event_type, subtype) handler: the entry that fires for the object after walking its
+ * parent chain, and the object that owns it. */
+typedef struct bs_event_dispatch_slot {
+  int32_t subtype;
+  int32_t owner_object_index;
+  const bs_event_entry *entry;
+} bs_event_dispatch_slot;
+
+/* slots are in chain order (own entries first, then inherited ones); sorted_slots indexes them by
+ * ascending subtype for lookup. */
+typedef struct bs_event_dispatch_row {
+  bs_event_dispatch_slot *slots;
+  uint32_t *sorted_slots;
+  size_t slot_count;
+} bs_event_dispatch_row;
+
+typedef enum bs_dispatch_state {
+  BS_DISPATCH_UNBUILT = 0,
+  BS_DISPATCH_BUILDING = 1,
+  BS_DISPATCH_READY = 2
+} bs_dispatch_state;
+
+/* Per-object event table with inheritance flattened, built the first time the object fires an
+ * event. parent_object_index is the precomputed link event_inherited follows. collision_targets
+ * lists the objects it has collision events for, in the order a chain walk first meets them; it
+ * shares storage with the rows. */
+typedef struct bs_object_dispatch {
+  bs_event_dispatch_row rows[BS_EVENT_TYPE_COUNT];
+  bs_event_dispatch_slot *storage;
+  int32_t *collision_targets;
+  size_t collision_target_count;
+  int32_t parent_object_index;
+  uint8_t state;
+} bs_object_dispatch;
+
+#define BS_ANCESTRY_NONE UINT32_MAX
+
+/* Subtypes at or above this are not tracked; dispatching them scans every instance. */
+#define BS_EVENT_LISTENER_MAX_SUBTYPE 1024
+
+/* Live instances whose object (or an ancestor) handles one (event_type, subtype), as pool slots in
+ * creation order. Destroyed instances stay listed until they are released at the end of the frame;
+ * firing skips them. stale is set when a listed slot is released, and the list then drops its
+ * released slots in one pass before the frame ends. */
+typedef struct bs_event_listener_list {
+  uint32_t *instance_slots;
+  size_t count;
+  size_t capacity;
+  bool stale;
+} bs_event_listener_list;
+
+/* Lists for one event type, indexed by subtype and grown as objects that handle it appear. */
+typedef struct bs_event_listener_row {
+  bs_event_listener_list *lists;
+  size_t subtype_count;
+} bs_event_listener_row;
+
+/* Live instances of one object in creation order, linked through their slots' object_prev and
+ * object_next. Destroyed instances stay linked until they are released. own_count counts the linked
+ * instances that are not destroyed; live_count adds those of every descendant object, which is what
+ * instance_number reports. */
+typedef struct bs_object_registry {
+  uint32_t head;
+  uint32_t tail;
+  size_t own_count;
+  size_t live_count;
+  int32_t parent_object_index;
+} bs_object_registry;
+
+typedef enum bs_instance_walk {
+  BS_INSTANCE_WALK_DONE = 0,
+  BS_INSTANCE_WALK_ID = 1,
+  BS_INSTANCE_WALK_OBJECT = 2,
+  BS_INSTANCE_WALK_ALL = 3
+} bs_instance_walk;
+
+/* Position in a walk over the instances an instance id or object index names, for with blocks and
+ * object-wide assignments. Visits in creation order, skips destroyed instances and stops before
+ * anything created after the walk began; the body may destroy or create instances freely. An object
+ * with no live descendants walks its own registry list, anything else the whole instance list. */
+typedef struct bs_instance_iterator {
+  int32_t target;
+  uint8_t walk;
+  bs_instance_handle current;
+  uint64_t sequence_limit;
+} bs_instance_iterator;
+
+#define BS_COLLISION_MAX_THREADS 16u
+
+/* A collision the narrowphase found: snapshot entries self and other, and the target object whose
+ * collision event self would fire. */
+typedef struct bs_collision_hit {
+  uint32_t self;
+  uint32_t other;
+  int32_t target;
+} bs_collision_hit;
+
+/* One narrowphase thread's share of the snapshot, [begin, end), and the buffers it keeps across
+ * frames. ok is false if it ran out of memory and its hits are incomplete. */
+typedef struct bs_collision_worker {
+  bs_collision_grid_reader grid_reader;
+  bs_collision_grid_reader static_reader;
+  uint32_t *merged;
+  size_t merged_capacity;
+  bs_collision_hit *hits;
+  size_t hit_count;
+  size_t hit_capacity;
+  size_t begin;
+  size_t end;
+  bool ok;
+} bs_collision_worker;
+
 typedef struct bs_game_runner {
   const bs_game_data *game_data;
   bs_vm *vm;
@@ -219,13 +302,51 @@ typedef struct bs_game_runner {
   int32_t pending_room_goto;
   int32_t next_instance_id;
 
-  bs_instance *instances;
-  size_t instance_count;
-  size_t instance_capacity;
+  bs_instance_pool instance_pool;
   bool *room_persistent_flags;
   size_t room_persistent_flag_count;
   bs_saved_room_state *saved_room_states;
   size_t saved_room_state_count;
+  bs_object_dispatch *object_dispatch;
+  size_t object_dispatch_count;
+  /* Euler-tour interval of each object in the parent forest: b is an ancestor of a when
+   * ancestry_enter[b] < ancestry_enter[a] < ancestry_exit[b]. BS_ANCESTRY_NONE marks objects on a
+   * parent cycle or deeper than the 64-link walk, which is_child_of still walks. */
+  uint32_t *ancestry_enter;
+  uint32_t *ancestry_exit;
+  bs_object_registry *object_registry;
+  size_t object_registry_count;
+  bs_event_listener_row event_listeners[BS_EVENT_TYPE_COUNT];
+  bool event_listeners_ready;
+  bs_collision_grid collision_grid;
+  uint32_t *collision_entry_of_slot;
+  size_t collision_entry_of_slot_capacity;
+  bool collision_tracking;
+  bs_sweep_list solid_sweep;
+  bs_collision_grid static_grid;
+  bs_instance_handle *static_entries;
+  size_t static_entry_count;
+  size_t static_entry_capacity;
+  bs_collision_grid query_grid;
+  bool query_grid_ready;
+  uint32_t *query_results;
+  size_t query_result_capacity;
+  bs_collision_worker collision_workers[BS_COLLISION_MAX_THREADS];
+  size_t collision_thread_count;
+  /* Narrowphase threads, started on the first step that splits the pass; NULL until then. */
+  struct bs_collision_pool *collision_pool;
+  /* False once an insert failed; drawing then falls back to scanning every depth. */
+  bs_draw_list draw_list;
+  bool draw_list_ready;
+  /* tile_layer_capacity layers keep their grids across rooms; tile_layer_count are in use. When
+   * the layers could not be built, tile_layers_ready is false and tiles are drawn unculled. */
+  bs_tile_layer *tile_layers;
+  size_t tile_layer_count;
+  size_t tile_layer_capacity;
+  uint32_t *tile_layer_indices;
+  size_t tile_layer_index_capacity;
+  bool tile_layers_ready;
+  bs_tile_draw_stats tile_stats;
 
   bool keys_held[256];
   bool keys_pressed[256];
@@ -258,6 +379,14 @@ typedef struct bs_game_runner {
   bs_audio_backend audio;
 } bs_game_runner;
 
+static inline bs_instance *bs_game_runner_first_instance(const bs_game_runner *runner) {
+  return bs_instance_pool_first(&runner->instance_pool);
+}
+
+static inline bs_instance *bs_game_runner_next_instance(const bs_game_runner *runner, const bs_instance *instance) {
+  return bs_instance_pool_next(&runner->instance_pool, instance);
+}
+
 void bs_game_runner_init(bs_game_runner *runner, const bs_game_data *game_data, bs_vm *vm);
 void bs_game_runner_step(bs_game_runner *runner);
 void bs_game_runner_goto_room(bs_game_runner *runner, int32_t room_index);
@@ -268,14 +397,35 @@ void bs_game_runner_fire_event_for_instance(bs_game_runner *runner,
                                             int32_t event_type,
                                             int32_t subtype);
 void bs_game_runner_path_end_instance(bs_game_runner *runner, bs_instance *instance);
-bool bs_game_runner_compute_instance_bbox(const bs_game_runner *runner,
+void bs_game_runner_note_bbox_change(bs_game_runner *runner, const bs_instance *instance);
+bool bs_game_runner_compute_instance_bbox(bs_game_runner *runner,
                                           const bs_instance *instance,
                                           bs_bbox *out_bbox);
+bool bs_game_runner_read_instance_bbox(const bs_game_runner *runner,
+                                       const bs_instance *instance,
+                                       bs_bbox *out_bbox);
+bool bs_game_runner_instance_mask(const bs_game_runner *runner,
+                                  const bs_instance *instance,
+                                  bs_collision_mask *out_mask);
 bool bs_game_runner_instances_overlap(const bs_game_runner *runner,
                                       const bs_instance *a,
                                       const bs_instance *b);
+bool bs_game_runner_instance_bbox_at(const bs_game_runner *runner,
+                                     const bs_instance *instance,
+                                     double x,
+                                     double y,
+                                     bs_bbox *out_bbox);
+bool bs_game_runner_instance_overlaps_at(const bs_game_runner *runner,
+                                         const bs_instance *a,
+                                         double x,
+                                         double y,
+                                         const bs_instance *b);
+const uint32_t *bs_game_runner_query_instances(bs_game_runner *runner, const bs_bbox *bbox, size_t *out_count);
 bs_instance *bs_game_runner_find_instance_by_id(bs_game_runner *runner, int32_t id);
 bool bs_game_runner_object_is_child_of(const bs_game_runner *runner, int32_t child_object_index, int32_t parent_object_index);
+size_t bs_game_runner_object_instance_count(const bs_game_runner *runner, int32_t object_index);
+void bs_game_runner_iterate_instances(const bs_game_runner *runner, int32_t target, bs_instance_iterator *out_iterator);
+bs_instance *bs_game_runner_iterator_next(const bs_game_runner *runner, bs_instance_iterator *iterator);
 bs_instance *bs_game_runner_create_instance_runtime(bs_game_runner *runner,
                                                     int32_t object_index,
                                                     double x,
@@ -292,6 +442,7 @@ bool bs_game_runner_instance_set_variable(bs_game_runner *runner,
                                           int32_t variable_index,
                                           const char *variable_name,
                                           double value);
+void bs_game_runner_tile_stats(const bs_game_runner *runner, bs_tile_draw_stats *out_stats);
 void bs_game_runner_dispose(bs_game_runner *runner);
 
 #endif
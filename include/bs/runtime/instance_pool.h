@@ -0,0 +1,150 @@
+#ifndef BS_RUNTIME_INSTANCE_POOL_H
+#define BS_RUNTIME_INSTANCE_POOL_H
+
+#include "bs/runtime/motion.h"
+
+/* Rarely-touched per-instance state. Motion fields live in the pool; reach them with BS_MOTION. */
+typedef struct bs_instance {
+  int32_t id;
+  int32_t object_index;
+  double xstart;
+  double ystart;
+  int32_t mask_index;
+  int32_t sprite_index;
+  int32_t depth;
+  bool visible;
+  bool solid;
+  bool persistent;
+  double image_xscale;
+  double image_yscale;
+  double image_angle;
+  double image_alpha;
+  double image_single;
+  int32_t image_blend;
+  int32_t path_index;
+  double path_position;
+  double path_speed;
+  int32_t path_end_action;
+  double path_orientation;
+  double path_scale;
+  double path_x_offset;
+  double path_y_offset;
+  int32_t alarm[12];
+
+  int32_t *variable_indices;
+  double *variable_values;
+  size_t variable_count;
+  size_t variable_capacity;
+
+  bool has_been_marked_as_outside_room;
+  bool destroyed;
+} bs_instance;
+
+#define BS_INSTANCE_BLOCK_SHIFT 8u
+#define BS_INSTANCE_BLOCK_SIZE (1u << BS_INSTANCE_BLOCK_SHIFT)
+#define BS_INSTANCE_SLOT_NONE UINT32_MAX
+
+struct bs_instance_pool;
+
+/* Pool bookkeeping around one instance. The instance comes first so a bs_instance pointer converts
+ * back to its slot. prev/next link live slots in creation order; next_released chains destroyed
+ * slots waiting for the end of the frame. generation changes every time the slot is freed, and
+ * sequence numbers acquisitions, so it orders live slots the same way the list does.
+ * object_prev/object_next are left to the runner, which links each object's instances through
+ * them. */
+typedef struct bs_instance_slot {
+  bs_instance instance;
+  struct bs_instance_pool *pool;
+  uint64_t sequence;
+  uint32_t index;
+  uint32_t generation;
+  uint32_t prev;
+  uint32_t next;
+  uint32_t next_released;
+  uint32_t object_prev;
+  uint32_t object_next;
+  bool live;
+  bool release_pending;
+} bs_instance_slot;
+
+/* Refers to an instance without keeping a pointer; resolves to NULL once the slot is reused. */
+typedef struct bs_instance_handle {
+  uint32_t slot;
+  uint32_t generation;
+} bs_instance_handle;
+
+/* Open-addressed id -> slot table with linear probing; empty cells hold BS_INSTANCE_SLOT_NONE. */
+typedef struct bs_instance_id_map {
+  int32_t *ids;
+  uint32_t *slots;
+  size_t capacity;
+  size_t count;
+  size_t duplicate_count;
+} bs_instance_id_map;
+
+/* Instances live in fixed-size blocks so their addresses never move. Freed slots go on a free list
+ * and are reused; count includes destroyed instances until they are released. */
+typedef struct bs_instance_pool {
+  bs_instance_slot **blocks;
+  size_t block_count;
+  size_t slot_count;
+  size_t count;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t free_head;
+  uint32_t released_head;
+  uint64_t next_sequence;
+  bs_instance_id_map id_map;
+  bs_instance_motion_columns motion;
+} bs_instance_pool;
+
+static inline bs_instance *bs_instance_pool_at(const bs_instance_pool *pool, uint32_t slot) {
+  return &pool->blocks[slot >> BS_INSTANCE_BLOCK_SHIFT][slot & (BS_INSTANCE_BLOCK_SIZE - 1u)].instance;
+}
+
+static inline uint32_t bs_instance_slot_index(const bs_instance *instance) {
+  return ((const bs_instance_slot *)(const void *)instance)->index;
+}
+
+static inline uint64_t bs_instance_sequence(const bs_instance *instance) {
+  return ((const bs_instance_slot *)(const void *)instance)->sequence;
+}
+
+static inline bs_instance_motion_columns *bs_instance_motion_of(const bs_instance *instance) {
+  return &((const bs_instance_slot *)(const void *)instance)->pool->motion;
+}
+
+/* Lvalue for one motion field of a pooled instance, e.g. BS_MOTION(inst, x) += 1.0. Writes to x or
+ * y must be followed by bs_instance_invalidate_bbox (or bs_game_runner_note_bbox_change). */
+#define BS_MOTION(instance, field) (bs_instance_motion_of(instance)->field[bs_instance_slot_index(instance)])
+
+static inline void bs_instance_invalidate_bbox(const bs_instance *instance) {
+  bs_instance_motion_of(instance)->bbox_state[bs_instance_slot_index(instance)] = BS_BBOX_DIRTY;
+}
+
+static inline bs_instance *bs_instance_pool_first(const bs_instance_pool *pool) {
+  return pool->head == BS_INSTANCE_SLOT_NONE ? NULL : bs_instance_pool_at(pool, pool->head);
+}
+
+static inline bs_instance *bs_instance_pool_last(const bs_instance_pool *pool) {
+  return pool->tail == BS_INSTANCE_SLOT_NONE ? NULL : bs_instance_pool_at(pool, pool->tail);
+}
+
+static inline bs_instance *bs_instance_pool_next(const bs_instance_pool *pool, const bs_instance *instance) {
+  uint32_t next = ((const bs_instance_slot *)(const void *)instance)->next;
+  return next == BS_INSTANCE_SLOT_NONE ? NULL : bs_instance_pool_at(pool, next);
+}
+
+void bs_instance_pool_init(bs_instance_pool *pool);
+void bs_instance_pool_dispose(bs_instance_pool *pool);
+bs_instance *bs_instance_pool_acquire(bs_instance_pool *pool, int32_t id);
+void bs_instance_pool_mark_released(bs_instance_pool *pool, bs_instance *instance);
+bs_instance *bs_instance_pool_pop_released(bs_instance_pool *pool);
+void bs_instance_pool_release(bs_instance_pool *pool, bs_instance *instance);
+void bs_instance_pool_load_motion(const bs_instance *instance, bs_instance_motion *out_motion);
+void bs_instance_pool_store_motion(bs_instance *instance, const bs_instance_motion *motion);
+bs_instance *bs_instance_pool_find_id(const bs_instance_pool *pool, int32_t id);
+bs_instance_handle bs_instance_pool_handle(const bs_instance *instance);
+bs_instance *bs_instance_pool_resolve(const bs_instance_pool *pool, bs_instance_handle handle);
+
+#endif
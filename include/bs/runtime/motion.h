@@ -0,0 +1,72 @@
+#ifndef BS_RUNTIME_MOTION_H
+#define BS_RUNTIME_MOTION_H
+
+#include "bs/common.h"
+
+/* The fields every frame simulates for every instance. The pool stores them column-wise, one entry
+ * per slot, and this struct carries one instance's values when it leaves the pool. */
+typedef struct bs_instance_motion {
+  double x;
+  double y;
+  double xprevious;
+  double yprevious;
+  double hspeed;
+  double vspeed;
+  double speed;
+  double direction;
+  double friction;
+  double gravity;
+  double gravity_direction;
+  double image_index;
+  double image_speed;
+} bs_instance_motion;
+
+#define BS_BBOX_DIRTY 0u
+#define BS_BBOX_READY 1u
+#define BS_BBOX_NONE 2u
+#define BS_BBOX_STATE_MASK 3u
+/* Set beside READY while the instance is baked into the runner's static grid. Every invalidation
+ * writes BS_BBOX_DIRTY and so clears it, which is what un-bakes an instance that moves. */
+#define BS_BBOX_BAKED 4u
+
+/* Motion fields indexed by slot. active is nonzero for live slots whose instance is not destroyed,
+ * so whole-pool passes can run over the columns without touching bs_instance. The trig cache
+ * columns (cos/sin of the angle stored beside them) are private to the motion pass.
+ *
+ * bbox_* cache each slot's bounding box. bbox_state drops to BS_BBOX_DIRTY whenever x, y,
+ * sprite_index, mask_index or an image scale is written (see bs_instance_invalidate_bbox), and
+ * bs_game_runner_compute_instance_bbox refills it as READY, or NONE when there is no sprite.
+ * bs_game_runner_read_instance_bbox reads it without refilling, for callers that must not write. */
+typedef struct bs_instance_motion_columns {
+  double *x;
+  double *y;
+  double *xprevious;
+  double *yprevious;
+  double *hspeed;
+  double *vspeed;
+  double *speed;
+  double *direction;
+  double *friction;
+  double *gravity;
+  double *gravity_direction;
+  double *image_index;
+  double *image_speed;
+  double *gravity_trig_angle;
+  double *gravity_cos;
+  double *gravity_sin;
+  double *direction_trig_angle;
+  double *direction_cos;
+  double *direction_sin;
+  double *bbox_left;
+  double *bbox_top;
+  double *bbox_right;
+  double *bbox_bottom;
+  uint8_t *bbox_state;
+  uint8_t *active;
+  size_t capacity;
+} bs_instance_motion_columns;
+
+void bs_instance_motion_store_previous(bs_instance_motion_columns *motion, size_t slot_count);
+void bs_instance_motion_integrate(bs_instance_motion_columns *motion, size_t slot_count);
+
+#endif
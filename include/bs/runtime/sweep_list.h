@@ -0,0 +1,42 @@
+#ifndef BS_RUNTIME_SWEEP_LIST_H
+#define BS_RUNTIME_SWEEP_LIST_H
+
+#include "bs/runtime/bbox.h"
+
+typedef struct bs_sweep_entry {
+  double left;
+  double right;
+  double top;
+  double bottom;
+  uint32_t key;
+  uint32_t epoch;
+} bs_sweep_entry;
+
+/* Boxes kept sorted by left edge (sweep-and-prune on x). Keys are small dense integers such as
+ * pool slots; positions maps a key to its entry. The list is kept across frames and re-sorted
+ * with insertion sort, which is near linear while boxes move coherently. */
+typedef struct bs_sweep_list {
+  bs_sweep_entry *entries;
+  size_t count;
+  size_t capacity;
+  uint32_t *positions;
+  size_t key_capacity;
+  double max_width;
+  uint32_t epoch;
+} bs_sweep_list;
+
+void bs_sweep_list_init(bs_sweep_list *list);
+void bs_sweep_list_dispose(bs_sweep_list *list);
+void bs_sweep_list_begin_update(bs_sweep_list *list);
+bool bs_sweep_list_set(bs_sweep_list *list, uint32_t key, const bs_bbox *bbox);
+void bs_sweep_list_end_update(bs_sweep_list *list);
+void bs_sweep_list_move(bs_sweep_list *list, uint32_t key, const bs_bbox *bbox);
+size_t bs_sweep_list_first_candidate(const bs_sweep_list *list, const bs_bbox *bbox);
+bool bs_sweep_list_next_overlap(const bs_sweep_list *list,
+                                const bs_bbox *bbox,
+                                uint32_t skip_key,
+                                size_t *cursor,
+                                uint32_t *out_key);
+bool bs_sweep_list_any_overlap(const bs_sweep_list *list, const bs_bbox *bbox, uint32_t skip_key);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef BS_VM_IMAGE_H
+#define BS_VM_IMAGE_H
+
+#include "bs/common.h"
+#include "bs/data/form_reader.h"
+#include "bs/vm/vm.h"
+
+/* A precompiled image holds the decoded, linked CODE entries of one data.win. All references in
+ * the file are offsets from its start, so it is mapped read-only and used in place. */
+typedef struct bs_image {
+  const uint8_t *bytes;
+  size_t size;
+  bool mapped;
+  void *mapping;
+  uint64_t source_hash;
+  size_t code_entry_count;
+  uint32_t resolved_variables;
+  uint32_t resolved_functions;
+} bs_image;
+
+uint64_t bs_image_hash_source(const bs_game_data *game_data);
+bool bs_image_write(const char *path,
+                    const bs_game_data *game_data,
+                    const bs_decoded_code *entries,
+                    size_t entry_count,
+                    uint32_t resolved_variables,
+                    uint32_t resolved_functions);
+bool bs_image_open(const char *path, const bs_game_data *game_data, bs_image *out_image);
+bool bs_image_code_entry(const bs_image *image, size_t index, bs_decoded_code *out_code);
+void bs_image_close(bs_image *image);
+
+bool bs_image_default_path(const char *game_path, char *out_path, size_t out_size);
+bool bs_image_open_for_game(const bs_game_data *game_data, bs_image *out_image);
+
+#endif
@@ -5,6 +5,7 @@
 #include "bs/data/form_reader.h"
 
 struct bs_game_runner;
+struct bs_image;
 struct bs_vm;
 
 typedef enum bs_vm_value_type {
@@ -135,6 +136,28 @@ typedef struct bs_decoded_code {
   size_t instruction_count;
 } bs_decoded_code;
 
+typedef struct bs_code_patch {
+  uint32_t local_offset;
+  int32_t target_index;
+  bool is_function;
+} bs_code_patch;
+
+typedef struct bs_code_patch_list {
+  bs_code_patch *patches;
+  size_t count;
+  size_t capacity;
+} bs_code_patch_list;
+
+typedef struct bs_specialized_code {
+  bs_decoded_code code;
+  int32_t *global_indices;
+  size_t global_count;
+  uint32_t execution_count;
+  uint32_t attempt_threshold;
+  uint32_t active_depth;
+  bool valid;
+} bs_specialized_code;
+
 typedef struct bs_code_range {
   uint32_t start;
   uint32_t end;
@@ -154,13 +177,32 @@ typedef struct bs_vm {
   struct bs_game_runner *runner;
   bs_decoded_code *decoded_entries;
   size_t decoded_entry_count;
+  bool *decoded_entry_ready;
+  bs_code_patch_list *entry_patches;
+  size_t decoded_ready_count;
+  size_t decoded_resident_bytes;
+  bool lazy_decode;
+  bool image_backed;
+  uint32_t resolved_variable_count;
+  uint32_t resolved_function_count;
+  double init_millis;
+  bs_load_stats load_stats;
   bs_code_range *code_ranges;
   size_t code_range_count;
+  bs_specialized_code *specialized_entries;
+  bool specialize_enabled;
+  uint64_t execution_serial;
+  uint32_t specialized_entry_total;
+  uint32_t deoptimized_entry_total;
 
   int32_t *global_variable_indices;
   bs_vm_value *global_variable_values;
   size_t global_variable_count;
   size_t global_variable_capacity;
+  uint32_t *global_write_counts;
+  uint64_t *global_last_write_serials;
+  uint32_t *global_specialized_refs;
+  size_t global_write_tracking_count;
   int32_t *global_array_variable_indices;
   int32_t *global_array_element_indices;
   bs_vm_value *global_array_values;
@@ -203,7 +245,10 @@ typedef struct bs_vm {
 } bs_vm;
 
 void bs_vm_init(bs_vm *vm, const bs_game_data *game_data);
+void bs_vm_init_with_image(bs_vm *vm, const bs_game_data *game_data, const struct bs_image *image);
+bool bs_vm_write_image(bs_vm *vm, const char *path);
 void bs_vm_dispose(bs_vm *vm);
+void bs_vm_note_global_write(bs_vm *vm, int32_t variable_index);
 bool bs_vm_register_builtin(bs_vm *vm, const char *name, bs_vm_builtin_callback callback);
 bool bs_vm_execute_code(bs_vm *vm,
                         size_t code_entry_index,
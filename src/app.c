@@ -3,18 +3,43 @@
 #include "bs/builtin/builtin_registry.h"
 #include "bs/data/form_reader.h"
 #include "bs/runtime/game_runner.h"
+#include "bs/vm/image.h"
 #include "bs/vm/vm.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+static double bs_app_now_millis(void) {
+  struct timespec ts;
+  if (timespec_get(&ts, TIME_UTC) == TIME_UTC) {
+    return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+  }
+  return 0.0;
+}
 
 int bs_run(const char *game_path, int frame_count) {
+  bs_run_options options = {0};
+  options.game_path = game_path;
+  options.frame_count = frame_count;
+  return bs_run_with_options(&options);
+}
+
+int bs_run_with_options(const bs_run_options *options) {
   bs_game_data game_data = {0};
+  bs_load_stats load_stats;
+  bs_load_phase *phase = NULL;
+  const char *game_path = options->game_path;
+  int frame_count = options->frame_count;
+  double start_millis = bs_app_now_millis();
+  double phase_start_millis = 0.0;
+  bs_load_stats_reset(&load_stats);
   if (!bs_form_reader_read(game_path, &game_data)) {
     fprintf(stderr, "Failed to read game data: %s\n", game_path);
     return 1;
   }
+  bs_load_stats_append(&load_stats, &game_data.load_stats);
 
   printf("Butterscotch-C bootstrap\n");
   printf("Game file: %s\n", game_data.game_path);
@@ -43,12 +68,25 @@ int bs_run(const char *game_path, int frame_count) {
          game_data.variable_count,
          game_data.function_count);
 
+  bs_image image = {0};
+  phase_start_millis = bs_app_now_millis();
+  bool have_image = bs_image_open_for_game(&game_data, &image);
+  phase = bs_load_stats_add(&load_stats, "app", "open_image", bs_app_now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->items = have_image ? 1u : 0u;
+    phase->allocations = (have_image && !image.mapped) ? 1u : 0u;
+    phase->bytes = image.size;
+  }
+
   bs_vm vm = {0};
-  bs_vm_init(&vm, &game_data);
+  bs_vm_init_with_image(&vm, &game_data, have_image ? &image : NULL);
   bs_register_builtins(&vm);
+  bs_load_stats_append(&load_stats, &vm.load_stats);
 
   bs_game_runner runner = {0};
+  phase_start_millis = bs_app_now_millis();
   bs_game_runner_init(&runner, &game_data, &vm);
+  (void)bs_load_stats_add(&load_stats, "app", "runner_init", bs_app_now_millis() - phase_start_millis);
 
   const char *auto_key_frame_env = getenv("BS_AUTOKEY_FRAME");
   const char *auto_key_code_env = getenv("BS_AUTOKEY_CODE");
@@ -78,11 +116,69 @@ int bs_run(const char *game_path, int frame_count) {
     if (!auto_key_hold && auto_key_frame >= 0 && i == auto_key_frame + 1) {
       bs_game_runner_on_key_up(&runner, auto_key_code);
     }
+    phase_start_millis = bs_app_now_millis();
     bs_game_runner_step(&runner);
+    if (i == 0) {
+      phase = bs_load_stats_add(&load_stats, "app", "first_frame", bs_app_now_millis() - phase_start_millis);
+      if (phase != NULL) {
+        phase->items = vm.decoded_ready_count;
+      }
+      if (options->load_json_path != NULL) {
+        (void)bs_load_stats_dump_json(&load_stats, game_data.game_path, options->load_json_path);
+      }
+      printf("First frame after %.2f ms (VM init %.2f ms, %s decode): %zu/%zu code entries decoded, %zu bytes resident, %zu/%zu assets parsed\n",
+             bs_app_now_millis() - start_millis,
+             vm.init_millis,
+             vm.image_backed ? "image" : (vm.lazy_decode ? "lazy" : "eager"),
+             vm.decoded_ready_count,
+             vm.decoded_entry_count,
+             vm.decoded_resident_bytes,
+             bs_game_data_materialized_asset_count(&game_data),
+             game_data.sprite_count + game_data.path_count + game_data.font_count +
+                 game_data.object_count + game_data.room_count);
+    }
   }
 
   bs_game_runner_dispose(&runner);
   bs_vm_dispose(&vm);
+  bs_image_close(&image);
   bs_game_data_free(&game_data);
   return 0;
 }
+
+/* Decodes and links every CODE entry of game_path and writes it as a precompiled image. */
+int bs_build_image(const char *game_path, const char *image_path) {
+  bs_game_data game_data = {0};
+  bs_vm vm = {0};
+  char default_path[4096];
+  double start_millis = bs_app_now_millis();
+  int status = 0;
+
+  if (!bs_form_reader_read(game_path, &game_data)) {
+    fprintf(stderr, "Failed to read game data: %s\n", game_path);
+    return 1;
+  }
+  if (image_path == NULL) {
+    if (!bs_image_default_path(game_data.game_path, default_path, sizeof(default_path))) {
+      fprintf(stderr, "Image path too long for %s\n", game_path);
+      bs_game_data_free(&game_data);
+      return 1;
+    }
+    image_path = default_path;
+  }
+
+  bs_vm_init(&vm, &game_data);
+  if (!vm.initialized || !bs_vm_write_image(&vm, image_path)) {
+    fprintf(stderr, "Failed to build image: %s\n", image_path);
+    status = 1;
+  } else {
+    printf("Built image %s: %zu code entries in %.2f ms\n",
+           image_path,
+           vm.decoded_entry_count,
+           bs_app_now_millis() - start_millis);
+  }
+
+  bs_vm_dispose(&vm);
+  bs_game_data_free(&game_data);
+  return status;
+}
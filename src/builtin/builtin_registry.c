@@ -277,11 +277,10 @@ static bool bs_builtin_interpolate_path_position(const bs_game_data *game_data,
   if (game_data == NULL || out_x == NULL || out_y == NULL) {
     return false;
   }
-  if (path_index < 0 || (size_t)path_index >= game_data->path_count) {
+  path = bs_game_data_path(game_data, path_index);
+  if (path == NULL) {
     return false;
   }
-
-  path = &game_data->paths[(size_t)path_index];
   if (path->point_count == 0) {
     return false;
   }
@@ -384,6 +383,7 @@ static bool bs_builtin_global_set_by_index(bs_vm *vm, int32_t variable_index, do
   if (vm == NULL || variable_index < 0) {
     return false;
   }
+  bs_vm_note_global_write(vm, variable_index);
 
   for (size_t i = 0; i < vm->global_variable_count; i++) {
     if (vm->global_variable_indices[i] == variable_index) {
@@ -498,52 +498,42 @@ static bs_vm_value bs_builtin_instance_exists(bs_vm *vm, const bs_vm_value *args
       return bs_vm_make_number((inst != NULL && !inst->destroyed) ? 1.0 : 0.0);
     }
 
-    for (size_t i = 0; i < vm->runner->instance_count; i++) {
-      if (!vm->runner->instances[i].destroyed &&
-          bs_game_runner_object_is_child_of(vm->runner, vm->runner->instances[i].object_index, target)) {
-        return bs_vm_make_number(1.0);
-      }
-    }
+    return bs_vm_make_number(bs_game_runner_object_instance_count(vm->runner, target) > 0 ? 1.0 : 0.0);
   }
-
-  return bs_vm_make_number(0.0);
 }
 
 static bs_vm_value bs_builtin_instance_number(bs_vm *vm, const bs_vm_value *args, size_t argc) {
   int32_t object_index = 0;
-  double count = 0.0;
   if (vm == NULL || vm->runner == NULL || argc < 1) {
     return bs_vm_make_number(0.0);
   }
 
   object_index = (int32_t)bs_builtin_arg_to_number(args, argc, 0, -1.0);
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    if (!vm->runner->instances[i].destroyed &&
-        bs_game_runner_object_is_child_of(vm->runner, vm->runner->instances[i].object_index, object_index)) {
-      count += 1.0;
-    }
-  }
-  return bs_vm_make_number(count);
+  return bs_vm_make_number((double)bs_game_runner_object_instance_count(vm->runner, object_index));
 }
 
 static bs_vm_value bs_builtin_instance_find(bs_vm *vm, const bs_vm_value *args, size_t argc) {
   int32_t object_index = 0;
   int32_t target_n = 0;
   int32_t current_n = 0;
+  bs_instance_iterator instances;
   if (vm == NULL || vm->runner == NULL || argc < 2) {
     return bs_vm_make_number(-4.0);
   }
 
   object_index = (int32_t)bs_builtin_arg_to_number(args, argc, 0, -1.0);
   target_n = (int32_t)bs_builtin_arg_to_number(args, argc, 1, 0.0);
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    if (!vm->runner->instances[i].destroyed &&
-        bs_game_runner_object_is_child_of(vm->runner, vm->runner->instances[i].object_index, object_index)) {
-      if (current_n == target_n) {
-        return bs_vm_make_number((double)vm->runner->instances[i].id);
-      }
-      current_n++;
+  if (object_index < 0 || object_index >= 100000 ||
+      target_n < 0 || (size_t)target_n >= bs_game_runner_object_instance_count(vm->runner, object_index)) {
+    return bs_vm_make_number(-4.0);
+  }
+  bs_game_runner_iterate_instances(vm->runner, object_index, &instances);
+  for (const bs_instance *inst = bs_game_runner_iterator_next(vm->runner, &instances); inst != NULL;
+       inst = bs_game_runner_iterator_next(vm->runner, &instances)) {
+    if (current_n == target_n) {
+      return bs_vm_make_number((double)inst->id);
     }
+    current_n++;
   }
   return bs_vm_make_number(-4.0);
 }
@@ -574,11 +564,12 @@ static bs_vm_value bs_builtin_path_start(bs_vm *vm, const bs_vm_value *args, siz
     if (absolute) {
       self->path_x_offset = 0.0;
       self->path_y_offset = 0.0;
-      self->x = start_x;
-      self->y = start_y;
+      BS_MOTION(self, x) = start_x;
+      BS_MOTION(self, y) = start_y;
+      bs_game_runner_note_bbox_change(vm->runner, self);
     } else {
-      self->path_x_offset = self->x - start_x;
-      self->path_y_offset = self->y - start_y;
+      self->path_x_offset = BS_MOTION(self, x) - start_x;
+      self->path_y_offset = BS_MOTION(self, y) - start_y;
     }
   }
 
@@ -982,10 +973,7 @@ static const bs_font_data *bs_builtin_current_font(const bs_vm *vm) {
     return NULL;
   }
   font_index = vm->runner->draw_font_index;
-  if (font_index < 0 || (size_t)font_index >= vm->game_data->font_count) {
-    return NULL;
-  }
-  return &vm->game_data->fonts[(size_t)font_index];
+  return bs_game_data_font(vm->game_data, font_index);
 }
 
 static const bs_font_glyph_data *bs_builtin_find_glyph_ascii(const bs_font_data *font, uint8_t ch) {
@@ -1800,14 +1788,15 @@ static bs_vm_value bs_builtin_draw_self(bs_vm *vm, const bs_vm_value *args, size
       (vm->runner->render.draw_sprite_ext == NULL && vm->runner->render.draw_sprite == NULL)) {
     return bs_vm_make_number(0.0);
   }
-  frame = (self->image_single >= 0.0) ? (int32_t)self->image_single : (int32_t)floor(self->image_index);
+  frame = (self->image_single >= 0.0) ? (int32_t)self->image_single
+                                      : (int32_t)floor(BS_MOTION(self, image_index));
   if (vm->runner->render.draw_sprite_ext != NULL) {
     vm->runner->render.draw_sprite_ext(vm->runner->render.userdata,
                                        vm->runner,
                                        self->sprite_index,
                                        frame,
-                                       self->x,
-                                       self->y,
+                                       BS_MOTION(self, x),
+                                       BS_MOTION(self, y),
                                        self->image_xscale,
                                        self->image_yscale,
                                        self->image_angle,
@@ -1818,8 +1807,8 @@ static bs_vm_value bs_builtin_draw_self(bs_vm *vm, const bs_vm_value *args, size
                                    vm->runner,
                                    self->sprite_index,
                                    frame,
-                                   self->x,
-                                   self->y,
+                                   BS_MOTION(self, x),
+                                   BS_MOTION(self, y),
                                    self->image_blend,
                                    self->image_alpha);
   }
@@ -2111,193 +2100,346 @@ static bs_vm_value bs_builtin_keyboard_check_direct(bs_vm *vm, const bs_vm_value
   return bs_builtin_keyboard_check(vm, args, argc);
 }
 
-static bs_vm_value bs_builtin_collision_point(bs_vm *vm, const bs_vm_value *args, size_t argc) {
-  double px = bs_builtin_arg_to_number(args, argc, 0, 0.0);
-  double py = bs_builtin_arg_to_number(args, argc, 1, 0.0);
-  int32_t target = (int32_t)bs_builtin_arg_to_number(args, argc, 2, -1.0);
-  bool precise = bs_builtin_arg_to_number(args, argc, 3, 0.0) != 0.0;
-  bool notme = bs_builtin_arg_to_number(args, argc, 4, 0.0) != 0.0;
-  int32_t self_id = -1;
-  (void)precise;
-  if (vm == NULL || vm->runner == NULL || argc < 5) {
-    return bs_vm_make_number(-4.0);
-  }
-  self_id = vm->current_self_id;
-
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    bs_instance *inst = &vm->runner->instances[i];
+/* One collision_* or place_* call: bounds encloses everything it can hit, and the remaining fields
+ * are read by its test. place_* try mover at (x1, y1). */
+typedef struct bs_builtin_collision_query {
+  bs_bbox bounds;
+  double x1;
+  double y1;
+  double x2;
+  double y2;
+  double radius;
+  bool precise;
+  bool solid_only;
+  const bs_instance *mover;
+} bs_builtin_collision_query;
+
+typedef bool (*bs_builtin_collision_test)(const bs_game_runner *runner,
+                                          const bs_instance *instance,
+                                          const bs_bbox *bbox,
+                                          const bs_builtin_collision_query *query);
+
+/* The first instance in creation order that matches target (-3 for any), is not skip and passes
+ * test. Only the instances the runner's spatial index returns for query->bounds are examined, so
+ * the cost follows the candidates near the query rather than the instance count. */
+static bs_instance *bs_builtin_first_collision(bs_game_runner *runner,
+                                               int32_t target,
+                                               const bs_instance *skip,
+                                               bs_builtin_collision_test test,
+                                               const bs_builtin_collision_query *query) {
+  const uint32_t *slots = NULL;
+  size_t count = 0;
+  bs_instance *best = NULL;
+  uint64_t best_sequence = UINT64_MAX;
+
+  slots = bs_game_runner_query_instances(runner, &query->bounds, &count);
+  for (size_t i = 0; i < count; i++) {
+    bs_instance *inst = bs_instance_pool_at(&runner->instance_pool, slots[i]);
     bs_bbox bbox = {0};
-    if (!bs_builtin_instance_matches_target(vm->runner, inst, target)) {
+    if (!runner->instance_pool.motion.active[slots[i]] ||
+        inst == skip ||
+        bs_instance_sequence(inst) >= best_sequence) {
       continue;
     }
-    if (notme && inst->id == self_id) {
+    if (target != -3 && !bs_builtin_instance_matches_target(runner, inst, target)) {
       continue;
     }
-    if (!bs_game_runner_compute_instance_bbox(vm->runner, inst, &bbox)) {
+    if (!bs_game_runner_compute_instance_bbox(runner, inst, &bbox) || !test(runner, inst, &bbox, query)) {
       continue;
     }
-    if (px >= bbox.left && px < bbox.right && py >= bbox.top && py < bbox.bottom) {
-      return bs_vm_make_number((double)inst->id);
+    best = inst;
+    best_sequence = bs_instance_sequence(inst);
+  }
+  return best;
+}
+
+static bs_vm_value bs_builtin_collision_result(const bs_instance *instance) {
+  return bs_vm_make_number((instance != NULL) ? (double)instance->id : -4.0);
+}
+
+static bool bs_builtin_point_hits(const bs_game_runner *runner,
+                                  const bs_instance *instance,
+                                  const bs_bbox *bbox,
+                                  const bs_builtin_collision_query *query) {
+  bs_collision_mask mask = {0};
+  const double px = query->x1;
+  const double py = query->y1;
+  if (!(px >= bbox->left && px < bbox->right && py >= bbox->top && py < bbox->bottom)) {
+    return false;
+  }
+  return !(query->precise && bs_game_runner_instance_mask(runner, instance, &mask) &&
+           !bs_collision_mask_covers(&mask, px, py));
+}
+
+static bool bs_builtin_rectangle_hits(const bs_game_runner *runner,
+                                      const bs_instance *instance,
+                                      const bs_bbox *bbox,
+                                      const bs_builtin_collision_query *query) {
+  bs_collision_mask mask = {0};
+  const double ql = query->x1;
+  const double qt = query->y1;
+  const double qr = query->x2;
+  const double qb = query->y2;
+  if (!(ql < bbox->right && qr >= bbox->left && qt < bbox->bottom && qb >= bbox->top)) {
+    return false;
+  }
+  if (query->precise && bs_game_runner_instance_mask(runner, instance, &mask)) {
+    bs_bbox region = {fmax(ql, bbox->left), fmin(qr, bbox->right), fmax(qt, bbox->top), fmin(qb, bbox->bottom)};
+    return bs_collision_mask_hits_rectangle(&mask, &region);
+  }
+  return true;
+}
+
+static bool bs_builtin_circle_hits(const bs_game_runner *runner,
+                                   const bs_instance *instance,
+                                   const bs_bbox *bbox,
+                                   const bs_builtin_collision_query *query) {
+  bs_collision_mask mask = {0};
+  const double cx = query->x1;
+  const double cy = query->y1;
+  const double radius = query->radius;
+  const double nearest_x = fmin(fmax(cx, bbox->left), bbox->right);
+  const double nearest_y = fmin(fmax(cy, bbox->top), bbox->bottom);
+  const double dx = cx - nearest_x;
+  const double dy = cy - nearest_y;
+  if (!((dx * dx) + (dy * dy) <= radius * radius)) {
+    return false;
+  }
+  if (query->precise && bs_game_runner_instance_mask(runner, instance, &mask)) {
+    bs_bbox region = {fmax(cx - radius, bbox->left),
+                      fmin(cx + radius, bbox->right),
+                      fmax(cy - radius, bbox->top),
+                      fmin(cy + radius, bbox->bottom)};
+    return bs_collision_mask_hits_circle(&mask, &region, cx, cy, fabs(radius));
+  }
+  return true;
+}
+
+/* Clips the segment against the box (Liang-Barsky); a precise mask is then walked along the
+ * clipped part only. */
+static bool bs_builtin_line_hits(const bs_game_runner *runner,
+                                 const bs_instance *instance,
+                                 const bs_bbox *bbox,
+                                 const bs_builtin_collision_query *query) {
+  bs_collision_mask mask = {0};
+  const double x1 = query->x1;
+  const double y1 = query->y1;
+  const double dx = query->x2 - x1;
+  const double dy = query->y2 - y1;
+  double t_min = 0.0;
+  double t_max = 1.0;
+  double edges[4];
+  double sides[4];
+
+  edges[0] = -dx;
+  edges[1] = dx;
+  edges[2] = -dy;
+  edges[3] = dy;
+  sides[0] = x1 - bbox->left;
+  sides[1] = bbox->right - x1;
+  sides[2] = y1 - bbox->top;
+  sides[3] = bbox->bottom - y1;
+  for (size_t e = 0; e < 4; e++) {
+    double p = edges[e];
+    double q = sides[e];
+    if (p == 0.0) {
+      if (q < 0.0) {
+        return false;
+      }
+    } else {
+      double t = q / p;
+      if (p < 0.0) {
+        if (t > t_min) {
+          t_min = t;
+        }
+      } else if (t < t_max) {
+        t_max = t;
+      }
+      if (t_min > t_max) {
+        return false;
+      }
     }
   }
 
-  return bs_vm_make_number(-4.0);
+  return !(query->precise && bs_game_runner_instance_mask(runner, instance, &mask) &&
+           !bs_collision_mask_hits_line(&mask,
+                                        x1 + (dx * t_min),
+                                        y1 + (dy * t_min),
+                                        x1 + (dx * t_max),
+                                        y1 + (dy * t_max)));
+}
+
+static bool bs_builtin_place_hits(const bs_game_runner *runner,
+                                  const bs_instance *instance,
+                                  const bs_bbox *bbox,
+                                  const bs_builtin_collision_query *query) {
+  (void)bbox;
+  if (query->solid_only && !instance->solid) {
+    return false;
+  }
+  return bs_game_runner_instance_overlaps_at(runner, query->mover, query->x1, query->y1, instance);
+}
+
+static bs_vm_value bs_builtin_collision_point(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  bs_builtin_collision_query query = {0};
+  int32_t target = (int32_t)bs_builtin_arg_to_number(args, argc, 2, -1.0);
+  bool notme = bs_builtin_arg_to_number(args, argc, 4, 0.0) != 0.0;
+  if (vm == NULL || vm->runner == NULL || argc < 5) {
+    return bs_vm_make_number(-4.0);
+  }
+  query.x1 = bs_builtin_arg_to_number(args, argc, 0, 0.0);
+  query.y1 = bs_builtin_arg_to_number(args, argc, 1, 0.0);
+  query.precise = bs_builtin_arg_to_number(args, argc, 3, 0.0) != 0.0;
+  query.bounds.left = query.x1;
+  query.bounds.right = query.x1;
+  query.bounds.top = query.y1;
+  query.bounds.bottom = query.y1;
+  return bs_builtin_collision_result(bs_builtin_first_collision(vm->runner,
+                                                                target,
+                                                                notme ? bs_builtin_get_self_instance(vm) : NULL,
+                                                                bs_builtin_point_hits,
+                                                                &query));
 }
 
 static bs_vm_value bs_builtin_collision_rectangle(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  bs_builtin_collision_query query = {0};
   double x1 = bs_builtin_arg_to_number(args, argc, 0, 0.0);
   double y1 = bs_builtin_arg_to_number(args, argc, 1, 0.0);
   double x2 = bs_builtin_arg_to_number(args, argc, 2, 0.0);
   double y2 = bs_builtin_arg_to_number(args, argc, 3, 0.0);
   int32_t target = (int32_t)bs_builtin_arg_to_number(args, argc, 4, -1.0);
-  bool precise = bs_builtin_arg_to_number(args, argc, 5, 0.0) != 0.0;
   bool notme = bs_builtin_arg_to_number(args, argc, 6, 0.0) != 0.0;
-  int32_t self_id = -1;
-  double ql = fmin(x1, x2);
-  double qr = fmax(x1, x2);
-  double qt = fmin(y1, y2);
-  double qb = fmax(y1, y2);
-  (void)precise;
   if (vm == NULL || vm->runner == NULL || argc < 7) {
     return bs_vm_make_number(-4.0);
   }
-  self_id = vm->current_self_id;
-
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    bs_instance *inst = &vm->runner->instances[i];
-    bs_bbox bbox = {0};
-    if (!bs_builtin_instance_matches_target(vm->runner, inst, target)) {
-      continue;
-    }
-    if (notme && inst->id == self_id) {
-      continue;
-    }
-    if (!bs_game_runner_compute_instance_bbox(vm->runner, inst, &bbox)) {
-      continue;
-    }
-    if (ql < bbox.right && qr >= bbox.left && qt < bbox.bottom && qb >= bbox.top) {
-      return bs_vm_make_number((double)inst->id);
-    }
-  }
-
-  return bs_vm_make_number(-4.0);
+  query.x1 = fmin(x1, x2);
+  query.y1 = fmin(y1, y2);
+  query.x2 = fmax(x1, x2);
+  query.y2 = fmax(y1, y2);
+  query.precise = bs_builtin_arg_to_number(args, argc, 5, 0.0) != 0.0;
+  query.bounds.left = query.x1;
+  query.bounds.right = query.x2;
+  query.bounds.top = query.y1;
+  query.bounds.bottom = query.y2;
+  return bs_builtin_collision_result(bs_builtin_first_collision(vm->runner,
+                                                                target,
+                                                                notme ? bs_builtin_get_self_instance(vm) : NULL,
+                                                                bs_builtin_rectangle_hits,
+                                                                &query));
 }
 
 static bs_vm_value bs_builtin_collision_circle(bs_vm *vm, const bs_vm_value *args, size_t argc) {
-  double cx = bs_builtin_arg_to_number(args, argc, 0, 0.0);
-  double cy = bs_builtin_arg_to_number(args, argc, 1, 0.0);
-  double radius = bs_builtin_arg_to_number(args, argc, 2, 0.0);
+  bs_builtin_collision_query query = {0};
   int32_t target = (int32_t)bs_builtin_arg_to_number(args, argc, 3, -1.0);
-  bool precise = bs_builtin_arg_to_number(args, argc, 4, 0.0) != 0.0;
   bool notme = bs_builtin_arg_to_number(args, argc, 5, 0.0) != 0.0;
-  int32_t self_id = -1;
-  double radius_sq = radius * radius;
-  (void)precise;
+  double reach = 0.0;
   if (vm == NULL || vm->runner == NULL || argc < 6) {
     return bs_vm_make_number(-4.0);
   }
-  self_id = vm->current_self_id;
-
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    bs_instance *inst = &vm->runner->instances[i];
-    bs_bbox bbox = {0};
-    if (!bs_builtin_instance_matches_target(vm->runner, inst, target)) {
-      continue;
-    }
-    if (notme && inst->id == self_id) {
-      continue;
-    }
-    if (!bs_game_runner_compute_instance_bbox(vm->runner, inst, &bbox)) {
-      continue;
-    }
-
-    {
-      double nearest_x = fmin(fmax(cx, bbox.left), bbox.right);
-      double nearest_y = fmin(fmax(cy, bbox.top), bbox.bottom);
-      double dx = cx - nearest_x;
-      double dy = cy - nearest_y;
-      if ((dx * dx) + (dy * dy) <= radius_sq) {
-        return bs_vm_make_number((double)inst->id);
-      }
-    }
-  }
-
-  return bs_vm_make_number(-4.0);
+  query.x1 = bs_builtin_arg_to_number(args, argc, 0, 0.0);
+  query.y1 = bs_builtin_arg_to_number(args, argc, 1, 0.0);
+  query.radius = bs_builtin_arg_to_number(args, argc, 2, 0.0);
+  query.precise = bs_builtin_arg_to_number(args, argc, 4, 0.0) != 0.0;
+  reach = fabs(query.radius);
+  query.bounds.left = query.x1 - reach;
+  query.bounds.right = query.x1 + reach;
+  query.bounds.top = query.y1 - reach;
+  query.bounds.bottom = query.y1 + reach;
+  return bs_builtin_collision_result(bs_builtin_first_collision(vm->runner,
+                                                                target,
+                                                                notme ? bs_builtin_get_self_instance(vm) : NULL,
+                                                                bs_builtin_circle_hits,
+                                                                &query));
 }
 
 static bs_vm_value bs_builtin_collision_line(bs_vm *vm, const bs_vm_value *args, size_t argc) {
-  double x1 = bs_builtin_arg_to_number(args, argc, 0, 0.0);
-  double y1 = bs_builtin_arg_to_number(args, argc, 1, 0.0);
-  double x2 = bs_builtin_arg_to_number(args, argc, 2, 0.0);
-  double y2 = bs_builtin_arg_to_number(args, argc, 3, 0.0);
+  bs_builtin_collision_query query = {0};
   int32_t target = (int32_t)bs_builtin_arg_to_number(args, argc, 4, -1.0);
-  bool precise = bs_builtin_arg_to_number(args, argc, 5, 0.0) != 0.0;
   bool notme = bs_builtin_arg_to_number(args, argc, 6, 0.0) != 0.0;
-  double dx = x2 - x1;
-  double dy = y2 - y1;
-  int32_t self_id = -1;
-  (void)precise;
   if (vm == NULL || vm->runner == NULL || argc < 7) {
     return bs_vm_make_number(-4.0);
   }
-  self_id = vm->current_self_id;
+  query.x1 = bs_builtin_arg_to_number(args, argc, 0, 0.0);
+  query.y1 = bs_builtin_arg_to_number(args, argc, 1, 0.0);
+  query.x2 = bs_builtin_arg_to_number(args, argc, 2, 0.0);
+  query.y2 = bs_builtin_arg_to_number(args, argc, 3, 0.0);
+  query.precise = bs_builtin_arg_to_number(args, argc, 5, 0.0) != 0.0;
+  query.bounds.left = fmin(query.x1, query.x2);
+  query.bounds.right = fmax(query.x1, query.x2);
+  query.bounds.top = fmin(query.y1, query.y2);
+  query.bounds.bottom = fmax(query.y1, query.y2);
+  return bs_builtin_collision_result(bs_builtin_first_collision(vm->runner,
+                                                                target,
+                                                                notme ? bs_builtin_get_self_instance(vm) : NULL,
+                                                                bs_builtin_line_hits,
+                                                                &query));
+}
+
+/* Shared by the place_* family: the first instance matching target that self would overlap if it
+ * stood at (x, y), using self's own mask and both sides' precise masks. */
+static bs_instance *bs_builtin_place_collision(bs_vm *vm, double x, double y, int32_t target, bool solid_only) {
+  bs_builtin_collision_query query = {0};
+  const bs_instance *self = bs_builtin_get_self_instance(vm);
+  if (self == NULL || !bs_game_runner_instance_bbox_at(vm->runner, self, x, y, &query.bounds)) {
+    return NULL;
+  }
+  query.x1 = x;
+  query.y1 = y;
+  query.solid_only = solid_only;
+  query.mover = self;
+  return bs_builtin_first_collision(vm->runner, target, self, bs_builtin_place_hits, &query);
+}
 
-  for (size_t i = 0; i < vm->runner->instance_count; i++) {
-    bs_instance *inst = &vm->runner->instances[i];
-    bs_bbox bbox = {0};
-    double t_min = 0.0;
-    double t_max = 1.0;
-    double edges[4];
-    double sides[4];
-    bool hit = true;
-    if (!bs_builtin_instance_matches_target(vm->runner, inst, target)) {
-      continue;
-    }
-    if (notme && inst->id == self_id) {
-      continue;
-    }
-    if (!bs_game_runner_compute_instance_bbox(vm->runner, inst, &bbox)) {
-      continue;
-    }
+static bs_vm_value bs_builtin_place_meeting(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  bs_instance *hit = NULL;
+  if (vm == NULL || vm->runner == NULL || argc < 3) {
+    return bs_vm_make_number(0.0);
+  }
+  hit = bs_builtin_place_collision(vm,
+                                   bs_builtin_arg_to_number(args, argc, 0, 0.0),
+                                   bs_builtin_arg_to_number(args, argc, 1, 0.0),
+                                   (int32_t)bs_builtin_arg_to_number(args, argc, 2, -1.0),
+                                   false);
+  return bs_vm_make_number((hit != NULL) ? 1.0 : 0.0);
+}
 
-    edges[0] = -dx;
-    edges[1] = dx;
-    edges[2] = -dy;
-    edges[3] = dy;
-    sides[0] = x1 - bbox.left;
-    sides[1] = bbox.right - x1;
-    sides[2] = y1 - bbox.top;
-    sides[3] = bbox.bottom - y1;
-    for (size_t e = 0; e < 4; e++) {
-      double p = edges[e];
-      double q = sides[e];
-      if (p == 0.0) {
-        if (q < 0.0) {
-          hit = false;
-          break;
-        }
-      } else {
-        double t = q / p;
-        if (p < 0.0) {
-          if (t > t_min) {
-            t_min = t;
-          }
-        } else if (t < t_max) {
-          t_max = t;
-        }
-        if (t_min > t_max) {
-          hit = false;
-          break;
-        }
-      }
-    }
+static bs_vm_value bs_builtin_instance_place(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  if (vm == NULL || vm->runner == NULL || argc < 3) {
+    return bs_vm_make_number(-4.0);
+  }
+  return bs_builtin_collision_result(bs_builtin_place_collision(vm,
+                                                                bs_builtin_arg_to_number(args, argc, 0, 0.0),
+                                                                bs_builtin_arg_to_number(args, argc, 1, 0.0),
+                                                                (int32_t)bs_builtin_arg_to_number(args, argc, 2, -1.0),
+                                                                false));
+}
 
-    if (hit) {
-      return bs_vm_make_number((double)inst->id);
-    }
+static bs_vm_value bs_builtin_place_free(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  bs_instance *hit = NULL;
+  if (vm == NULL || vm->runner == NULL || argc < 2) {
+    return bs_vm_make_number(1.0);
   }
+  hit = bs_builtin_place_collision(vm,
+                                   bs_builtin_arg_to_number(args, argc, 0, 0.0),
+                                   bs_builtin_arg_to_number(args, argc, 1, 0.0),
+                                   -3,
+                                   true);
+  return bs_vm_make_number((hit == NULL) ? 1.0 : 0.0);
+}
 
-  return bs_vm_make_number(-4.0);
+/* place_empty(x, y) checks against every instance; the optional third argument narrows it to an
+ * object or instance, as later runtimes allow. */
+static bs_vm_value bs_builtin_place_empty(bs_vm *vm, const bs_vm_value *args, size_t argc) {
+  bs_instance *hit = NULL;
+  if (vm == NULL || vm->runner == NULL || argc < 2) {
+    return bs_vm_make_number(1.0);
+  }
+  hit = bs_builtin_place_collision(vm,
+                                   bs_builtin_arg_to_number(args, argc, 0, 0.0),
+                                   bs_builtin_arg_to_number(args, argc, 1, 0.0),
+                                   (int32_t)bs_builtin_arg_to_number(args, argc, 2, -3.0),
+                                   false);
+  return bs_vm_make_number((hit == NULL) ? 1.0 : 0.0);
 }
 
 static bs_vm_value bs_builtin_abs_fn(bs_vm *vm, const bs_vm_value *args, size_t argc) {
@@ -2429,8 +2571,8 @@ static bs_vm_value bs_builtin_distance_to_point(bs_vm *vm, const bs_vm_value *ar
   double dy = 0.0;
   
   if (self != NULL) {
-    dx = target_x - self->x;
-    dy = target_y - self->y;
+    dx = target_x - BS_MOTION(self, x);
+    dy = target_y - BS_MOTION(self, y);
     return bs_vm_make_number(sqrt((dx * dx) + (dy * dy)));
   }
   
@@ -2445,16 +2587,16 @@ static bs_vm_value bs_builtin_move_towards_point(bs_vm *vm, const bs_vm_value *a
   const double pi = 3.14159265358979323846;
   
   if (self != NULL) {
-    double dx = target_x - self->x;
-    double dy = target_y - self->y;
+    double dx = target_x - BS_MOTION(self, x);
+    double dy = target_y - BS_MOTION(self, y);
     double distance = sqrt((dx * dx) + (dy * dy));
     
     if (distance > 0.0) {
       double direction = fmod((atan2(-dy, dx) * (180.0 / pi)) + 360.0, 360.0);
-      self->direction = direction;
-      self->speed = (distance < speed) ? distance : speed;
-      self->hspeed = self->speed * cos(direction * (pi / 180.0));
-      self->vspeed = -self->speed * sin(direction * (pi / 180.0));
+      BS_MOTION(self, direction) = direction;
+      BS_MOTION(self, speed) = (distance < speed) ? distance : speed;
+      BS_MOTION(self, hspeed) = BS_MOTION(self, speed) * cos(direction * (pi / 180.0));
+      BS_MOTION(self, vspeed) = -BS_MOTION(self, speed) * sin(direction * (pi / 180.0));
     }
   }
   
@@ -2525,13 +2667,13 @@ static bs_vm_value bs_builtin_action_move(bs_vm *vm, const bs_vm_value *args, si
   
   /* Set instance velocity */
   if (total_dirs > 0) {
-    self->hspeed = total_hspeed;
-    self->vspeed = total_vspeed;
-    self->speed = sqrt(total_hspeed * total_hspeed + total_vspeed * total_vspeed);
-    if (self->speed > 0.0) {
-      self->direction = atan2(-total_vspeed, total_hspeed) * (180.0 / pi);
-      if (self->direction < 0.0) {
-        self->direction += 360.0;
+    BS_MOTION(self, hspeed) = total_hspeed;
+    BS_MOTION(self, vspeed) = total_vspeed;
+    BS_MOTION(self, speed) = sqrt(total_hspeed * total_hspeed + total_vspeed * total_vspeed);
+    if (BS_MOTION(self, speed) > 0.0) {
+      BS_MOTION(self, direction) = atan2(-total_vspeed, total_hspeed) * (180.0 / pi);
+      if (BS_MOTION(self, direction) < 0.0) {
+        BS_MOTION(self, direction) += 360.0;
       }
     }
   }
@@ -2544,7 +2686,7 @@ static bs_vm_value bs_builtin_action_set_friction(bs_vm *vm, const bs_vm_value *
   bs_instance *self = bs_builtin_get_self_instance(vm);
   
   if (self != NULL) {
-    self->friction = friction;
+    BS_MOTION(self, friction) = friction;
   }
   
   return bs_vm_make_number(0.0);
@@ -2659,10 +2801,7 @@ static bs_vm_value bs_builtin_max(bs_vm *vm, const bs_vm_value *args, size_t arg
   return bs_vm_make_number(a > b ? a : b);
 }
 
-void bs_register_builtins(bs_vm *vm) {
-  if (vm == NULL) {
-    return;
-  }
+static void bs_register_builtin_table(bs_vm *vm) {
 
   (void)bs_vm_register_builtin(vm, "show_debug_message", bs_builtin_show_debug_message);
   (void)bs_vm_register_builtin(vm, "room_goto", bs_builtin_room_goto);
@@ -2783,6 +2922,10 @@ void bs_register_builtins(bs_vm *vm) {
   (void)bs_vm_register_builtin(vm, "collision_rectangle", bs_builtin_collision_rectangle);
   (void)bs_vm_register_builtin(vm, "collision_circle", bs_builtin_collision_circle);
   (void)bs_vm_register_builtin(vm, "collision_line", bs_builtin_collision_line);
+  (void)bs_vm_register_builtin(vm, "place_meeting", bs_builtin_place_meeting);
+  (void)bs_vm_register_builtin(vm, "place_free", bs_builtin_place_free);
+  (void)bs_vm_register_builtin(vm, "place_empty", bs_builtin_place_empty);
+  (void)bs_vm_register_builtin(vm, "instance_place", bs_builtin_instance_place);
   (void)bs_vm_register_builtin(vm, "room_exists", bs_builtin_room_exists);
   (void)bs_vm_register_builtin(vm, "room_next", bs_builtin_room_next);
   (void)bs_vm_register_builtin(vm, "room_previous", bs_builtin_room_previous);
@@ -2822,6 +2965,36 @@ void bs_register_builtins(bs_vm *vm) {
   (void)bs_vm_register_builtin(vm, "draw_background_ext", bs_builtin_draw_background_ext);
   (void)bs_vm_register_builtin(vm, "surface_get_width", bs_builtin_surface_get_width);
   (void)bs_vm_register_builtin(vm, "surface_get_height", bs_builtin_surface_get_height);
+}
+
+void bs_register_builtins(bs_vm *vm) {
+  size_t count_before = 0;
+  size_t capacity_before = 0;
+  double start_millis = 0.0;
+  bs_load_phase *phase = NULL;
+
+  if (vm == NULL) {
+    return;
+  }
+
+  count_before = vm->builtin_count;
+  capacity_before = vm->builtin_capacity;
+  start_millis = bs_builtin_now_millis();
+  bs_register_builtin_table(vm);
+  phase = bs_load_stats_add(&vm->load_stats, "vm", "register_builtins", bs_builtin_now_millis() - start_millis);
+  if (phase != NULL) {
+    phase->items = vm->builtin_count - count_before;
+    phase->allocations = phase->items;
+    for (size_t i = count_before; i < vm->builtin_count; i++) {
+      phase->bytes += strlen(vm->builtin_names[i]) + 1u;
+    }
+    /* Each capacity doubling replaces the name and callback arrays. */
+    for (size_t capacity = capacity_before; capacity < vm->builtin_capacity;
+         capacity = (capacity == 0) ? 64u : (capacity * 2u)) {
+      phase->allocations += 2u;
+    }
+    phase->bytes += (vm->builtin_capacity - capacity_before) * (sizeof(char *) + sizeof(bs_vm_builtin_callback));
+  }
 
   printf("Builtins registered: runtime core + bootstrap stubs\n");
 }
@@ -1,9 +1,21 @@
+#if defined(BS_HAVE_PTHREADS)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "bs/data/form_reader.h"
 
+#include "bs/platform/system.h"
+#include "data/form_reader_internal.h"
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(BS_HAVE_PTHREADS)
+#include <pthread.h>
+#endif
 
 static bool can_read_range(size_t file_size, uint32_t offset, size_t need) {
   if ((size_t)offset > file_size) {
@@ -70,12 +82,104 @@ static bool read_tag(const bs_game_data *data, uint32_t offset, char out_tag[5])
   return true;
 }
 
-static char *dup_bytes_as_string(const uint8_t *bytes, size_t len) {
-  if (bytes == NULL) {
+#define BS_ARENA_BLOCK_SIZE (64u * 1024u)
+#define BS_ARENA_MIN_BLOCK_SIZE 1024u
+/* Requests above this get a block of their own instead of ending the current one. */
+#define BS_ARENA_LARGE_SIZE (BS_ARENA_BLOCK_SIZE / 4u)
+
+struct bs_arena_block {
+  bs_arena_block *next;
+  size_t capacity;
+  size_t used;
+  max_align_t bytes[];
+};
+
+static bs_arena_block *arena_new_block(bs_arena *arena, size_t capacity) {
+  bs_arena_block *block = NULL;
+  if (capacity > SIZE_MAX - sizeof(bs_arena_block)) {
+    return NULL;
+  }
+  block = (bs_arena_block *)calloc(1, sizeof(bs_arena_block) + capacity);
+  if (block == NULL) {
+    return NULL;
+  }
+  block->capacity = capacity;
+  arena->reserved_bytes += capacity;
+  arena->block_count++;
+  return block;
+}
+
+/* Bump allocation out of calloc'd blocks, so every allocation comes back zeroed. Large requests that
+ * do not fit the current block get a block of exactly their size, linked behind the current one so
+ * later small requests keep filling it. */
+static void *arena_alloc(bs_arena *arena, size_t size, size_t align) {
+  bs_arena_block *block = arena->head;
+  size_t offset = 0;
+
+  if (size == 0) {
+    size = 1;
+  }
+  if (block != NULL) {
+    offset = (block->used + (align - 1u)) & ~(align - 1u);
+  }
+  if (block == NULL || offset > block->capacity || size > block->capacity - offset) {
+    if (size > BS_ARENA_LARGE_SIZE) {
+      block = arena_new_block(arena, size);
+      if (block == NULL) {
+        return NULL;
+      }
+      if (arena->head != NULL) {
+        block->next = arena->head->next;
+        arena->head->next = block;
+      } else {
+        arena->head = block;
+      }
+    } else {
+      size_t capacity = (arena->next_block != 0) ? arena->next_block : BS_ARENA_BLOCK_SIZE;
+      block = arena_new_block(arena, (size > capacity) ? size : capacity);
+      if (block == NULL) {
+        return NULL;
+      }
+      block->next = arena->head;
+      arena->head = block;
+      arena->next_block = BS_ARENA_BLOCK_SIZE;
+    }
+    offset = 0;
+  }
+
+  block->used = offset + size;
+  arena->used_bytes += size;
+  arena->allocation_count++;
+  return (unsigned char *)block->bytes + offset;
+}
+
+static void *arena_calloc(bs_arena *arena, size_t count, size_t size) {
+  if (size != 0 && count > SIZE_MAX / size) {
+    return NULL;
+  }
+  return arena_alloc(arena, count * size, _Alignof(max_align_t));
+}
+
+static void arena_release(bs_arena *arena) {
+  bs_arena_block *block = arena->head;
+  while (block != NULL) {
+    bs_arena_block *next = block->next;
+    free(block);
+    block = next;
+  }
+  arena->head = NULL;
+  arena->used_bytes = 0;
+  arena->reserved_bytes = 0;
+  arena->block_count = 0;
+  arena->allocation_count = 0;
+}
+
+static char *dup_bytes_as_string(bs_arena *arena, const uint8_t *bytes, size_t len) {
+  if (bytes == NULL || len == SIZE_MAX) {
     return NULL;
   }
 
-  char *s = (char *)malloc(len + 1);
+  char *s = (char *)arena_alloc(arena, len + 1, 1);
   if (s == NULL) {
     return NULL;
   }
@@ -87,7 +191,7 @@ static char *dup_bytes_as_string(const uint8_t *bytes, size_t len) {
   return s;
 }
 
-static char *read_string_at(const bs_game_data *data, uint32_t offset) {
+static char *read_string_at(const bs_game_data *data, bs_arena *arena, uint32_t offset) {
   uint32_t len = 0;
   if (!read_u32_le(data, offset, &len)) {
     return NULL;
@@ -96,12 +200,12 @@ static char *read_string_at(const bs_game_data *data, uint32_t offset) {
     return NULL;
   }
 
-  return dup_bytes_as_string(&data->file_data[offset + 4], (size_t)len);
+  return dup_bytes_as_string(arena, &data->file_data[offset + 4], (size_t)len);
 }
 
-static char *read_string_ref(const bs_game_data *data, uint32_t ptr) {
+static char *read_string_ref(const bs_game_data *data, bs_arena *arena, uint32_t ptr) {
   if (ptr == 0) {
-    return dup_bytes_as_string((const uint8_t *)"", 0);
+    return dup_bytes_as_string(arena, (const uint8_t *)"", 0);
   }
   if (ptr < 4) {
     return NULL;
@@ -115,7 +219,7 @@ static char *read_string_ref(const bs_game_data *data, uint32_t ptr) {
     return NULL;
   }
 
-  return dup_bytes_as_string(&data->file_data[ptr], (size_t)len);
+  return dup_bytes_as_string(arena, &data->file_data[ptr], (size_t)len);
 }
 
 static const bs_chunk_info *find_chunk(const bs_game_data *data, const char *tag) {
@@ -181,6 +285,38 @@ static bool load_file_bytes(const char *path, uint8_t **out_bytes, size_t *out_s
   return true;
 }
 
+static bool mmap_disabled_by_env(void) {
+  const char *env = getenv("BS_DISABLE_MMAP");
+  return env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0);
+}
+
+/* Maps data.win read-only when the platform allows it; bytecode and TXTR/AUDO payloads are then
+ * views into the page cache. Falls back to reading the whole file into memory. */
+static bool open_game_file(const char *path, bs_game_data *data) {
+  uint8_t *bytes = NULL;
+  size_t size = 0;
+
+  if (!mmap_disabled_by_env()) {
+    bs_file_view view;
+    if (bs_system_map_file(path, &view)) {
+      data->file_data = view.bytes;
+      data->file_size = view.size;
+      data->file_mapping = view.mapping;
+      data->file_mapped = true;
+      return true;
+    }
+  }
+  if (!load_file_bytes(path, &bytes, &size)) {
+    return false;
+  }
+
+  data->file_data = bytes;
+  data->file_size = size;
+  data->file_mapping = NULL;
+  data->file_mapped = false;
+  return true;
+}
+
 static bool discover_chunks(bs_game_data *data) {
   char form_tag[5];
   if (!read_tag(data, 0, form_tag)) {
@@ -266,7 +402,8 @@ static void print_chunk_list(const bs_game_data *data) {
   printf("\n");
 }
 
-static bool parse_strg(bs_game_data *data) {
+static bool parse_strg(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_STRG];
   const bs_chunk_info *chunk = find_chunk(data, "STRG");
   if (chunk == NULL) {
     return false;
@@ -284,7 +421,7 @@ static bool parse_strg(bs_game_data *data) {
 
   char **strings = NULL;
   if (count > 0) {
-    strings = (char **)calloc(count, sizeof(char *));
+    strings = (char **)arena_calloc(arena, count, sizeof(char *));
     if (strings == NULL) {
       return false;
     }
@@ -293,30 +430,23 @@ static bool parse_strg(bs_game_data *data) {
   for (size_t i = 0; i < count; i++) {
     uint32_t ptr = 0;
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr)) {
-      for (size_t j = 0; j < i; j++) {
-        free(strings[j]);
-      }
-      free(strings);
       return false;
     }
 
-    strings[i] = read_string_at(data, ptr);
+    strings[i] = read_string_at(data, arena, ptr);
     if (strings[i] == NULL) {
-      for (size_t j = 0; j < i; j++) {
-        free(strings[j]);
-      }
-      free(strings);
       return false;
     }
   }
 
   data->strings = strings;
   data->string_count = count;
-  printf("  STRG: %u strings\n", count_u32);
+  (void)snprintf(summary, summary_size, "  STRG: %u strings\n", count_u32);
   return true;
 }
 
-static bool parse_gen8(bs_game_data *data) {
+static bool parse_gen8(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_GEN8];
   const bs_chunk_info *chunk = find_chunk(data, "GEN8");
   if (chunk == NULL) {
     return false;
@@ -348,7 +478,7 @@ static bool parse_gen8(bs_game_data *data) {
 
   uint32_t *room_order = NULL;
   if (room_order_count > 0) {
-    room_order = (uint32_t *)calloc(room_order_count, sizeof(uint32_t));
+    room_order = (uint32_t *)arena_calloc(arena, room_order_count, sizeof(uint32_t));
     if (room_order == NULL) {
       return false;
     }
@@ -356,17 +486,13 @@ static bool parse_gen8(bs_game_data *data) {
 
   for (size_t i = 0; i < room_order_count; i++) {
     if (!read_u32_le(data, d + 0x84 + (uint32_t)(i * 4), &room_order[i])) {
-      free(room_order);
       return false;
     }
   }
 
-  char *game_name = read_string_ref(data, game_name_ptr);
-  char *display_name = read_string_ref(data, display_name_ptr);
+  char *game_name = read_string_ref(data, arena, game_name_ptr);
+  char *display_name = read_string_ref(data, arena, display_name_ptr);
   if (game_name == NULL || display_name == NULL) {
-    free(game_name);
-    free(display_name);
-    free(room_order);
     return false;
   }
 
@@ -379,16 +505,17 @@ static bool parse_gen8(bs_game_data *data) {
   data->gen8.room_order = room_order;
   data->gen8.room_order_count = room_order_count;
 
-  printf("  GEN8: '%s' BC%u %ux%u %zu rooms\n",
-         data->gen8.game_name,
-         (unsigned)data->gen8.bytecode_version,
-         data->gen8.window_width,
-         data->gen8.window_height,
-         data->gen8.room_order_count);
+  (void)snprintf(summary, summary_size, "  GEN8: '%s' BC%u %ux%u %zu rooms\n",
+                 data->gen8.game_name,
+                 (unsigned)data->gen8.bytecode_version,
+                 data->gen8.window_width,
+                 data->gen8.window_height,
+                 data->gen8.room_order_count);
   return true;
 }
 
-static bool parse_tpag(bs_game_data *data) {
+static bool parse_tpag(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_TPAG];
   const bs_chunk_info *chunk = find_chunk(data, "TPAG");
   if (chunk == NULL) {
     return false;
@@ -407,11 +534,9 @@ static bool parse_tpag(bs_game_data *data) {
   bs_texture_page_item_data *items = NULL;
   uint32_t *offsets = NULL;
   if (count > 0) {
-    items = (bs_texture_page_item_data *)calloc(count, sizeof(bs_texture_page_item_data));
-    offsets = (uint32_t *)calloc(count, sizeof(uint32_t));
+    items = (bs_texture_page_item_data *)arena_calloc(arena, count, sizeof(bs_texture_page_item_data));
+    offsets = (uint32_t *)arena_calloc(arena, count, sizeof(uint32_t));
     if (items == NULL || offsets == NULL) {
-      free(items);
-      free(offsets);
       return false;
     }
   }
@@ -419,45 +544,44 @@ static bool parse_tpag(bs_game_data *data) {
   for (size_t i = 0; i < count; i++) {
     uint32_t ptr = 0;
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr)) {
-      free(items);
-      free(offsets);
       return false;
     }
     offsets[i] = ptr;
 
     uint16_t v16 = 0;
-    if (!read_u16_le(data, ptr + 0, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 0, &v16)) { return false; }
     items[i].source_x = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 2, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 2, &v16)) { return false; }
     items[i].source_y = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 4, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 4, &v16)) { return false; }
     items[i].source_width = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 6, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 6, &v16)) { return false; }
     items[i].source_height = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 8, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 8, &v16)) { return false; }
     items[i].target_x = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 10, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 10, &v16)) { return false; }
     items[i].target_y = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 12, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 12, &v16)) { return false; }
     items[i].target_width = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 14, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 14, &v16)) { return false; }
     items[i].target_height = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 16, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 16, &v16)) { return false; }
     items[i].bounding_width = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 18, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 18, &v16)) { return false; }
     items[i].bounding_height = (uint32_t)v16;
-    if (!read_u16_le(data, ptr + 20, &v16)) { free(items); free(offsets); return false; }
+    if (!read_u16_le(data, ptr + 20, &v16)) { return false; }
     items[i].texture_page_id = (uint32_t)v16;
   }
 
   data->texture_page_items = items;
   data->texture_page_item_offsets = offsets;
   data->texture_page_item_count = count;
-  printf("  TPAG: %u items\n", count_u32);
+  (void)snprintf(summary, summary_size, "  TPAG: %u items\n", count_u32);
   return true;
 }
 
-static bool parse_txtr(bs_game_data *data) {
+static bool parse_txtr(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_TXTR];
   const bs_chunk_info *chunk = find_chunk(data, "TXTR");
   if (chunk == NULL) {
     return false;
@@ -474,47 +598,36 @@ static bool parse_txtr(bs_game_data *data) {
   }
 
   bs_texture_page_data *pages = NULL;
-  uint32_t *offsets = NULL;
   if (count > 0) {
-    pages = (bs_texture_page_data *)calloc(count, sizeof(bs_texture_page_data));
-    offsets = (uint32_t *)calloc(count, sizeof(uint32_t));
-    if (pages == NULL || offsets == NULL) {
-      free(pages);
-      free(offsets);
+    pages = (bs_texture_page_data *)arena_calloc(arena, count, sizeof(bs_texture_page_data));
+    if (pages == NULL) {
       return false;
     }
   }
 
+  /* png_offset holds the raw start offsets until the lengths are derived below. */
   for (size_t i = 0; i < count; i++) {
     uint32_t ptr = 0;
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr)) {
-      free(pages);
-      free(offsets);
       return false;
     }
-    if (!read_u32_le(data, ptr + 4, &offsets[i])) {
-      free(pages);
-      free(offsets);
+    if (!read_u32_le(data, ptr + 4, &pages[i].png_offset)) {
       return false;
     }
   }
 
   for (size_t i = 0; i < count; i++) {
-    uint32_t png_offset = offsets[i];
-    uint32_t png_end = (i + 1 < count) ? offsets[i + 1] : (chunk->data_offset + chunk->size);
+    uint32_t png_offset = pages[i].png_offset;
+    uint32_t png_end = (i + 1 < count) ? pages[i + 1].png_offset : (chunk->data_offset + chunk->size);
     if (png_end < png_offset) {
-      free(pages);
-      free(offsets);
       return false;
     }
-    pages[i].png_offset = png_offset;
     pages[i].png_length = png_end - png_offset;
   }
 
-  free(offsets);
   data->texture_pages = pages;
   data->texture_page_count = count;
-  printf("  TXTR: %u texture pages\n", count_u32);
+  (void)snprintf(summary, summary_size, "  TXTR: %u texture pages\n", count_u32);
   return true;
 }
 
@@ -530,145 +643,8 @@ static int32_t resolve_tpag_index_by_offset(const bs_game_data *data, uint32_t r
   return -1;
 }
 
-static bool parse_sprt(bs_game_data *data) {
-  const bs_chunk_info *chunk = find_chunk(data, "SPRT");
-  if (chunk == NULL) {
-    data->sprites = NULL;
-    data->sprite_count = 0;
-    return true;
-  }
-
-  uint32_t count_u32 = 0;
-  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
-    return false;
-  }
-  size_t count = (size_t)count_u32;
-  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
-    return false;
-  }
-
-  bs_sprite_data *sprites = NULL;
-  if (count > 0) {
-    sprites = (bs_sprite_data *)calloc(count, sizeof(bs_sprite_data));
-    if (sprites == NULL) {
-      return false;
-    }
-  }
-
-  for (size_t i = 0; i < count; i++) {
-    uint32_t ptr = 0;
-    uint32_t name_ptr = 0;
-    int32_t width = 0;
-    int32_t height = 0;
-    int32_t margin_left = 0;
-    int32_t margin_right = 0;
-    int32_t margin_bottom = 0;
-    int32_t margin_top = 0;
-    int32_t collision_mask_type = 0;
-    int32_t origin_x = 0;
-    int32_t origin_y = 0;
-    int32_t subimage_count_i32 = 0;
-    size_t subimage_count = 0;
-    int32_t *tpag_indices = NULL;
-    char *name = NULL;
-
-    if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
-        !read_u32_le(data, ptr + 0, &name_ptr) ||
-        !read_i32_le(data, ptr + 4, &width) ||
-        !read_i32_le(data, ptr + 8, &height) ||
-        !read_i32_le(data, ptr + 0x0C, &margin_left) ||
-        !read_i32_le(data, ptr + 0x10, &margin_right) ||
-        !read_i32_le(data, ptr + 0x14, &margin_bottom) ||
-        !read_i32_le(data, ptr + 0x18, &margin_top) ||
-        !read_i32_le(data, ptr + 0x2C, &collision_mask_type) ||
-        !read_i32_le(data, ptr + 0x30, &origin_x) ||
-        !read_i32_le(data, ptr + 0x34, &origin_y) ||
-        !read_i32_le(data, ptr + 0x38, &subimage_count_i32)) {
-      for (size_t j = 0; j < i; j++) {
-        free(sprites[j].name);
-        free(sprites[j].tpag_indices);
-      }
-      free(sprites);
-      return false;
-    }
-
-    if (subimage_count_i32 < 0) {
-      for (size_t j = 0; j < i; j++) {
-        free(sprites[j].name);
-        free(sprites[j].tpag_indices);
-      }
-      free(sprites);
-      return false;
-    }
-    subimage_count = (size_t)subimage_count_i32;
-
-    if (!can_read_range(data->file_size, ptr + 0x3C, subimage_count * sizeof(uint32_t))) {
-      for (size_t j = 0; j < i; j++) {
-        free(sprites[j].name);
-        free(sprites[j].tpag_indices);
-      }
-      free(sprites);
-      return false;
-    }
-
-    if (subimage_count > 0) {
-      tpag_indices = (int32_t *)calloc(subimage_count, sizeof(int32_t));
-      if (tpag_indices == NULL) {
-        for (size_t j = 0; j < i; j++) {
-          free(sprites[j].name);
-          free(sprites[j].tpag_indices);
-        }
-        free(sprites);
-        return false;
-      }
-    }
-
-    for (size_t frame = 0; frame < subimage_count; frame++) {
-      uint32_t tpag_ptr = 0;
-      if (!read_u32_le(data, ptr + 0x3C + (uint32_t)(frame * 4), &tpag_ptr)) {
-        free(tpag_indices);
-        for (size_t j = 0; j < i; j++) {
-          free(sprites[j].name);
-          free(sprites[j].tpag_indices);
-        }
-        free(sprites);
-        return false;
-      }
-      tpag_indices[frame] = resolve_tpag_index_by_offset(data, tpag_ptr);
-    }
-
-    name = read_string_ref(data, name_ptr);
-    if (name == NULL) {
-      free(tpag_indices);
-      for (size_t j = 0; j < i; j++) {
-        free(sprites[j].name);
-        free(sprites[j].tpag_indices);
-      }
-      free(sprites);
-      return false;
-    }
-
-    sprites[i].name = name;
-    sprites[i].width = width;
-    sprites[i].height = height;
-    sprites[i].margin_left = margin_left;
-    sprites[i].margin_right = margin_right;
-    sprites[i].margin_top = margin_top;
-    sprites[i].margin_bottom = margin_bottom;
-    sprites[i].origin_x = origin_x;
-    sprites[i].origin_y = origin_y;
-    sprites[i].tpag_indices = tpag_indices;
-    sprites[i].subimage_count = subimage_count;
-    sprites[i].collision_mask_type = collision_mask_type;
-  }
-
-  data->sprites = sprites;
-  data->sprite_count = count;
-  printf("  SPRT: %u sprites\n", count_u32);
-  return true;
-}
-
-static bool parse_bgnd(bs_game_data *data) {
+static bool parse_bgnd(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_BGND];
   const bs_chunk_info *chunk = find_chunk(data, "BGND");
   if (chunk == NULL) {
     data->backgrounds = NULL;
@@ -687,7 +663,7 @@ static bool parse_bgnd(bs_game_data *data) {
 
   bs_background_data *backgrounds = NULL;
   if (count > 0) {
-    backgrounds = (bs_background_data *)calloc(count, sizeof(bs_background_data));
+    backgrounds = (bs_background_data *)arena_calloc(arena, count, sizeof(bs_background_data));
     if (backgrounds == NULL) {
       return false;
     }
@@ -700,19 +676,11 @@ static bool parse_bgnd(bs_game_data *data) {
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
         !read_u32_le(data, ptr + 0, &name_ptr) ||
         !read_u32_le(data, ptr + 0x10, &tpag_ptr)) {
-      for (size_t j = 0; j < i; j++) {
-        free(backgrounds[j].name);
-      }
-      free(backgrounds);
       return false;
     }
 
-    backgrounds[i].name = read_string_ref(data, name_ptr);
+    backgrounds[i].name = read_string_ref(data, arena, name_ptr);
     if (backgrounds[i].name == NULL) {
-      for (size_t j = 0; j <= i; j++) {
-        free(backgrounds[j].name);
-      }
-      free(backgrounds);
       return false;
     }
     backgrounds[i].tpag_index = resolve_tpag_index_by_offset(data, tpag_ptr);
@@ -720,251 +688,12 @@ static bool parse_bgnd(bs_game_data *data) {
 
   data->backgrounds = backgrounds;
   data->background_count = count;
-  printf("  BGND: %u backgrounds\n", count_u32);
-  return true;
-}
-
-static bool parse_path(bs_game_data *data) {
-  const bs_chunk_info *chunk = find_chunk(data, "PATH");
-  if (chunk == NULL) {
-    data->paths = NULL;
-    data->path_count = 0;
-    return true;
-  }
-
-  uint32_t count_u32 = 0;
-  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
-    return false;
-  }
-  size_t count = (size_t)count_u32;
-  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
-    return false;
-  }
-
-  bs_path_data *paths = NULL;
-  if (count > 0) {
-    paths = (bs_path_data *)calloc(count, sizeof(bs_path_data));
-    if (paths == NULL) {
-      return false;
-    }
-  }
-
-  for (size_t i = 0; i < count; i++) {
-    uint32_t ptr = 0;
-    uint32_t name_ptr = 0;
-    uint32_t is_smooth_u32 = 0;
-    uint32_t is_closed_u32 = 0;
-    int32_t precision = 0;
-    uint32_t point_count_u32 = 0;
-    bs_path_point_data *points = NULL;
-    char *name = NULL;
-
-    if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
-        !read_u32_le(data, ptr + 0, &name_ptr) ||
-        !read_u32_le(data, ptr + 4, &is_smooth_u32) ||
-        !read_u32_le(data, ptr + 8, &is_closed_u32) ||
-        !read_i32_le(data, ptr + 12, &precision) ||
-        !read_u32_le(data, ptr + 16, &point_count_u32)) {
-      for (size_t j = 0; j < i; j++) {
-        free(paths[j].name);
-        free(paths[j].points);
-      }
-      free(paths);
-      return false;
-    }
-
-    if (!can_read_range(data->file_size, ptr + 20, (size_t)point_count_u32 * 12u)) {
-      for (size_t j = 0; j < i; j++) {
-        free(paths[j].name);
-        free(paths[j].points);
-      }
-      free(paths);
-      return false;
-    }
-
-    if (point_count_u32 > 0) {
-      points = (bs_path_point_data *)calloc((size_t)point_count_u32, sizeof(bs_path_point_data));
-      if (points == NULL) {
-        for (size_t j = 0; j < i; j++) {
-          free(paths[j].name);
-          free(paths[j].points);
-        }
-        free(paths);
-        return false;
-      }
-    }
-
-    for (size_t p = 0; p < (size_t)point_count_u32; p++) {
-      uint32_t point_offset = ptr + 20 + (uint32_t)(p * 12u);
-      if (!read_f32_le(data, point_offset + 0, &points[p].x) ||
-          !read_f32_le(data, point_offset + 4, &points[p].y) ||
-          !read_f32_le(data, point_offset + 8, &points[p].speed)) {
-        free(points);
-        for (size_t j = 0; j < i; j++) {
-          free(paths[j].name);
-          free(paths[j].points);
-        }
-        free(paths);
-        return false;
-      }
-    }
-
-    name = read_string_ref(data, name_ptr);
-    if (name == NULL) {
-      free(points);
-      for (size_t j = 0; j < i; j++) {
-        free(paths[j].name);
-        free(paths[j].points);
-      }
-      free(paths);
-      return false;
-    }
-
-    paths[i].name = name;
-    paths[i].is_smooth = (is_smooth_u32 != 0);
-    paths[i].is_closed = (is_closed_u32 != 0);
-    paths[i].precision = precision;
-    paths[i].points = points;
-    paths[i].point_count = (size_t)point_count_u32;
-  }
-
-  data->paths = paths;
-  data->path_count = count;
-  printf("  PATH: %u paths\n", count_u32);
-  return true;
-}
-
-static bool parse_font(bs_game_data *data) {
-  const bs_chunk_info *chunk = find_chunk(data, "FONT");
-  if (chunk == NULL) {
-    data->fonts = NULL;
-    data->font_count = 0;
-    return true;
-  }
-
-  uint32_t count_u32 = 0;
-  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
-    return false;
-  }
-  size_t count = (size_t)count_u32;
-  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
-    return false;
-  }
-
-  bs_font_data *fonts = NULL;
-  if (count > 0) {
-    fonts = (bs_font_data *)calloc(count, sizeof(bs_font_data));
-    if (fonts == NULL) {
-      return false;
-    }
-  }
-
-  for (size_t i = 0; i < count; i++) {
-    uint32_t ptr = 0;
-    uint32_t name_ptr = 0;
-    uint32_t display_name_ptr = 0;
-    int32_t em_size = 0;
-    uint32_t tpag_ptr = 0;
-    float scale_x = 1.0f;
-    float scale_y = 1.0f;
-    uint32_t glyph_count_u32 = 0;
-    bs_font_glyph_data *glyphs = NULL;
-    char *name = NULL;
-    char *display_name = NULL;
-
-    if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
-        !read_u32_le(data, ptr + 0, &name_ptr) ||
-        !read_u32_le(data, ptr + 4, &display_name_ptr) ||
-        !read_i32_le(data, ptr + 8, &em_size) ||
-        !read_u32_le(data, ptr + 28, &tpag_ptr) ||
-        !read_f32_le(data, ptr + 32, &scale_x) ||
-        !read_f32_le(data, ptr + 36, &scale_y) ||
-        !read_u32_le(data, ptr + 40, &glyph_count_u32)) {
-      for (size_t j = 0; j < i; j++) {
-        free(fonts[j].name);
-        free(fonts[j].display_name);
-        free(fonts[j].glyphs);
-      }
-      free(fonts);
-      return false;
-    }
-
-    if (!can_read_range(data->file_size, ptr + 44, (size_t)glyph_count_u32 * sizeof(uint32_t))) {
-      for (size_t j = 0; j < i; j++) {
-        free(fonts[j].name);
-        free(fonts[j].display_name);
-        free(fonts[j].glyphs);
-      }
-      free(fonts);
-      return false;
-    }
-
-    if (glyph_count_u32 > 0) {
-      glyphs = (bs_font_glyph_data *)calloc((size_t)glyph_count_u32, sizeof(bs_font_glyph_data));
-      if (glyphs == NULL) {
-        for (size_t j = 0; j < i; j++) {
-          free(fonts[j].name);
-          free(fonts[j].display_name);
-          free(fonts[j].glyphs);
-        }
-        free(fonts);
-        return false;
-      }
-    }
-
-    for (size_t g = 0; g < (size_t)glyph_count_u32; g++) {
-      uint32_t glyph_ptr = 0;
-      if (!read_u32_le(data, ptr + 44 + (uint32_t)(g * 4), &glyph_ptr) ||
-          !read_u16_le(data, glyph_ptr + 0, &glyphs[g].character) ||
-          !read_u16_le(data, glyph_ptr + 2, &glyphs[g].x) ||
-          !read_u16_le(data, glyph_ptr + 4, &glyphs[g].y) ||
-          !read_u16_le(data, glyph_ptr + 6, &glyphs[g].width) ||
-          !read_u16_le(data, glyph_ptr + 8, &glyphs[g].height) ||
-          !read_u16_le(data, glyph_ptr + 10, &glyphs[g].shift) ||
-          !read_u16_le(data, glyph_ptr + 12, &glyphs[g].offset)) {
-        free(glyphs);
-        for (size_t j = 0; j < i; j++) {
-          free(fonts[j].name);
-          free(fonts[j].display_name);
-          free(fonts[j].glyphs);
-        }
-        free(fonts);
-        return false;
-      }
-    }
-
-    name = read_string_ref(data, name_ptr);
-    display_name = read_string_ref(data, display_name_ptr);
-    if (name == NULL || display_name == NULL) {
-      free(name);
-      free(display_name);
-      free(glyphs);
-      for (size_t j = 0; j < i; j++) {
-        free(fonts[j].name);
-        free(fonts[j].display_name);
-        free(fonts[j].glyphs);
-      }
-      free(fonts);
-      return false;
-    }
-
-    fonts[i].name = name;
-    fonts[i].display_name = display_name;
-    fonts[i].em_size = em_size;
-    fonts[i].tpag_index = resolve_tpag_index_by_offset(data, tpag_ptr);
-    fonts[i].scale_x = scale_x;
-    fonts[i].scale_y = scale_y;
-    fonts[i].glyphs = glyphs;
-    fonts[i].glyph_count = (size_t)glyph_count_u32;
-  }
-
-  data->fonts = fonts;
-  data->font_count = count;
-  printf("  FONT: %u fonts\n", count_u32);
+  (void)snprintf(summary, summary_size, "  BGND: %u backgrounds\n", count_u32);
   return true;
 }
 
-static bool parse_code(bs_game_data *data) {
+static bool parse_code(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_CODE];
   const bs_chunk_info *chunk = find_chunk(data, "CODE");
   if (chunk == NULL) {
     return false;
@@ -982,7 +711,7 @@ static bool parse_code(bs_game_data *data) {
 
   bs_code_entry_data *entries = NULL;
   if (count > 0) {
-    entries = (bs_code_entry_data *)calloc(count, sizeof(bs_code_entry_data));
+    entries = (bs_code_entry_data *)arena_calloc(arena, count, sizeof(bs_code_entry_data));
     if (entries == NULL) {
       return false;
     }
@@ -991,7 +720,6 @@ static bool parse_code(bs_game_data *data) {
   for (size_t i = 0; i < count; i++) {
     uint32_t ptr = 0;
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr)) {
-      free(entries);
       return false;
     }
 
@@ -1005,58 +733,25 @@ static bool parse_code(bs_game_data *data) {
         !read_u16_le(data, ptr + 8, &locals_count) ||
         !read_u16_le(data, ptr + 10, &args_count_raw) ||
         !read_i32_le(data, ptr + 12, &relative_offset)) {
-      for (size_t j = 0; j < i; j++) {
-        free(entries[j].name);
-        free(entries[j].bytecode);
-      }
-      free(entries);
       return false;
     }
 
     int64_t bytecode_addr_i64 = (int64_t)ptr + 12ll + (int64_t)relative_offset;
     if (bytecode_addr_i64 < 0 || (uint64_t)bytecode_addr_i64 > (uint64_t)data->file_size) {
-      for (size_t j = 0; j < i; j++) {
-        free(entries[j].name);
-        free(entries[j].bytecode);
-      }
-      free(entries);
       return false;
     }
 
     uint32_t bytecode_addr = (uint32_t)bytecode_addr_i64;
     if (!can_read_range(data->file_size, bytecode_addr, (size_t)length)) {
-      for (size_t j = 0; j < i; j++) {
-        free(entries[j].name);
-        free(entries[j].bytecode);
-      }
-      free(entries);
       return false;
     }
 
-    char *name = read_string_ref(data, name_ptr);
+    char *name = read_string_ref(data, arena, name_ptr);
     if (name == NULL) {
-      for (size_t j = 0; j < i; j++) {
-        free(entries[j].name);
-        free(entries[j].bytecode);
-      }
-      free(entries);
       return false;
     }
 
-    uint8_t *bytecode = NULL;
-    if (length > 0) {
-      bytecode = (uint8_t *)malloc((size_t)length);
-      if (bytecode == NULL) {
-        free(name);
-        for (size_t j = 0; j < i; j++) {
-          free(entries[j].name);
-          free(entries[j].bytecode);
-        }
-        free(entries);
-        return false;
-      }
-      memcpy(bytecode, &data->file_data[bytecode_addr], (size_t)length);
-    }
+    const uint8_t *bytecode = (length > 0) ? &data->file_data[bytecode_addr] : NULL;
 
     entries[i].raw_offset = ptr;
     entries[i].name = name;
@@ -1069,7 +764,7 @@ static bool parse_code(bs_game_data *data) {
 
   data->code_entries = entries;
   data->code_entry_count = count;
-  printf("  CODE: %u entries\n", count_u32);
+  (void)snprintf(summary, summary_size, "  CODE: %u entries\n", count_u32);
   return true;
 }
 
@@ -1091,7 +786,8 @@ static int32_t resolve_code_index(const bs_game_data *data, int32_t raw_code_id)
   return raw_code_id;
 }
 
-static bool parse_sond(bs_game_data *data) {
+static bool parse_sond(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_SOND];
   const bs_chunk_info *chunk = find_chunk(data, "SOND");
   if (chunk == NULL) {
     data->sounds = NULL;
@@ -1111,7 +807,7 @@ static bool parse_sond(bs_game_data *data) {
 
   bs_sound_data *sounds = NULL;
   if (count > 0) {
-    sounds = (bs_sound_data *)calloc(count, sizeof(bs_sound_data));
+    sounds = (bs_sound_data *)arena_calloc(arena, count, sizeof(bs_sound_data));
     if (sounds == NULL) {
       return false;
     }
@@ -1137,28 +833,13 @@ static bool parse_sond(bs_game_data *data) {
         !read_f32_le(data, ptr + 20, &volume) ||
         !read_u32_le(data, ptr + 24, &group_id) ||
         !read_i32_le(data, ptr + 32, &audio_id)) {
-      for (size_t j = 0; j < i; j++) {
-        free(sounds[j].name);
-        free(sounds[j].extension);
-        free(sounds[j].file_name);
-      }
-      free(sounds);
       return false;
     }
 
-    sounds[i].name = read_string_ref(data, name_ptr);
-    sounds[i].extension = read_string_ref(data, ext_ptr);
-    sounds[i].file_name = read_string_ref(data, file_ptr);
+    sounds[i].name = read_string_ref(data, arena, name_ptr);
+    sounds[i].extension = read_string_ref(data, arena, ext_ptr);
+    sounds[i].file_name = read_string_ref(data, arena, file_ptr);
     if (sounds[i].name == NULL || sounds[i].extension == NULL || sounds[i].file_name == NULL) {
-      free(sounds[i].name);
-      free(sounds[i].extension);
-      free(sounds[i].file_name);
-      for (size_t j = 0; j < i; j++) {
-        free(sounds[j].name);
-        free(sounds[j].extension);
-        free(sounds[j].file_name);
-      }
-      free(sounds);
       return false;
     }
 
@@ -1171,11 +852,12 @@ static bool parse_sond(bs_game_data *data) {
 
   data->sounds = sounds;
   data->sound_count = count;
-  printf("  SOND: %u sounds\n", count_u32);
+  (void)snprintf(summary, summary_size, "  SOND: %u sounds\n", count_u32);
   return true;
 }
 
-static bool parse_audo(bs_game_data *data) {
+static bool parse_audo(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_AUDO];
   const bs_chunk_info *chunk = find_chunk(data, "AUDO");
   if (chunk == NULL) {
     data->audio_data = NULL;
@@ -1195,7 +877,7 @@ static bool parse_audo(bs_game_data *data) {
 
   bs_audio_data *audio_data = NULL;
   if (count > 0) {
-    audio_data = (bs_audio_data *)calloc(count, sizeof(bs_audio_data));
+    audio_data = (bs_audio_data *)arena_calloc(arena, count, sizeof(bs_audio_data));
     if (audio_data == NULL) {
       return false;
     }
@@ -1206,14 +888,12 @@ static bool parse_audo(bs_game_data *data) {
     uint32_t length = 0;
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
         !read_u32_le(data, ptr, &length)) {
-      free(audio_data);
       return false;
     }
 
     uint32_t data_offset = ptr + 4;
     char tag[5];
     if (!read_tag(data, data_offset, tag)) {
-      free(audio_data);
       return false;
     }
 
@@ -1231,11 +911,12 @@ static bool parse_audo(bs_game_data *data) {
 
   data->audio_data = audio_data;
   data->audio_data_count = count;
-  printf("  AUDO: %u audio entries\n", count_u32);
+  (void)snprintf(summary, summary_size, "  AUDO: %u audio entries\n", count_u32);
   return true;
 }
 
-static bool parse_scpt(bs_game_data *data) {
+static bool parse_scpt(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_SCPT];
   const bs_chunk_info *chunk = find_chunk(data, "SCPT");
   if (chunk == NULL) {
     return false;
@@ -1253,7 +934,7 @@ static bool parse_scpt(bs_game_data *data) {
 
   bs_script_data *scripts = NULL;
   if (count > 0) {
-    scripts = (bs_script_data *)calloc(count, sizeof(bs_script_data));
+    scripts = (bs_script_data *)arena_calloc(arena, count, sizeof(bs_script_data));
     if (scripts == NULL) {
       return false;
     }
@@ -1266,19 +947,11 @@ static bool parse_scpt(bs_game_data *data) {
     if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
         !read_u32_le(data, ptr, &name_ptr) ||
         !read_i32_le(data, ptr + 4, &code_id)) {
-      for (size_t j = 0; j < i; j++) {
-        free(scripts[j].name);
-      }
-      free(scripts);
       return false;
     }
 
-    scripts[i].name = read_string_ref(data, name_ptr);
+    scripts[i].name = read_string_ref(data, arena, name_ptr);
     if (scripts[i].name == NULL) {
-      for (size_t j = 0; j < i; j++) {
-        free(scripts[j].name);
-      }
-      free(scripts);
       return false;
     }
     scripts[i].code_id = code_id;
@@ -1286,11 +959,12 @@ static bool parse_scpt(bs_game_data *data) {
 
   data->scripts = scripts;
   data->script_count = count;
-  printf("  SCPT: %u scripts\n", count_u32);
+  (void)snprintf(summary, summary_size, "  SCPT: %u scripts\n", count_u32);
   return true;
 }
 
-static bool parse_vari(bs_game_data *data) {
+static bool parse_vari(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_VARI];
   const bs_chunk_info *chunk = find_chunk(data, "VARI");
   if (chunk == NULL) {
     return false;
@@ -1311,28 +985,18 @@ static bool parse_vari(bs_game_data *data) {
     return false;
   }
 
-  size_t capacity = 1024;
-  size_t count = 0;
-  bs_variable_data *variables = (bs_variable_data *)calloc(capacity, sizeof(bs_variable_data));
-  if (variables == NULL) {
-    return false;
+  /* Records are fixed-size, so the array can be sized exactly from the chunk length. */
+  size_t count = (end >= d + 12) ? (size_t)((end - (d + 12)) / 20u) : 0;
+  bs_variable_data *variables = NULL;
+  if (count > 0) {
+    variables = (bs_variable_data *)arena_calloc(arena, count, sizeof(bs_variable_data));
+    if (variables == NULL) {
+      return false;
+    }
   }
 
   uint32_t offset = d + 12;
-  while (offset + 20 <= end) {
-    if (count == capacity) {
-      capacity *= 2;
-      bs_variable_data *grown = (bs_variable_data *)realloc(variables, capacity * sizeof(bs_variable_data));
-      if (grown == NULL) {
-        for (size_t i = 0; i < count; i++) {
-          free(variables[i].name);
-        }
-        free(variables);
-        return false;
-      }
-      variables = grown;
-    }
-
+  for (size_t i = 0; i < count; i++) {
     uint32_t name_ptr = 0;
     int32_t instance_type = 0;
     int32_t var_id = 0;
@@ -1343,26 +1007,17 @@ static bool parse_vari(bs_game_data *data) {
         !read_i32_le(data, offset + 8, &var_id) ||
         !read_i32_le(data, offset + 12, &occ_count) ||
         !read_i32_le(data, offset + 16, &first_occ)) {
-      for (size_t i = 0; i < count; i++) {
-        free(variables[i].name);
-      }
-      free(variables);
       return false;
     }
 
-    variables[count].name = read_string_ref(data, name_ptr);
-    if (variables[count].name == NULL) {
-      for (size_t i = 0; i < count; i++) {
-        free(variables[i].name);
-      }
-      free(variables);
+    variables[i].name = read_string_ref(data, arena, name_ptr);
+    if (variables[i].name == NULL) {
       return false;
     }
-    variables[count].instance_type = instance_type;
-    variables[count].var_id = var_id;
-    variables[count].occurrence_count = occ_count;
-    variables[count].first_occurrence_offset = first_occ;
-    count++;
+    variables[i].instance_type = instance_type;
+    variables[i].var_id = var_id;
+    variables[i].occurrence_count = occ_count;
+    variables[i].first_occurrence_offset = first_occ;
 
     offset += 20;
   }
@@ -1370,11 +1025,12 @@ static bool parse_vari(bs_game_data *data) {
   data->variables = variables;
   data->variable_count = count;
   (void)count2;
-  printf("  VARI: %zu variables (count1=%u, maxLocal=%u)\n", count, count1, max_local);
+  (void)snprintf(summary, summary_size, "  VARI: %zu variables (count1=%u, maxLocal=%u)\n", count, count1, max_local);
   return true;
 }
 
-static bool parse_func(bs_game_data *data) {
+static bool parse_func(bs_game_data *data, char *summary, size_t summary_size) {
+  bs_arena *arena = &data->arenas[BS_DATA_ARENA_FUNC];
   const bs_chunk_info *chunk = find_chunk(data, "FUNC");
   if (chunk == NULL) {
     return false;
@@ -1392,7 +1048,7 @@ static bool parse_func(bs_game_data *data) {
 
   bs_function_data *functions = NULL;
   if (count > 0) {
-    functions = (bs_function_data *)calloc(count, sizeof(bs_function_data));
+    functions = (bs_function_data *)arena_calloc(arena, count, sizeof(bs_function_data));
     if (functions == NULL) {
       return false;
     }
@@ -1406,19 +1062,11 @@ static bool parse_func(bs_game_data *data) {
     if (!read_u32_le(data, offset, &name_ptr) ||
         !read_i32_le(data, offset + 4, &occ_count) ||
         !read_i32_le(data, offset + 8, &first_occ)) {
-      for (size_t j = 0; j < i; j++) {
-        free(functions[j].name);
-      }
-      free(functions);
       return false;
     }
 
-    functions[i].name = read_string_ref(data, name_ptr);
+    functions[i].name = read_string_ref(data, arena, name_ptr);
     if (functions[i].name == NULL) {
-      for (size_t j = 0; j < i; j++) {
-        free(functions[j].name);
-      }
-      free(functions);
       return false;
     }
     functions[i].occurrence_count = occ_count;
@@ -1428,689 +1076,1144 @@ static bool parse_func(bs_game_data *data) {
 
   data->functions = functions;
   data->function_count = count;
-  printf("  FUNC: %u functions\n", count_u32);
+  (void)snprintf(summary, summary_size, "  FUNC: %u functions\n", count_u32);
   return true;
 }
 
-static void free_sprite_data(bs_sprite_data *sprite) {
-  if (sprite == NULL) {
-    return;
+#define BS_ASSET_UNPARSED 0u
+#define BS_ASSET_READY 1u
+#define BS_ASSET_FAILED 2u
+
+/* Builds the offset index for a pointer-list chunk. Records are only parsed on first access. */
+static bool index_asset_chunk(bs_game_data *data, const char *tag, bool required, size_t record_size,
+                              bs_arena *arena, bs_asset_index *out_assets, void **out_cache, size_t *out_count) {
+  const bs_chunk_info *chunk = find_chunk(data, tag);
+  uint32_t count_u32 = 0;
+  size_t count = 0;
+  uint8_t *states = NULL;
+  void *cache = NULL;
+
+  out_assets->table_offset = 0;
+  out_assets->states = NULL;
+  out_assets->count = 0;
+  *out_cache = NULL;
+  *out_count = 0;
+  if (chunk == NULL) {
+    return !required;
   }
-  free(sprite->name);
-  free(sprite->tpag_indices);
-  sprite->name = NULL;
-  sprite->tpag_indices = NULL;
-  sprite->subimage_count = 0;
-}
 
-static void free_background_data(bs_background_data *background) {
-  if (background == NULL) {
-    return;
+  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
+    return false;
+  }
+  count = (size_t)count_u32;
+  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
+    return false;
   }
-  free(background->name);
-  background->name = NULL;
-  background->tpag_index = -1;
-}
 
-static void free_path_data(bs_path_data *path) {
-  if (path == NULL) {
-    return;
+  if (count > 0) {
+    states = (uint8_t *)arena_calloc(arena, count, sizeof(uint8_t));
+    cache = arena_calloc(arena, count, record_size);
+    if (states == NULL || cache == NULL) {
+      return false;
+    }
   }
-  free(path->name);
-  free(path->points);
-  path->name = NULL;
-  path->points = NULL;
-  path->point_count = 0;
+
+  out_assets->table_offset = chunk->data_offset + 4;
+  out_assets->states = states;
+  out_assets->count = count;
+  *out_cache = cache;
+  *out_count = count;
+  return true;
 }
 
-static void free_font_data(bs_font_data *font) {
-  if (font == NULL) {
-    return;
+/* Returns the slot state for index; out_ptr is the record offset when the slot is still unparsed. */
+/* The asset tables and caches are heap storage the const data only points to, so the lazy
+ * accessors write through those pointers without casting; see the note in form_reader.h. */
+static uint8_t asset_slot(const bs_game_data *data, const bs_asset_index *assets, int32_t index, uint32_t *out_ptr) {
+  uint8_t state = BS_ASSET_FAILED;
+  if (data == NULL || index < 0 || (size_t)index >= assets->count) {
+    return BS_ASSET_FAILED;
   }
-  free(font->name);
-  free(font->display_name);
-  free(font->glyphs);
-  font->name = NULL;
-  font->display_name = NULL;
-  font->glyphs = NULL;
-  font->glyph_count = 0;
-}
 
-static void free_object_data(bs_game_object_data *obj) {
-  if (obj == NULL) {
-    return;
+  state = assets->states[(size_t)index];
+  if (state == BS_ASSET_UNPARSED &&
+      !read_u32_le(data, assets->table_offset + (uint32_t)((size_t)index * 4u), out_ptr)) {
+    assets->states[(size_t)index] = BS_ASSET_FAILED;
+    return BS_ASSET_FAILED;
   }
+  return state;
+}
 
-  free(obj->name);
-  obj->name = NULL;
+static void mark_asset_failed(const bs_asset_index *assets, int32_t index, const char *tag) {
+  assets->states[(size_t)index] = BS_ASSET_FAILED;
+  fprintf(stderr, "Failed to parse %s entry %d\n", tag, (int)index);
+}
 
-  for (size_t event_type = 0; event_type < obj->event_type_count; event_type++) {
-    bs_object_event_list *event_list = &obj->events[event_type];
-    for (size_t i = 0; i < event_list->entry_count; i++) {
-      free(event_list->entries[i].actions);
-      event_list->entries[i].actions = NULL;
-      event_list->entries[i].action_count = 0;
+static size_t asset_ready_count(const bs_asset_index *assets) {
+  size_t ready = 0;
+  for (size_t i = 0; i < assets->count; i++) {
+    if (assets->states[i] == BS_ASSET_READY) {
+      ready++;
     }
-    free(event_list->entries);
-    event_list->entries = NULL;
-    event_list->entry_count = 0;
   }
+  return ready;
+}
 
-  free(obj->events);
-  obj->events = NULL;
-  obj->event_type_count = 0;
+static bool eager_assets_enabled(void) {
+  const char *env = getenv("BS_EAGER_ASSETS");
+  return env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0);
 }
 
-static void free_room_data(bs_room_data *room) {
-  if (room == NULL) {
+/* SPRT stores one mask per subimage (or a single shared one) after the texture list, each row
+ * padded to whole bytes with the leftmost pixel in the high bit. A sprite whose masks do not
+ * read cleanly keeps none and falls back to its margin rectangle. */
+static void read_sprite_masks(const bs_game_data *data, bs_arena *arena, uint32_t offset, bs_sprite_data *sprite) {
+  uint32_t mask_count = 0;
+  size_t row_bytes = 0;
+  size_t stride = 0;
+  size_t height = 0;
+  uint64_t *masks = NULL;
+  const uint8_t *bytes = NULL;
+
+  if (sprite->width <= 0 || sprite->height <= 0 || !read_u32_le(data, offset, &mask_count)) {
+    return;
+  }
+  if (mask_count == 0 || (mask_count != 1u && (size_t)mask_count != sprite->subimage_count)) {
     return;
   }
+  row_bytes = ((size_t)sprite->width + 7u) / 8u;
+  height = (size_t)sprite->height;
+  stride = ((size_t)sprite->width + 63u) / 64u;
+  if (!can_read_range(data->file_size, offset + 4u, row_bytes * height * (size_t)mask_count)) {
+    return;
+  }
+  masks = (uint64_t *)arena_calloc(arena, (size_t)mask_count * height * stride, sizeof(uint64_t));
+  if (masks == NULL) {
+    return;
+  }
+
+  bytes = &data->file_data[offset + 4u];
+  for (size_t row = 0; row < (size_t)mask_count * height; row++) {
+    uint64_t *words = &masks[row * stride];
+    for (size_t x = 0; x < (size_t)sprite->width; x++) {
+      if ((bytes[row * row_bytes + (x >> 3)] & (0x80u >> (x & 7u))) != 0) {
+        words[x >> 6] |= (uint64_t)1 << (x & 63u);
+      }
+    }
+  }
+  sprite->collision_masks = masks;
+  sprite->collision_mask_count = (size_t)mask_count;
+  sprite->collision_mask_stride = stride;
+}
 
-  free(room->name);
-  free(room->caption);
-  room->name = NULL;
-  room->caption = NULL;
+static bool materialize_sprite(const bs_game_data *data, bs_arena *arena, uint32_t ptr, bs_sprite_data *sprite) {
+  uint32_t name_ptr = 0;
+  int32_t subimage_count_i32 = 0;
+  size_t subimage_count = 0;
 
-  free(room->backgrounds);
-  room->backgrounds = NULL;
-  room->background_count = 0;
+  if (!read_u32_le(data, ptr + 0, &name_ptr) ||
+      !read_i32_le(data, ptr + 4, &sprite->width) ||
+      !read_i32_le(data, ptr + 8, &sprite->height) ||
+      !read_i32_le(data, ptr + 0x0C, &sprite->margin_left) ||
+      !read_i32_le(data, ptr + 0x10, &sprite->margin_right) ||
+      !read_i32_le(data, ptr + 0x14, &sprite->margin_bottom) ||
+      !read_i32_le(data, ptr + 0x18, &sprite->margin_top) ||
+      !read_i32_le(data, ptr + 0x2C, &sprite->collision_mask_type) ||
+      !read_i32_le(data, ptr + 0x30, &sprite->origin_x) ||
+      !read_i32_le(data, ptr + 0x34, &sprite->origin_y) ||
+      !read_i32_le(data, ptr + 0x38, &subimage_count_i32)) {
+    return false;
+  }
 
-  free(room->views);
-  room->views = NULL;
-  room->view_count = 0;
+  if (subimage_count_i32 < 0) {
+    return false;
+  }
+  subimage_count = (size_t)subimage_count_i32;
+  if (!can_read_range(data->file_size, ptr + 0x3C, subimage_count * sizeof(uint32_t))) {
+    return false;
+  }
 
-  free(room->instances);
-  room->instances = NULL;
-  room->instance_count = 0;
+  if (subimage_count > 0) {
+    sprite->tpag_indices = (int32_t *)arena_calloc(arena, subimage_count, sizeof(int32_t));
+    if (sprite->tpag_indices == NULL) {
+      return false;
+    }
+  }
+  sprite->subimage_count = subimage_count;
 
-  free(room->tiles);
-  room->tiles = NULL;
-  room->tile_count = 0;
+  for (size_t frame = 0; frame < subimage_count; frame++) {
+    uint32_t tpag_ptr = 0;
+    if (!read_u32_le(data, ptr + 0x3C + (uint32_t)(frame * 4), &tpag_ptr)) {
+      return false;
+    }
+    sprite->tpag_indices[frame] = resolve_tpag_index_by_offset(data, tpag_ptr);
+  }
+  if (sprite->collision_mask_type == BS_SPRITE_MASK_PRECISE) {
+    read_sprite_masks(data, arena, ptr + 0x3C + (uint32_t)(subimage_count * 4), sprite);
+  }
+
+  sprite->name = read_string_ref(data, arena, name_ptr);
+  return sprite->name != NULL;
 }
 
-static bool parse_objt(bs_game_data *data) {
-  const bs_chunk_info *chunk = find_chunk(data, "OBJT");
-  if (chunk == NULL) {
+static bool materialize_path(const bs_game_data *data, bs_arena *arena, uint32_t ptr, bs_path_data *path) {
+  uint32_t name_ptr = 0;
+  uint32_t is_smooth_u32 = 0;
+  uint32_t is_closed_u32 = 0;
+  uint32_t point_count_u32 = 0;
+
+  if (!read_u32_le(data, ptr + 0, &name_ptr) ||
+      !read_u32_le(data, ptr + 4, &is_smooth_u32) ||
+      !read_u32_le(data, ptr + 8, &is_closed_u32) ||
+      !read_i32_le(data, ptr + 12, &path->precision) ||
+      !read_u32_le(data, ptr + 16, &point_count_u32)) {
     return false;
   }
 
-  uint32_t count_u32 = 0;
-  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
+  if (!can_read_range(data->file_size, ptr + 20, (size_t)point_count_u32 * 12u)) {
     return false;
   }
-  size_t count = (size_t)count_u32;
 
-  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
-    return false;
+  if (point_count_u32 > 0) {
+    path->points = (bs_path_point_data *)arena_calloc(arena, (size_t)point_count_u32, sizeof(bs_path_point_data));
+    if (path->points == NULL) {
+      return false;
+    }
   }
+  path->point_count = (size_t)point_count_u32;
 
-  bs_game_object_data *objects = NULL;
-  if (count > 0) {
-    objects = (bs_game_object_data *)calloc(count, sizeof(bs_game_object_data));
-    if (objects == NULL) {
+  for (size_t p = 0; p < path->point_count; p++) {
+    uint32_t point_offset = ptr + 20 + (uint32_t)(p * 12u);
+    if (!read_f32_le(data, point_offset + 0, &path->points[p].x) ||
+        !read_f32_le(data, point_offset + 4, &path->points[p].y) ||
+        !read_f32_le(data, point_offset + 8, &path->points[p].speed)) {
       return false;
     }
   }
 
-  for (size_t i = 0; i < count; i++) {
-    uint32_t ptr = 0;
-    uint32_t name_ptr = 0;
-    int32_t sprite_index = -1;
-    uint32_t visible_u32 = 0;
-    uint32_t solid_u32 = 0;
-    int32_t depth = 0;
-    uint32_t persistent_u32 = 0;
-    int32_t parent_id = -1;
-    int32_t mask_id = -1;
-    int32_t physics_vertex_count = 0;
+  path->is_smooth = (is_smooth_u32 != 0);
+  path->is_closed = (is_closed_u32 != 0);
+  path->name = read_string_ref(data, arena, name_ptr);
+  return path->name != NULL;
+}
 
-    if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
-        !read_u32_le(data, ptr + 0, &name_ptr) ||
-        !read_i32_le(data, ptr + 4, &sprite_index) ||
-        !read_u32_le(data, ptr + 8, &visible_u32) ||
-        !read_u32_le(data, ptr + 0x0C, &solid_u32) ||
-        !read_i32_le(data, ptr + 0x10, &depth) ||
-        !read_u32_le(data, ptr + 0x14, &persistent_u32) ||
-        !read_i32_le(data, ptr + 0x18, &parent_id) ||
-        !read_i32_le(data, ptr + 0x1C, &mask_id) ||
-        !read_i32_le(data, ptr + 0x40, &physics_vertex_count)) {
-      for (size_t j = 0; j < i; j++) {
-        free_object_data(&objects[j]);
-      }
-      free(objects);
+static bool materialize_font(const bs_game_data *data, bs_arena *arena, uint32_t ptr, bs_font_data *font) {
+  uint32_t name_ptr = 0;
+  uint32_t display_name_ptr = 0;
+  uint32_t tpag_ptr = 0;
+  uint32_t glyph_count_u32 = 0;
+
+  font->scale_x = 1.0f;
+  font->scale_y = 1.0f;
+  if (!read_u32_le(data, ptr + 0, &name_ptr) ||
+      !read_u32_le(data, ptr + 4, &display_name_ptr) ||
+      !read_i32_le(data, ptr + 8, &font->em_size) ||
+      !read_u32_le(data, ptr + 28, &tpag_ptr) ||
+      !read_f32_le(data, ptr + 32, &font->scale_x) ||
+      !read_f32_le(data, ptr + 36, &font->scale_y) ||
+      !read_u32_le(data, ptr + 40, &glyph_count_u32)) {
+    return false;
+  }
+
+  if (!can_read_range(data->file_size, ptr + 44, (size_t)glyph_count_u32 * sizeof(uint32_t))) {
+    return false;
+  }
+
+  if (glyph_count_u32 > 0) {
+    font->glyphs = (bs_font_glyph_data *)arena_calloc(arena, (size_t)glyph_count_u32, sizeof(bs_font_glyph_data));
+    if (font->glyphs == NULL) {
       return false;
     }
+  }
+  font->glyph_count = (size_t)glyph_count_u32;
 
-    if (physics_vertex_count < 0) {
-      for (size_t j = 0; j < i; j++) {
-        free_object_data(&objects[j]);
-      }
-      free(objects);
+  for (size_t g = 0; g < font->glyph_count; g++) {
+    uint32_t glyph_ptr = 0;
+    bs_font_glyph_data *glyph = &font->glyphs[g];
+    if (!read_u32_le(data, ptr + 44 + (uint32_t)(g * 4), &glyph_ptr) ||
+        !read_u16_le(data, glyph_ptr + 0, &glyph->character) ||
+        !read_u16_le(data, glyph_ptr + 2, &glyph->x) ||
+        !read_u16_le(data, glyph_ptr + 4, &glyph->y) ||
+        !read_u16_le(data, glyph_ptr + 6, &glyph->width) ||
+        !read_u16_le(data, glyph_ptr + 8, &glyph->height) ||
+        !read_u16_le(data, glyph_ptr + 10, &glyph->shift) ||
+        !read_u16_le(data, glyph_ptr + 12, &glyph->offset)) {
       return false;
     }
+  }
 
-    uint64_t events_start_u64 = (uint64_t)ptr + 0x50ull + ((uint64_t)physics_vertex_count * 8ull);
-    if (events_start_u64 > (uint64_t)data->file_size || events_start_u64 > UINT32_MAX) {
-      for (size_t j = 0; j < i; j++) {
-        free_object_data(&objects[j]);
-      }
-      free(objects);
+  font->tpag_index = resolve_tpag_index_by_offset(data, tpag_ptr);
+  font->name = read_string_ref(data, arena, name_ptr);
+  font->display_name = read_string_ref(data, arena, display_name_ptr);
+  return font->name != NULL && font->display_name != NULL;
+}
+
+static bool materialize_object(const bs_game_data *data, bs_arena *arena, uint32_t ptr, bs_game_object_data *obj) {
+  uint32_t name_ptr = 0;
+  uint32_t visible_u32 = 0;
+  uint32_t solid_u32 = 0;
+  uint32_t persistent_u32 = 0;
+  int32_t physics_vertex_count = 0;
+  uint64_t events_start_u64 = 0;
+  uint32_t events_start = 0;
+  uint32_t event_type_count_u32 = 0;
+
+  if (!read_u32_le(data, ptr + 0, &name_ptr) ||
+      !read_i32_le(data, ptr + 4, &obj->sprite_index) ||
+      !read_u32_le(data, ptr + 8, &visible_u32) ||
+      !read_u32_le(data, ptr + 0x0C, &solid_u32) ||
+      !read_i32_le(data, ptr + 0x10, &obj->depth) ||
+      !read_u32_le(data, ptr + 0x14, &persistent_u32) ||
+      !read_i32_le(data, ptr + 0x18, &obj->parent_id) ||
+      !read_i32_le(data, ptr + 0x1C, &obj->mask_id) ||
+      !read_i32_le(data, ptr + 0x40, &physics_vertex_count)) {
+    return false;
+  }
+  obj->visible = (visible_u32 != 0);
+  obj->solid = (solid_u32 != 0);
+  obj->persistent = (persistent_u32 != 0);
+
+  if (physics_vertex_count < 0) {
+    return false;
+  }
+
+  events_start_u64 = (uint64_t)ptr + 0x50ull + ((uint64_t)physics_vertex_count * 8ull);
+  if (events_start_u64 > (uint64_t)data->file_size || events_start_u64 > UINT32_MAX) {
+    return false;
+  }
+  events_start = (uint32_t)events_start_u64;
+
+  if (!read_u32_le(data, events_start, &event_type_count_u32)) {
+    return false;
+  }
+  if (event_type_count_u32 > 0) {
+    obj->events = (bs_object_event_list *)arena_calloc(arena, (size_t)event_type_count_u32, sizeof(bs_object_event_list));
+    if (obj->events == NULL) {
       return false;
     }
-    uint32_t events_start = (uint32_t)events_start_u64;
+  }
+  obj->event_type_count = (size_t)event_type_count_u32;
 
-    uint32_t event_type_count_u32 = 0;
-    if (!read_u32_le(data, events_start, &event_type_count_u32)) {
-      for (size_t j = 0; j < i; j++) {
-        free_object_data(&objects[j]);
-      }
-      free(objects);
+  for (size_t event_type = 0; event_type < obj->event_type_count; event_type++) {
+    bs_object_event_list *event_list = &obj->events[event_type];
+    uint32_t category_ptr = 0;
+    uint32_t sub_event_count_u32 = 0;
+    if (!read_u32_le(data, events_start + 4 + (uint32_t)(event_type * 4), &category_ptr) ||
+        !read_u32_le(data, category_ptr, &sub_event_count_u32)) {
       return false;
     }
-    size_t event_type_count = (size_t)event_type_count_u32;
 
-    bs_object_event_list *events = NULL;
-    if (event_type_count > 0) {
-      events = (bs_object_event_list *)calloc(event_type_count, sizeof(bs_object_event_list));
-      if (events == NULL) {
-        for (size_t j = 0; j < i; j++) {
-          free_object_data(&objects[j]);
-        }
-        free(objects);
+    if (sub_event_count_u32 > 0) {
+      event_list->entries = (bs_event_entry *)arena_calloc(arena, (size_t)sub_event_count_u32, sizeof(bs_event_entry));
+      if (event_list->entries == NULL) {
         return false;
       }
     }
+    event_list->entry_count = (size_t)sub_event_count_u32;
 
-    for (size_t event_type = 0; event_type < event_type_count; event_type++) {
-      uint32_t category_ptr = 0;
-      if (!read_u32_le(data, events_start + 4 + (uint32_t)(event_type * 4), &category_ptr)) {
-        for (size_t k = 0; k < event_type; k++) {
-          for (size_t m = 0; m < events[k].entry_count; m++) {
-            free(events[k].entries[m].actions);
-          }
-          free(events[k].entries);
-        }
-        free(events);
-        for (size_t j = 0; j < i; j++) {
-          free_object_data(&objects[j]);
-        }
-        free(objects);
+    for (size_t e = 0; e < event_list->entry_count; e++) {
+      bs_event_entry *entry = &event_list->entries[e];
+      uint32_t event_ptr = 0;
+      uint32_t action_count_u32 = 0;
+      if (!read_u32_le(data, category_ptr + 4 + (uint32_t)(e * 4), &event_ptr) ||
+          !read_i32_le(data, event_ptr, &entry->subtype) ||
+          !read_u32_le(data, event_ptr + 4, &action_count_u32)) {
         return false;
       }
 
-      uint32_t sub_event_count_u32 = 0;
-      if (!read_u32_le(data, category_ptr, &sub_event_count_u32)) {
-        for (size_t k = 0; k < event_type; k++) {
-          for (size_t m = 0; m < events[k].entry_count; m++) {
-            free(events[k].entries[m].actions);
-          }
-          free(events[k].entries);
-        }
-        free(events);
-        for (size_t j = 0; j < i; j++) {
-          free_object_data(&objects[j]);
+      if (action_count_u32 > 0) {
+        entry->actions = (bs_event_action *)arena_calloc(arena, (size_t)action_count_u32, sizeof(bs_event_action));
+        if (entry->actions == NULL) {
+          return false;
         }
-        free(objects);
-        return false;
       }
+      entry->action_count = (size_t)action_count_u32;
 
-      size_t sub_event_count = (size_t)sub_event_count_u32;
-      bs_event_entry *entries = NULL;
-      if (sub_event_count > 0) {
-        entries = (bs_event_entry *)calloc(sub_event_count, sizeof(bs_event_entry));
-        if (entries == NULL) {
-          for (size_t k = 0; k < event_type; k++) {
-            for (size_t m = 0; m < events[k].entry_count; m++) {
-              free(events[k].entries[m].actions);
-            }
-            free(events[k].entries);
-          }
-          free(events);
-          for (size_t j = 0; j < i; j++) {
-            free_object_data(&objects[j]);
-          }
-          free(objects);
+      for (size_t a = 0; a < entry->action_count; a++) {
+        uint32_t action_ptr = 0;
+        int32_t raw_code_id = -1;
+        if (!read_u32_le(data, event_ptr + 8 + (uint32_t)(a * 4), &action_ptr) ||
+            !read_i32_le(data, action_ptr + 0x20, &raw_code_id)) {
           return false;
         }
+        entry->actions[a].code_id = resolve_code_index(data, raw_code_id);
       }
+    }
+  }
 
-      for (size_t e = 0; e < sub_event_count; e++) {
-        uint32_t event_ptr = 0;
-        int32_t subtype = 0;
-        uint32_t action_count_u32 = 0;
-        if (!read_u32_le(data, category_ptr + 4 + (uint32_t)(e * 4), &event_ptr) ||
-            !read_i32_le(data, event_ptr, &subtype) ||
-            !read_u32_le(data, event_ptr + 4, &action_count_u32)) {
-          for (size_t x = 0; x < e; x++) {
-            free(entries[x].actions);
-          }
-          free(entries);
-          for (size_t k = 0; k < event_type; k++) {
-            for (size_t m = 0; m < events[k].entry_count; m++) {
-              free(events[k].entries[m].actions);
-            }
-            free(events[k].entries);
-          }
-          free(events);
-          for (size_t j = 0; j < i; j++) {
-            free_object_data(&objects[j]);
-          }
-          free(objects);
-          return false;
-        }
+  obj->name = read_string_ref(data, arena, name_ptr);
+  return obj->name != NULL;
+}
 
-        size_t action_count = (size_t)action_count_u32;
-        bs_event_action *actions = NULL;
-        if (action_count > 0) {
-          actions = (bs_event_action *)calloc(action_count, sizeof(bs_event_action));
-          if (actions == NULL) {
-            for (size_t x = 0; x < e; x++) {
-              free(entries[x].actions);
-            }
-            free(entries);
-            for (size_t k = 0; k < event_type; k++) {
-              for (size_t m = 0; m < events[k].entry_count; m++) {
-                free(events[k].entries[m].actions);
-              }
-              free(events[k].entries);
-            }
-            free(events);
-            for (size_t j = 0; j < i; j++) {
-              free_object_data(&objects[j]);
-            }
-            free(objects);
-            return false;
-          }
-        }
+static bool materialize_room(const bs_game_data *data, bs_arena *arena, uint32_t ptr, bs_room_data *room) {
+  uint32_t name_ptr = 0;
+  uint32_t caption_ptr = 0;
+  uint32_t persistent_u32 = 0;
+  uint32_t draw_bg_color_u32 = 0;
+  int32_t creation_code_raw = -1;
+  uint32_t bg_list_ptr = 0;
+  uint32_t view_list_ptr = 0;
+  uint32_t obj_list_ptr = 0;
+  uint32_t tile_list_ptr = 0;
+  uint32_t bg_count_u32 = 0;
+  uint32_t view_count_u32 = 0;
+  uint32_t instance_count_u32 = 0;
+  uint32_t tile_count_u32 = 0;
+
+  if (!read_u32_le(data, ptr + 0, &name_ptr) ||
+      !read_u32_le(data, ptr + 4, &caption_ptr) ||
+      !read_i32_le(data, ptr + 8, &room->width) ||
+      !read_i32_le(data, ptr + 0x0C, &room->height) ||
+      !read_i32_le(data, ptr + 0x10, &room->speed) ||
+      !read_u32_le(data, ptr + 0x14, &persistent_u32) ||
+      !read_u32_le(data, ptr + 0x18, &room->bg_color) ||
+      !read_u32_le(data, ptr + 0x1C, &draw_bg_color_u32) ||
+      !read_i32_le(data, ptr + 0x20, &creation_code_raw) ||
+      !read_u32_le(data, ptr + 0x24, &room->flags) ||
+      !read_u32_le(data, ptr + 0x28, &bg_list_ptr) ||
+      !read_u32_le(data, ptr + 0x2C, &view_list_ptr) ||
+      !read_u32_le(data, ptr + 0x30, &obj_list_ptr) ||
+      !read_u32_le(data, ptr + 0x34, &tile_list_ptr)) {
+    return false;
+  }
+  room->persistent = (persistent_u32 != 0);
+  room->draw_bg_color = (draw_bg_color_u32 != 0);
+  room->creation_code_id = (creation_code_raw >= 0) ? resolve_code_index(data, creation_code_raw) : -1;
+
+  if (!read_u32_le(data, bg_list_ptr, &bg_count_u32)) {
+    return false;
+  }
+  if (bg_count_u32 > 0) {
+    room->backgrounds = (bs_room_background_data *)arena_calloc(arena, (size_t)bg_count_u32, sizeof(bs_room_background_data));
+    if (room->backgrounds == NULL) {
+      return false;
+    }
+  }
+  room->background_count = (size_t)bg_count_u32;
+  for (size_t j = 0; j < room->background_count; j++) {
+    bs_room_background_data *background = &room->backgrounds[j];
+    uint32_t bp = 0;
+    uint32_t enabled = 0;
+    uint32_t foreground = 0;
+    uint32_t tile_x = 0;
+    uint32_t tile_y = 0;
+    uint32_t stretch = 0;
+    if (!read_u32_le(data, bg_list_ptr + 4 + (uint32_t)(j * 4), &bp) ||
+        !read_u32_le(data, bp + 0, &enabled) ||
+        !read_u32_le(data, bp + 4, &foreground) ||
+        !read_i32_le(data, bp + 8, &background->bg_def_index) ||
+        !read_i32_le(data, bp + 12, &background->x) ||
+        !read_i32_le(data, bp + 16, &background->y) ||
+        !read_u32_le(data, bp + 20, &tile_x) ||
+        !read_u32_le(data, bp + 24, &tile_y) ||
+        !read_i32_le(data, bp + 28, &background->speed_x) ||
+        !read_i32_le(data, bp + 32, &background->speed_y) ||
+        !read_u32_le(data, bp + 36, &stretch)) {
+      return false;
+    }
+    background->enabled = (enabled != 0);
+    background->foreground = (foreground != 0);
+    background->tile_x = (tile_x != 0);
+    background->tile_y = (tile_y != 0);
+    background->stretch = (stretch != 0);
+  }
+
+  if (!read_u32_le(data, view_list_ptr, &view_count_u32)) {
+    return false;
+  }
+  if (view_count_u32 > 0) {
+    room->views = (bs_room_view_data *)arena_calloc(arena, (size_t)view_count_u32, sizeof(bs_room_view_data));
+    if (room->views == NULL) {
+      return false;
+    }
+  }
+  room->view_count = (size_t)view_count_u32;
+  for (size_t j = 0; j < room->view_count; j++) {
+    bs_room_view_data *view = &room->views[j];
+    uint32_t vp = 0;
+    uint32_t enabled = 0;
+    if (!read_u32_le(data, view_list_ptr + 4 + (uint32_t)(j * 4), &vp) ||
+        !read_u32_le(data, vp + 0, &enabled) ||
+        !read_i32_le(data, vp + 4, &view->view_x) ||
+        !read_i32_le(data, vp + 8, &view->view_y) ||
+        !read_i32_le(data, vp + 12, &view->view_w) ||
+        !read_i32_le(data, vp + 16, &view->view_h) ||
+        !read_i32_le(data, vp + 20, &view->port_x) ||
+        !read_i32_le(data, vp + 24, &view->port_y) ||
+        !read_i32_le(data, vp + 28, &view->port_w) ||
+        !read_i32_le(data, vp + 32, &view->port_h) ||
+        !read_i32_le(data, vp + 36, &view->border_h) ||
+        !read_i32_le(data, vp + 40, &view->border_v) ||
+        !read_i32_le(data, vp + 44, &view->speed_h) ||
+        !read_i32_le(data, vp + 48, &view->speed_v) ||
+        !read_i32_le(data, vp + 52, &view->follow_object_id)) {
+      return false;
+    }
+    view->enabled = (enabled != 0);
+  }
+
+  if (!read_u32_le(data, obj_list_ptr, &instance_count_u32)) {
+    return false;
+  }
+  if (instance_count_u32 > 0) {
+    room->instances = (bs_room_instance_data *)arena_calloc(arena, (size_t)instance_count_u32, sizeof(bs_room_instance_data));
+    if (room->instances == NULL) {
+      return false;
+    }
+  }
+  room->instance_count = (size_t)instance_count_u32;
+  for (size_t j = 0; j < room->instance_count; j++) {
+    bs_room_instance_data *instance = &room->instances[j];
+    uint32_t op = 0;
+    int32_t creation_code_raw_inst = -1;
+    if (!read_u32_le(data, obj_list_ptr + 4 + (uint32_t)(j * 4), &op) ||
+        !read_i32_le(data, op + 0, &instance->x) ||
+        !read_i32_le(data, op + 4, &instance->y) ||
+        !read_i32_le(data, op + 8, &instance->object_def_id) ||
+        !read_i32_le(data, op + 12, &instance->instance_id) ||
+        !read_i32_le(data, op + 16, &creation_code_raw_inst) ||
+        !read_f32_le(data, op + 20, &instance->scale_x) ||
+        !read_f32_le(data, op + 24, &instance->scale_y) ||
+        !read_u32_le(data, op + 28, &instance->color) ||
+        !read_f32_le(data, op + 32, &instance->rotation)) {
+      return false;
+    }
+    instance->creation_code_id =
+        (creation_code_raw_inst >= 0) ? resolve_code_index(data, creation_code_raw_inst) : -1;
+  }
 
-        for (size_t a = 0; a < action_count; a++) {
-          uint32_t action_ptr = 0;
-          int32_t raw_code_id = -1;
-          if (!read_u32_le(data, event_ptr + 8 + (uint32_t)(a * 4), &action_ptr) ||
-              !read_i32_le(data, action_ptr + 0x20, &raw_code_id)) {
-            free(actions);
-            for (size_t x = 0; x < e; x++) {
-              free(entries[x].actions);
-            }
-            free(entries);
-            for (size_t k = 0; k < event_type; k++) {
-              for (size_t m = 0; m < events[k].entry_count; m++) {
-                free(events[k].entries[m].actions);
-              }
-              free(events[k].entries);
-            }
-            free(events);
-            for (size_t j = 0; j < i; j++) {
-              free_object_data(&objects[j]);
-            }
-            free(objects);
-            return false;
-          }
-          actions[a].code_id = resolve_code_index(data, raw_code_id);
-        }
+  if (!read_u32_le(data, tile_list_ptr, &tile_count_u32)) {
+    return false;
+  }
+  if (tile_count_u32 > 0) {
+    room->tiles = (bs_room_tile_data *)arena_calloc(arena, (size_t)tile_count_u32, sizeof(bs_room_tile_data));
+    if (room->tiles == NULL) {
+      return false;
+    }
+  }
+  room->tile_count = (size_t)tile_count_u32;
+  for (size_t j = 0; j < room->tile_count; j++) {
+    bs_room_tile_data *tile = &room->tiles[j];
+    uint32_t tp = 0;
+    if (!read_u32_le(data, tile_list_ptr + 4 + (uint32_t)(j * 4), &tp) ||
+        !read_i32_le(data, tp + 0, &tile->x) ||
+        !read_i32_le(data, tp + 4, &tile->y) ||
+        !read_i32_le(data, tp + 8, &tile->bg_def_index) ||
+        !read_i32_le(data, tp + 12, &tile->source_x) ||
+        !read_i32_le(data, tp + 16, &tile->source_y) ||
+        !read_i32_le(data, tp + 20, &tile->width) ||
+        !read_i32_le(data, tp + 24, &tile->height) ||
+        !read_i32_le(data, tp + 28, &tile->depth) ||
+        !read_i32_le(data, tp + 32, &tile->instance_id) ||
+        !read_f32_le(data, tp + 36, &tile->scale_x) ||
+        !read_f32_le(data, tp + 40, &tile->scale_y) ||
+        !read_u32_le(data, tp + 44, &tile->color)) {
+      return false;
+    }
+  }
 
-        entries[e].subtype = subtype;
-        entries[e].actions = actions;
-        entries[e].action_count = action_count;
-      }
+  room->name = read_string_ref(data, arena, name_ptr);
+  room->caption = read_string_ref(data, arena, caption_ptr);
+  return room->name != NULL && room->caption != NULL;
+}
+
+const bs_sprite_data *bs_game_data_sprite(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint8_t state = asset_slot(data, &data->sprite_assets, index, &ptr);
+  bs_sprite_data *sprite = NULL;
+  if (state == BS_ASSET_FAILED) {
+    return NULL;
+  }
 
-      events[event_type].entries = entries;
-      events[event_type].entry_count = sub_event_count;
+  sprite = &data->sprite_cache[(size_t)index];
+  if (state == BS_ASSET_UNPARSED) {
+    if (!materialize_sprite(data, &data->arenas[BS_DATA_ARENA_SPRT], ptr, sprite)) {
+      /* Partial allocations stay in the arena until teardown; the slot is never retried. */
+      memset(sprite, 0, sizeof(*sprite));
+      mark_asset_failed(&data->sprite_assets, index, "SPRT");
+      return NULL;
     }
+    data->sprite_assets.states[(size_t)index] = BS_ASSET_READY;
+  }
+  return sprite;
+}
 
-    objects[i].name = read_string_ref(data, name_ptr);
-    if (objects[i].name == NULL) {
-      for (size_t k = 0; k < event_type_count; k++) {
-        for (size_t m = 0; m < events[k].entry_count; m++) {
-          free(events[k].entries[m].actions);
-        }
-        free(events[k].entries);
-      }
-      free(events);
-      for (size_t j = 0; j < i; j++) {
-        free_object_data(&objects[j]);
-      }
-      free(objects);
-      return false;
+const bs_path_data *bs_game_data_path(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint8_t state = asset_slot(data, &data->path_assets, index, &ptr);
+  bs_path_data *path = NULL;
+  if (state == BS_ASSET_FAILED) {
+    return NULL;
+  }
+
+  path = &data->path_cache[(size_t)index];
+  if (state == BS_ASSET_UNPARSED) {
+    if (!materialize_path(data, &data->arenas[BS_DATA_ARENA_PATH], ptr, path)) {
+      /* Partial allocations stay in the arena until teardown; the slot is never retried. */
+      memset(path, 0, sizeof(*path));
+      mark_asset_failed(&data->path_assets, index, "PATH");
+      return NULL;
     }
-    objects[i].sprite_index = sprite_index;
-    objects[i].visible = (visible_u32 != 0);
-    objects[i].solid = (solid_u32 != 0);
-    objects[i].depth = depth;
-    objects[i].persistent = (persistent_u32 != 0);
-    objects[i].parent_id = parent_id;
-    objects[i].mask_id = mask_id;
-    objects[i].events = events;
-    objects[i].event_type_count = event_type_count;
+    data->path_assets.states[(size_t)index] = BS_ASSET_READY;
   }
+  return path;
+}
+
+const bs_font_data *bs_game_data_font(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint8_t state = asset_slot(data, &data->font_assets, index, &ptr);
+  bs_font_data *font = NULL;
+  if (state == BS_ASSET_FAILED) {
+    return NULL;
+  }
+
+  font = &data->font_cache[(size_t)index];
+  if (state == BS_ASSET_UNPARSED) {
+    if (!materialize_font(data, &data->arenas[BS_DATA_ARENA_FONT], ptr, font)) {
+      /* Partial allocations stay in the arena until teardown; the slot is never retried. */
+      memset(font, 0, sizeof(*font));
+      mark_asset_failed(&data->font_assets, index, "FONT");
+      return NULL;
+    }
+    data->font_assets.states[(size_t)index] = BS_ASSET_READY;
+  }
+  return font;
+}
+
+const bs_game_object_data *bs_game_data_object(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint8_t state = asset_slot(data, &data->object_assets, index, &ptr);
+  bs_game_object_data *obj = NULL;
+  if (state == BS_ASSET_FAILED) {
+    return NULL;
+  }
+
+  obj = &data->object_cache[(size_t)index];
+  if (state == BS_ASSET_UNPARSED) {
+    if (!materialize_object(data, &data->arenas[BS_DATA_ARENA_OBJT], ptr, obj)) {
+      /* Partial allocations stay in the arena until teardown; the slot is never retried. */
+      memset(obj, 0, sizeof(*obj));
+      mark_asset_failed(&data->object_assets, index, "OBJT");
+      return NULL;
+    }
+    data->object_assets.states[(size_t)index] = BS_ASSET_READY;
+  }
+  return obj;
+}
+
+const bs_room_data *bs_game_data_room(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint8_t state = asset_slot(data, &data->room_assets, index, &ptr);
+  bs_room_data *room = NULL;
+  if (state == BS_ASSET_FAILED) {
+    return NULL;
+  }
+
+  room = &data->room_cache[(size_t)index];
+  if (state == BS_ASSET_UNPARSED) {
+    if (!materialize_room(data, &data->arenas[BS_DATA_ARENA_ROOM], ptr, room)) {
+      /* Partial allocations stay in the arena until teardown; the slot is never retried. */
+      memset(room, 0, sizeof(*room));
+      mark_asset_failed(&data->room_assets, index, "ROOM");
+      return NULL;
+    }
+    data->room_assets.states[(size_t)index] = BS_ASSET_READY;
+  }
+  return room;
+}
+
+bool bs_game_data_room_persistent(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  uint32_t persistent_u32 = 0;
+  uint8_t state = asset_slot(data, &data->room_assets, index, &ptr);
+  if (state == BS_ASSET_READY) {
+    return data->room_cache[(size_t)index].persistent;
+  }
+  /* Read the header flag directly so scanning every room does not materialize it. */
+  return state == BS_ASSET_UNPARSED && read_u32_le(data, ptr + 0x14, &persistent_u32) && persistent_u32 != 0;
+}
 
-  data->objects = objects;
-  data->object_count = count;
-  printf("  OBJT: %u objects\n", count_u32);
+int32_t bs_game_data_object_parent(const bs_game_data *data, int32_t index) {
+  uint32_t ptr = 0;
+  int32_t parent_id = -1;
+  uint8_t state = asset_slot(data, &data->object_assets, index, &ptr);
+  if (state == BS_ASSET_READY) {
+    return data->object_cache[(size_t)index].parent_id;
+  }
+  /* Same header read as room_persistent: building ancestry tables leaves the objects unparsed. */
+  if (state != BS_ASSET_UNPARSED || !read_i32_le(data, ptr + 0x18, &parent_id)) {
+    return -1;
+  }
+  return parent_id;
+}
+
+size_t bs_game_data_materialized_asset_count(const bs_game_data *data) {
+  if (data == NULL) {
+    return 0;
+  }
+  return asset_ready_count(&data->sprite_assets) +
+         asset_ready_count(&data->path_assets) +
+         asset_ready_count(&data->font_assets) +
+         asset_ready_count(&data->object_assets) +
+         asset_ready_count(&data->room_assets);
+}
+
+static bool parse_sprt(bs_game_data *data, char *summary, size_t summary_size) {
+  void *cache = NULL;
+  if (!index_asset_chunk(data, "SPRT", false, sizeof(bs_sprite_data), &data->arenas[BS_DATA_ARENA_SPRT],
+                         &data->sprite_assets, &cache, &data->sprite_count)) {
+    return false;
+  }
+  data->sprite_cache = (bs_sprite_data *)cache;
+  (void)snprintf(summary, summary_size, "  SPRT: %zu sprites\n", data->sprite_count);
   return true;
 }
 
-static bool parse_room(bs_game_data *data) {
-  const bs_chunk_info *chunk = find_chunk(data, "ROOM");
-  if (chunk == NULL) {
+static bool parse_path(bs_game_data *data, char *summary, size_t summary_size) {
+  void *cache = NULL;
+  if (!index_asset_chunk(data, "PATH", false, sizeof(bs_path_data), &data->arenas[BS_DATA_ARENA_PATH],
+                         &data->path_assets, &cache, &data->path_count)) {
     return false;
   }
+  data->path_cache = (bs_path_data *)cache;
+  (void)snprintf(summary, summary_size, "  PATH: %zu paths\n", data->path_count);
+  return true;
+}
 
-  uint32_t count_u32 = 0;
-  if (!read_u32_le(data, chunk->data_offset, &count_u32)) {
+static bool parse_font(bs_game_data *data, char *summary, size_t summary_size) {
+  void *cache = NULL;
+  if (!index_asset_chunk(data, "FONT", false, sizeof(bs_font_data), &data->arenas[BS_DATA_ARENA_FONT],
+                         &data->font_assets, &cache, &data->font_count)) {
     return false;
   }
-  size_t count = (size_t)count_u32;
+  data->font_cache = (bs_font_data *)cache;
+  (void)snprintf(summary, summary_size, "  FONT: %zu fonts\n", data->font_count);
+  return true;
+}
 
-  if (!can_read_range(data->file_size, chunk->data_offset + 4, count * sizeof(uint32_t))) {
+static bool parse_objt(bs_game_data *data, char *summary, size_t summary_size) {
+  void *cache = NULL;
+  if (!index_asset_chunk(data, "OBJT", true, sizeof(bs_game_object_data), &data->arenas[BS_DATA_ARENA_OBJT],
+                         &data->object_assets, &cache, &data->object_count)) {
     return false;
   }
+  data->object_cache = (bs_game_object_data *)cache;
+  (void)snprintf(summary, summary_size, "  OBJT: %zu objects\n", data->object_count);
+  return true;
+}
 
-  bs_room_data *rooms = NULL;
-  if (count > 0) {
-    rooms = (bs_room_data *)calloc(count, sizeof(bs_room_data));
-    if (rooms == NULL) {
+static bool parse_room(bs_game_data *data, char *summary, size_t summary_size) {
+  void *cache = NULL;
+  if (!index_asset_chunk(data, "ROOM", true, sizeof(bs_room_data), &data->arenas[BS_DATA_ARENA_ROOM],
+                         &data->room_assets, &cache, &data->room_count)) {
+    return false;
+  }
+  data->room_cache = (bs_room_data *)cache;
+  (void)snprintf(summary, summary_size, "  ROOM: %zu rooms\n", data->room_count);
+  return true;
+}
+
+/* BS_EAGER_ASSETS=1 restores load-time validation of every indexed record. */
+static bool materialize_all_assets(const bs_game_data *data) {
+  for (size_t i = 0; i < data->sprite_count; i++) {
+    if (bs_game_data_sprite(data, (int32_t)i) == NULL) {
       return false;
     }
   }
-
-  for (size_t i = 0; i < count; i++) {
-    uint32_t ptr = 0;
-    uint32_t name_ptr = 0;
-    uint32_t caption_ptr = 0;
-    int32_t width = 0;
-    int32_t height = 0;
-    int32_t speed = 0;
-    uint32_t persistent_u32 = 0;
-    uint32_t bg_color = 0;
-    uint32_t draw_bg_color_u32 = 0;
-    int32_t creation_code_raw = -1;
-    uint32_t flags = 0;
-    uint32_t bg_list_ptr = 0;
-    uint32_t view_list_ptr = 0;
-    uint32_t obj_list_ptr = 0;
-    uint32_t tile_list_ptr = 0;
-
-    if (!read_u32_le(data, chunk->data_offset + 4 + (uint32_t)(i * 4), &ptr) ||
-        !read_u32_le(data, ptr + 0, &name_ptr) ||
-        !read_u32_le(data, ptr + 4, &caption_ptr) ||
-        !read_i32_le(data, ptr + 8, &width) ||
-        !read_i32_le(data, ptr + 0x0C, &height) ||
-        !read_i32_le(data, ptr + 0x10, &speed) ||
-        !read_u32_le(data, ptr + 0x14, &persistent_u32) ||
-        !read_u32_le(data, ptr + 0x18, &bg_color) ||
-        !read_u32_le(data, ptr + 0x1C, &draw_bg_color_u32) ||
-        !read_i32_le(data, ptr + 0x20, &creation_code_raw) ||
-        !read_u32_le(data, ptr + 0x24, &flags) ||
-        !read_u32_le(data, ptr + 0x28, &bg_list_ptr) ||
-        !read_u32_le(data, ptr + 0x2C, &view_list_ptr) ||
-        !read_u32_le(data, ptr + 0x30, &obj_list_ptr) ||
-        !read_u32_le(data, ptr + 0x34, &tile_list_ptr)) {
-      for (size_t j = 0; j < i; j++) {
-        free_room_data(&rooms[j]);
-      }
-      free(rooms);
+  for (size_t i = 0; i < data->path_count; i++) {
+    if (bs_game_data_path(data, (int32_t)i) == NULL) {
       return false;
     }
-
-    uint32_t bg_count_u32 = 0;
-    if (!read_u32_le(data, bg_list_ptr, &bg_count_u32)) {
-      for (size_t j = 0; j < i; j++) {
-        free_room_data(&rooms[j]);
-      }
-      free(rooms);
+  }
+  for (size_t i = 0; i < data->font_count; i++) {
+    if (bs_game_data_font(data, (int32_t)i) == NULL) {
       return false;
     }
-    size_t bg_count = (size_t)bg_count_u32;
-    bs_room_background_data *backgrounds = NULL;
-    if (bg_count > 0) {
-      backgrounds = (bs_room_background_data *)calloc(bg_count, sizeof(bs_room_background_data));
-      if (backgrounds == NULL) {
-        for (size_t j = 0; j < i; j++) {
-          free_room_data(&rooms[j]);
-        }
-        free(rooms);
-        return false;
-      }
+  }
+  for (size_t i = 0; i < data->object_count; i++) {
+    if (bs_game_data_object(data, (int32_t)i) == NULL) {
+      return false;
     }
-    for (size_t j = 0; j < bg_count; j++) {
-      uint32_t bp = 0;
-      uint32_t enabled = 0;
-      uint32_t foreground = 0;
-      int32_t bg_def_index = 0;
-      int32_t x = 0;
-      int32_t y = 0;
-      uint32_t tile_x = 0;
-      uint32_t tile_y = 0;
-      int32_t speed_x = 0;
-      int32_t speed_y = 0;
-      uint32_t stretch = 0;
-      if (!read_u32_le(data, bg_list_ptr + 4 + (uint32_t)(j * 4), &bp) ||
-          !read_u32_le(data, bp + 0, &enabled) ||
-          !read_u32_le(data, bp + 4, &foreground) ||
-          !read_i32_le(data, bp + 8, &bg_def_index) ||
-          !read_i32_le(data, bp + 12, &x) ||
-          !read_i32_le(data, bp + 16, &y) ||
-          !read_u32_le(data, bp + 20, &tile_x) ||
-          !read_u32_le(data, bp + 24, &tile_y) ||
-          !read_i32_le(data, bp + 28, &speed_x) ||
-          !read_i32_le(data, bp + 32, &speed_y) ||
-          !read_u32_le(data, bp + 36, &stretch)) {
-        free(backgrounds);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
-      }
-      backgrounds[j].enabled = (enabled != 0);
-      backgrounds[j].foreground = (foreground != 0);
-      backgrounds[j].bg_def_index = bg_def_index;
-      backgrounds[j].x = x;
-      backgrounds[j].y = y;
-      backgrounds[j].tile_x = (tile_x != 0);
-      backgrounds[j].tile_y = (tile_y != 0);
-      backgrounds[j].speed_x = speed_x;
-      backgrounds[j].speed_y = speed_y;
-      backgrounds[j].stretch = (stretch != 0);
-    }
-
-    uint32_t view_count_u32 = 0;
-    if (!read_u32_le(data, view_list_ptr, &view_count_u32)) {
-      free(backgrounds);
-      for (size_t k = 0; k < i; k++) {
-        free_room_data(&rooms[k]);
-      }
-      free(rooms);
+  }
+  for (size_t i = 0; i < data->room_count; i++) {
+    if (bs_game_data_room(data, (int32_t)i) == NULL) {
       return false;
     }
-    size_t view_count = (size_t)view_count_u32;
-    bs_room_view_data *views = NULL;
-    if (view_count > 0) {
-      views = (bs_room_view_data *)calloc(view_count, sizeof(bs_room_view_data));
-      if (views == NULL) {
-        free(backgrounds);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
-      }
+  }
+  return true;
+}
+
+/* Releases everything the chunk parsers own, leaving the file mapping and chunk table alone. Every
+ * parsed record lives in the per-chunk arenas, so teardown is a handful of block frees. */
+static void free_chunk_contents(bs_game_data *data) {
+  if (data->arenas != NULL) {
+    for (size_t i = 0; i < BS_DATA_ARENA_COUNT; i++) {
+      arena_release(&data->arenas[i]);
     }
-    for (size_t j = 0; j < view_count; j++) {
-      uint32_t vp = 0;
-      uint32_t enabled = 0;
-      if (!read_u32_le(data, view_list_ptr + 4 + (uint32_t)(j * 4), &vp) ||
-          !read_u32_le(data, vp + 0, &enabled) ||
-          !read_i32_le(data, vp + 4, &views[j].view_x) ||
-          !read_i32_le(data, vp + 8, &views[j].view_y) ||
-          !read_i32_le(data, vp + 12, &views[j].view_w) ||
-          !read_i32_le(data, vp + 16, &views[j].view_h) ||
-          !read_i32_le(data, vp + 20, &views[j].port_x) ||
-          !read_i32_le(data, vp + 24, &views[j].port_y) ||
-          !read_i32_le(data, vp + 28, &views[j].port_w) ||
-          !read_i32_le(data, vp + 32, &views[j].port_h) ||
-          !read_i32_le(data, vp + 36, &views[j].border_h) ||
-          !read_i32_le(data, vp + 40, &views[j].border_v) ||
-          !read_i32_le(data, vp + 44, &views[j].speed_h) ||
-          !read_i32_le(data, vp + 48, &views[j].speed_v) ||
-          !read_i32_le(data, vp + 52, &views[j].follow_object_id)) {
-        free(backgrounds);
-        free(views);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
-      }
-      views[j].enabled = (enabled != 0);
+  }
+  free(data->arenas);
+  data->arenas = NULL;
+
+  data->strings = NULL;
+  data->string_count = 0;
+
+  data->gen8.game_name = NULL;
+  data->gen8.display_name = NULL;
+  data->gen8.room_order = NULL;
+  data->gen8.room_order_count = 0;
+  data->gen8.bytecode_version = 0;
+  data->gen8.game_id = 0;
+  data->gen8.window_width = 0;
+  data->gen8.window_height = 0;
+
+  data->texture_page_items = NULL;
+  data->texture_page_item_offsets = NULL;
+  data->texture_page_item_count = 0;
+  data->texture_pages = NULL;
+  data->texture_page_count = 0;
+
+  data->backgrounds = NULL;
+  data->background_count = 0;
+  data->code_entries = NULL;
+  data->code_entry_count = 0;
+  data->sounds = NULL;
+  data->sound_count = 0;
+  data->audio_data = NULL;
+  data->audio_data_count = 0;
+  data->scripts = NULL;
+  data->script_count = 0;
+  data->variables = NULL;
+  data->variable_count = 0;
+  data->functions = NULL;
+  data->function_count = 0;
+
+  data->sprite_cache = NULL;
+  data->sprite_count = 0;
+  memset(&data->sprite_assets, 0, sizeof(data->sprite_assets));
+  data->path_cache = NULL;
+  data->path_count = 0;
+  memset(&data->path_assets, 0, sizeof(data->path_assets));
+  data->font_cache = NULL;
+  data->font_count = 0;
+  memset(&data->font_assets, 0, sizeof(data->font_assets));
+  data->object_cache = NULL;
+  data->object_count = 0;
+  memset(&data->object_assets, 0, sizeof(data->object_assets));
+  data->room_cache = NULL;
+  data->room_count = 0;
+  memset(&data->room_assets, 0, sizeof(data->room_assets));
+}
+
+/* The chunk each arena's parser reads, in bs_data_arena order. */
+static const char *const k_arena_chunk_tags[BS_DATA_ARENA_COUNT] = {
+    "STRG", "GEN8", "TPAG", "TXTR", "SPRT", "BGND", "PATH", "FONT",
+    "SOND", "AUDO", "CODE", "OBJT", "ROOM", "SCPT", "VARI", "FUNC",
+};
+
+/* Sizes each arena's first block from its chunk, so the small chunks of a small game do not each
+ * reserve a full block. */
+static bool init_chunk_arenas(bs_game_data *data) {
+  data->arenas = (bs_arena *)calloc(BS_DATA_ARENA_COUNT, sizeof(bs_arena));
+  if (data->arenas == NULL) {
+    return false;
+  }
+  for (size_t i = 0; i < BS_DATA_ARENA_COUNT; i++) {
+    const bs_chunk_info *chunk = find_chunk(data, k_arena_chunk_tags[i]);
+    size_t first_block = (chunk != NULL) ? (size_t)chunk->size : 0;
+    if (first_block < BS_ARENA_MIN_BLOCK_SIZE) {
+      first_block = BS_ARENA_MIN_BLOCK_SIZE;
+    } else if (first_block > BS_ARENA_BLOCK_SIZE) {
+      first_block = BS_ARENA_BLOCK_SIZE;
     }
+    data->arenas[i].next_block = first_block;
+  }
+  return true;
+}
 
-    uint32_t instance_count_u32 = 0;
-    if (!read_u32_le(data, obj_list_ptr, &instance_count_u32)) {
-      free(backgrounds);
-      free(views);
-      for (size_t k = 0; k < i; k++) {
-        free_room_data(&rooms[k]);
-      }
-      free(rooms);
-      return false;
+size_t bs_game_data_arena_bytes(const bs_game_data *data, size_t *out_reserved, size_t *out_allocations) {
+  size_t used = 0;
+  size_t reserved = 0;
+  size_t allocations = 0;
+  if (data != NULL && data->arenas != NULL) {
+    for (size_t i = 0; i < BS_DATA_ARENA_COUNT; i++) {
+      used += data->arenas[i].used_bytes;
+      reserved += data->arenas[i].reserved_bytes;
+      allocations += data->arenas[i].allocation_count;
     }
-    size_t instance_count = (size_t)instance_count_u32;
-    bs_room_instance_data *instances = NULL;
-    if (instance_count > 0) {
-      instances = (bs_room_instance_data *)calloc(instance_count, sizeof(bs_room_instance_data));
-      if (instances == NULL) {
-        free(backgrounds);
-        free(views);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
+  }
+  if (out_reserved != NULL) {
+    *out_reserved = reserved;
+  }
+  if (out_allocations != NULL) {
+    *out_allocations = allocations;
+  }
+  return used;
+}
+
+#define BS_CHUNK_SUMMARY_SIZE 160u
+#define BS_MAX_LOAD_THREADS 16u
+
+typedef bool (*bs_chunk_parse_fn)(bs_game_data *data, char *summary, size_t summary_size);
+
+typedef struct bs_chunk_parser {
+  const char *tag;
+  bs_chunk_parse_fn parse;
+  const char *after;
+} bs_chunk_parser;
+
+/* Record lookups (string refs, code ids, texture items inside lazily parsed assets) happen
+ * after loading, so the only load-time edge is BGND resolving TPAG item offsets. */
+static const bs_chunk_parser k_chunk_parsers[] = {
+    {"STRG", parse_strg, NULL},
+    {"GEN8", parse_gen8, NULL},
+    {"TPAG", parse_tpag, NULL},
+    {"TXTR", parse_txtr, NULL},
+    {"SPRT", parse_sprt, NULL},
+    {"BGND", parse_bgnd, "TPAG"},
+    {"PATH", parse_path, NULL},
+    {"FONT", parse_font, NULL},
+    {"SOND", parse_sond, NULL},
+    {"AUDO", parse_audo, NULL},
+    {"CODE", parse_code, NULL},
+    {"OBJT", parse_objt, NULL},
+    {"ROOM", parse_room, NULL},
+    {"SCPT", parse_scpt, NULL},
+    {"VARI", parse_vari, NULL},
+    {"FUNC", parse_func, NULL},
+};
+
+#define BS_CHUNK_PARSER_COUNT (sizeof(k_chunk_parsers) / sizeof(k_chunk_parsers[0]))
+
+typedef struct bs_chunk_schedule {
+  bs_game_data *data;
+  size_t dependency[BS_CHUNK_PARSER_COUNT];
+  bool claimed[BS_CHUNK_PARSER_COUNT];
+  bool done[BS_CHUNK_PARSER_COUNT];
+  bool ok[BS_CHUNK_PARSER_COUNT];
+  char summaries[BS_CHUNK_PARSER_COUNT][BS_CHUNK_SUMMARY_SIZE];
+  double millis[BS_CHUNK_PARSER_COUNT];
+#if defined(BS_HAVE_PTHREADS)
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+#endif
+} bs_chunk_schedule;
+
+static double now_millis(void) {
+  struct timespec ts;
+  if (timespec_get(&ts, TIME_UTC) == TIME_UTC) {
+    return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+  }
+  return 0.0;
+}
+
+static void init_chunk_schedule(bs_chunk_schedule *schedule, bs_game_data *data) {
+  memset(schedule, 0, sizeof(*schedule));
+  schedule->data = data;
+  for (size_t i = 0; i < BS_CHUNK_PARSER_COUNT; i++) {
+    schedule->dependency[i] = BS_CHUNK_PARSER_COUNT;
+    for (size_t j = 0; j < i && k_chunk_parsers[i].after != NULL; j++) {
+      if (strcmp(k_chunk_parsers[j].tag, k_chunk_parsers[i].after) == 0) {
+        schedule->dependency[i] = j;
       }
     }
-    for (size_t j = 0; j < instance_count; j++) {
-      uint32_t op = 0;
-      int32_t creation_code_raw_inst = -1;
-      if (!read_u32_le(data, obj_list_ptr + 4 + (uint32_t)(j * 4), &op) ||
-          !read_i32_le(data, op + 0, &instances[j].x) ||
-          !read_i32_le(data, op + 4, &instances[j].y) ||
-          !read_i32_le(data, op + 8, &instances[j].object_def_id) ||
-          !read_i32_le(data, op + 12, &instances[j].instance_id) ||
-          !read_i32_le(data, op + 16, &creation_code_raw_inst) ||
-          !read_f32_le(data, op + 20, &instances[j].scale_x) ||
-          !read_f32_le(data, op + 24, &instances[j].scale_y) ||
-          !read_u32_le(data, op + 28, &instances[j].color) ||
-          !read_f32_le(data, op + 32, &instances[j].rotation)) {
-        free(backgrounds);
-        free(views);
-        free(instances);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
-      }
-      instances[j].creation_code_id =
-          (creation_code_raw_inst >= 0) ? resolve_code_index(data, creation_code_raw_inst) : -1;
+  }
+}
+
+static void run_chunk_parser(bs_chunk_schedule *schedule, size_t index) {
+  size_t dep = schedule->dependency[index];
+  double start_millis = 0.0;
+  schedule->summaries[index][0] = '\0';
+  if (dep < BS_CHUNK_PARSER_COUNT && !schedule->ok[dep]) {
+    schedule->ok[index] = false;
+    return;
+  }
+  start_millis = now_millis();
+  schedule->ok[index] =
+      k_chunk_parsers[index].parse(schedule->data, schedule->summaries[index], BS_CHUNK_SUMMARY_SIZE);
+  schedule->millis[index] = now_millis() - start_millis;
+}
+
+#if defined(BS_HAVE_PTHREADS)
+/* Claims the first unclaimed parser whose dependency has finished; returns COUNT when none is runnable. */
+static size_t claim_chunk_parser(bs_chunk_schedule *schedule, bool *out_all_claimed) {
+  *out_all_claimed = true;
+  for (size_t i = 0; i < BS_CHUNK_PARSER_COUNT; i++) {
+    size_t dep = schedule->dependency[i];
+    if (schedule->claimed[i]) {
+      continue;
+    }
+    *out_all_claimed = false;
+    if (dep < BS_CHUNK_PARSER_COUNT && !schedule->done[dep]) {
+      continue;
     }
+    schedule->claimed[i] = true;
+    return i;
+  }
+  return BS_CHUNK_PARSER_COUNT;
+}
 
-    uint32_t tile_count_u32 = 0;
-    if (!read_u32_le(data, tile_list_ptr, &tile_count_u32)) {
-      free(backgrounds);
-      free(views);
-      free(instances);
-      for (size_t k = 0; k < i; k++) {
-        free_room_data(&rooms[k]);
+static void *chunk_worker_main(void *arg) {
+  bs_chunk_schedule *schedule = (bs_chunk_schedule *)arg;
+  pthread_mutex_lock(&schedule->lock);
+  for (;;) {
+    bool all_claimed = false;
+    size_t index = claim_chunk_parser(schedule, &all_claimed);
+    if (index == BS_CHUNK_PARSER_COUNT) {
+      if (all_claimed) {
+        break;
       }
-      free(rooms);
-      return false;
+      pthread_cond_wait(&schedule->changed, &schedule->lock);
+      continue;
     }
-    size_t tile_count = (size_t)tile_count_u32;
-    bs_room_tile_data *tiles = NULL;
-    if (tile_count > 0) {
-      tiles = (bs_room_tile_data *)calloc(tile_count, sizeof(bs_room_tile_data));
-      if (tiles == NULL) {
-        free(backgrounds);
-        free(views);
-        free(instances);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
-        }
-        free(rooms);
-        return false;
-      }
+
+    pthread_mutex_unlock(&schedule->lock);
+    run_chunk_parser(schedule, index);
+    pthread_mutex_lock(&schedule->lock);
+    schedule->done[index] = true;
+    pthread_cond_broadcast(&schedule->changed);
+  }
+  pthread_mutex_unlock(&schedule->lock);
+  return NULL;
+}
+#endif
+
+/* Runs every chunk parser; thread_count 1 is the sequential debug path in table order. When
+ * out_millis is set it receives each parser's own run time, indexed like k_chunk_parsers. */
+static bool parse_chunks(bs_game_data *data, size_t thread_count, bool print_summaries, double *out_millis) {
+  bs_chunk_schedule *schedule = (bs_chunk_schedule *)malloc(sizeof(bs_chunk_schedule));
+  bool ok = true;
+  bool ran_parallel = false;
+
+  if (schedule == NULL) {
+    return false;
+  }
+  init_chunk_schedule(schedule, data);
+
+#if defined(BS_HAVE_PTHREADS)
+  if (thread_count > 1) {
+    pthread_t threads[BS_MAX_LOAD_THREADS];
+    size_t started = 0;
+    if (thread_count > BS_CHUNK_PARSER_COUNT) {
+      thread_count = BS_CHUNK_PARSER_COUNT;
     }
-    for (size_t j = 0; j < tile_count; j++) {
-      uint32_t tp = 0;
-      if (!read_u32_le(data, tile_list_ptr + 4 + (uint32_t)(j * 4), &tp) ||
-          !read_i32_le(data, tp + 0, &tiles[j].x) ||
-          !read_i32_le(data, tp + 4, &tiles[j].y) ||
-          !read_i32_le(data, tp + 8, &tiles[j].bg_def_index) ||
-          !read_i32_le(data, tp + 12, &tiles[j].source_x) ||
-          !read_i32_le(data, tp + 16, &tiles[j].source_y) ||
-          !read_i32_le(data, tp + 20, &tiles[j].width) ||
-          !read_i32_le(data, tp + 24, &tiles[j].height) ||
-          !read_i32_le(data, tp + 28, &tiles[j].depth) ||
-          !read_i32_le(data, tp + 32, &tiles[j].instance_id) ||
-          !read_f32_le(data, tp + 36, &tiles[j].scale_x) ||
-          !read_f32_le(data, tp + 40, &tiles[j].scale_y) ||
-          !read_u32_le(data, tp + 44, &tiles[j].color)) {
-        free(backgrounds);
-        free(views);
-        free(instances);
-        free(tiles);
-        for (size_t k = 0; k < i; k++) {
-          free_room_data(&rooms[k]);
+    if (pthread_mutex_init(&schedule->lock, NULL) == 0) {
+      if (pthread_cond_init(&schedule->changed, NULL) == 0) {
+        for (size_t t = 0; t + 1 < thread_count; t++) {
+          if (pthread_create(&threads[t], NULL, chunk_worker_main, schedule) != 0) {
+            break;
+          }
+          started++;
         }
-        free(rooms);
-        return false;
+        /* The calling thread joins in, so the schedule drains even if no worker started. */
+        (void)chunk_worker_main(schedule);
+        for (size_t t = 0; t < started; t++) {
+          pthread_join(threads[t], NULL);
+        }
+        pthread_cond_destroy(&schedule->changed);
+        ran_parallel = true;
       }
+      pthread_mutex_destroy(&schedule->lock);
     }
+  }
+#else
+  (void)thread_count;
+#endif
 
-    rooms[i].name = read_string_ref(data, name_ptr);
-    rooms[i].caption = read_string_ref(data, caption_ptr);
-    if (rooms[i].name == NULL || rooms[i].caption == NULL) {
-      free(rooms[i].name);
-      free(rooms[i].caption);
-      free(backgrounds);
-      free(views);
-      free(instances);
-      free(tiles);
-      for (size_t k = 0; k < i; k++) {
-        free_room_data(&rooms[k]);
-      }
-      free(rooms);
-      return false;
+  if (!ran_parallel) {
+    for (size_t i = 0; i < BS_CHUNK_PARSER_COUNT; i++) {
+      run_chunk_parser(schedule, i);
+      schedule->done[i] = true;
     }
+  }
 
-    rooms[i].width = width;
-    rooms[i].height = height;
-    rooms[i].speed = speed;
-    rooms[i].persistent = (persistent_u32 != 0);
-    rooms[i].bg_color = bg_color;
-    rooms[i].draw_bg_color = (draw_bg_color_u32 != 0);
-    rooms[i].creation_code_id =
-        (creation_code_raw >= 0) ? resolve_code_index(data, creation_code_raw) : -1;
-    rooms[i].flags = flags;
-    rooms[i].backgrounds = backgrounds;
-    rooms[i].background_count = bg_count;
-    rooms[i].views = views;
-    rooms[i].view_count = view_count;
-    rooms[i].instances = instances;
-    rooms[i].instance_count = instance_count;
-    rooms[i].tiles = tiles;
-    rooms[i].tile_count = tile_count;
-  }
-
-  data->rooms = rooms;
-  data->room_count = count;
-  printf("  ROOM: %u rooms\n", count_u32);
-  return true;
+  for (size_t i = 0; i < BS_CHUNK_PARSER_COUNT; i++) {
+    if (print_summaries && schedule->ok[i]) {
+      fputs(schedule->summaries[i], stdout);
+    }
+    ok = ok && schedule->ok[i];
+    if (out_millis != NULL) {
+      out_millis[i] = schedule->millis[i];
+    }
+  }
+  free(schedule);
+  return ok;
+}
+
+/* Parses loaded's chunks again on thread_count threads into out_scratch, which shares the file
+ * bytes and chunk table with loaded. Used by the bench to check the parallel loader. */
+bool bs_form_reader_reparse(const bs_game_data *loaded, size_t thread_count, bs_game_data *out_scratch) {
+  if (loaded == NULL || out_scratch == NULL) {
+    return false;
+  }
+  memset(out_scratch, 0, sizeof(*out_scratch));
+  out_scratch->file_data = loaded->file_data;
+  out_scratch->file_size = loaded->file_size;
+  out_scratch->chunks = loaded->chunks;
+  out_scratch->chunk_count = loaded->chunk_count;
+  return init_chunk_arenas(out_scratch) && parse_chunks(out_scratch, thread_count, false, NULL);
+}
+
+/* Frees what bs_form_reader_reparse parsed, leaving the shared file bytes to their owner. */
+void bs_form_reader_free_reparse(bs_game_data *scratch) {
+  if (scratch != NULL) {
+    free_chunk_contents(scratch);
+  }
+}
+
+/* Parser i owns arenas[i] (the bs_data_arena order matches k_chunk_parsers), so the per-arena
+ * counters after parse_chunks are exactly what each parser allocated. */
+static size_t chunk_record_count(const bs_game_data *data, size_t parser_index) {
+  switch ((bs_data_arena)parser_index) {
+    case BS_DATA_ARENA_STRG: return data->string_count;
+    case BS_DATA_ARENA_GEN8: return data->gen8.room_order_count;
+    case BS_DATA_ARENA_TPAG: return data->texture_page_item_count;
+    case BS_DATA_ARENA_TXTR: return data->texture_page_count;
+    case BS_DATA_ARENA_SPRT: return data->sprite_count;
+    case BS_DATA_ARENA_BGND: return data->background_count;
+    case BS_DATA_ARENA_PATH: return data->path_count;
+    case BS_DATA_ARENA_FONT: return data->font_count;
+    case BS_DATA_ARENA_SOND: return data->sound_count;
+    case BS_DATA_ARENA_AUDO: return data->audio_data_count;
+    case BS_DATA_ARENA_CODE: return data->code_entry_count;
+    case BS_DATA_ARENA_OBJT: return data->object_count;
+    case BS_DATA_ARENA_ROOM: return data->room_count;
+    case BS_DATA_ARENA_SCPT: return data->script_count;
+    case BS_DATA_ARENA_VARI: return data->variable_count;
+    case BS_DATA_ARENA_FUNC: return data->function_count;
+    default: return 0;
+  }
+}
+
+static void record_parse_stats(bs_game_data *data, double wall_millis, const double *parser_millis) {
+  bs_load_phase *phase = bs_load_stats_add(&data->load_stats, "data", "parse_chunks", wall_millis);
+  if (phase != NULL) {
+    phase->items = BS_CHUNK_PARSER_COUNT;
+    phase->bytes = bs_game_data_arena_bytes(data, NULL, &phase->allocations);
+  }
+
+  for (size_t i = 0; i < BS_CHUNK_PARSER_COUNT; i++) {
+    char name[sizeof(phase->name)];
+    (void)snprintf(name, sizeof(name), "parse_%s", k_chunk_parsers[i].tag);
+    phase = bs_load_stats_add(&data->load_stats, "data", name, parser_millis[i]);
+    if (phase == NULL) {
+      break;
+    }
+    phase->items = chunk_record_count(data, i);
+    phase->allocations = data->arenas[i].allocation_count;
+    phase->bytes = data->arenas[i].used_bytes;
+    phase->detail = true;
+  }
 }
 
 bool bs_form_reader_read(const char *path, bs_game_data *out_data) {
+  size_t thread_count = bs_system_thread_count("BS_LOAD_THREADS", BS_MAX_LOAD_THREADS);
+  double load_start_millis = 0.0;
+  size_t arena_used = 0;
+  size_t arena_reserved = 0;
+  size_t arena_allocations = 0;
+  double phase_start_millis = 0.0;
+  double parser_millis[BS_CHUNK_PARSER_COUNT];
+  bs_load_phase *phase = NULL;
   if (path == NULL || out_data == NULL) {
     return false;
   }
@@ -2118,35 +2221,62 @@ bool bs_form_reader_read(const char *path, bs_game_data *out_data) {
   memset(out_data, 0, sizeof(*out_data));
   (void)snprintf(out_data->game_path, sizeof(out_data->game_path), "%s", path);
 
-  if (!load_file_bytes(path, &out_data->file_data, &out_data->file_size)) {
+  phase_start_millis = now_millis();
+  if (!open_game_file(path, out_data)) {
     return false;
   }
+  phase = bs_load_stats_add(&out_data->load_stats, "data", "open_file", now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->items = 1;
+    phase->allocations = out_data->file_mapped ? 0u : 1u;
+    phase->bytes = out_data->file_size;
+  }
+
+  phase_start_millis = now_millis();
   if (!discover_chunks(out_data)) {
     bs_game_data_free(out_data);
     return false;
   }
+  phase = bs_load_stats_add(&out_data->load_stats, "data", "discover_chunks", now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->items = out_data->chunk_count;
+    phase->allocations = 1;
+    phase->bytes = out_data->chunk_count * sizeof(bs_chunk_info);
+  }
 
   print_chunk_list(out_data);
+  printf("  FILE: %zu bytes (%s)\n", out_data->file_size, out_data->file_mapped ? "mapped" : "read");
 
-  if (!parse_strg(out_data) ||
-      !parse_gen8(out_data) ||
-      !parse_tpag(out_data) ||
-      !parse_txtr(out_data) ||
-      !parse_sprt(out_data) ||
-      !parse_bgnd(out_data) ||
-      !parse_path(out_data) ||
-      !parse_font(out_data) ||
-      !parse_sond(out_data) ||
-      !parse_audo(out_data) ||
-      !parse_code(out_data) ||
-      !parse_objt(out_data) ||
-      !parse_room(out_data) ||
-      !parse_scpt(out_data) ||
-      !parse_vari(out_data) ||
-      !parse_func(out_data)) {
+  load_start_millis = now_millis();
+  if (!init_chunk_arenas(out_data) || !parse_chunks(out_data, thread_count, true, parser_millis)) {
     bs_game_data_free(out_data);
     return false;
   }
+  record_parse_stats(out_data, now_millis() - load_start_millis, parser_millis);
+  arena_used = bs_game_data_arena_bytes(out_data, &arena_reserved, &arena_allocations);
+  printf("  LOAD: %zu chunk parsers on %zu thread%s in %.2f ms, arenas %zu/%zu bytes over %zu allocations\n",
+         BS_CHUNK_PARSER_COUNT,
+         thread_count,
+         thread_count == 1 ? "" : "s",
+         now_millis() - load_start_millis,
+         arena_used,
+         arena_reserved,
+         arena_allocations);
+  if (eager_assets_enabled()) {
+    size_t allocations_before = arena_allocations;
+    size_t used_before = arena_used;
+    phase_start_millis = now_millis();
+    if (!materialize_all_assets(out_data)) {
+      bs_game_data_free(out_data);
+      return false;
+    }
+    phase = bs_load_stats_add(&out_data->load_stats, "data", "eager_assets", now_millis() - phase_start_millis);
+    if (phase != NULL) {
+      phase->items = bs_game_data_materialized_asset_count(out_data);
+      phase->bytes = bs_game_data_arena_bytes(out_data, NULL, &phase->allocations) - used_before;
+      phase->allocations -= allocations_before;
+    }
+  }
 
   printf("Loaded bootstrap: SPRT=%zu, BGND=%zu, PATH=%zu, FONT=%zu, OBJT=%zu, ROOM=%zu, CODE=%zu, VARI=%zu, FUNC=%zu, SCPT=%zu, SOND=%zu, AUDO=%zu\n",
          out_data->sprite_count,
@@ -2170,127 +2300,26 @@ void bs_game_data_free(bs_game_data *data) {
     return;
   }
 
-  for (size_t i = 0; i < data->string_count; i++) {
-    free(data->strings[i]);
-  }
-  free(data->strings);
-  data->strings = NULL;
-  data->string_count = 0;
-
-  free(data->gen8.game_name);
-  free(data->gen8.display_name);
-  free(data->gen8.room_order);
-  data->gen8.game_name = NULL;
-  data->gen8.display_name = NULL;
-  data->gen8.room_order = NULL;
-  data->gen8.room_order_count = 0;
-  data->gen8.bytecode_version = 0;
-  data->gen8.game_id = 0;
-  data->gen8.window_width = 0;
-  data->gen8.window_height = 0;
-
-  free(data->texture_page_items);
-  free(data->texture_page_item_offsets);
-  data->texture_page_items = NULL;
-  data->texture_page_item_offsets = NULL;
-  data->texture_page_item_count = 0;
-
-  free(data->texture_pages);
-  data->texture_pages = NULL;
-  data->texture_page_count = 0;
-
-  for (size_t i = 0; i < data->sprite_count; i++) {
-    free_sprite_data(&data->sprites[i]);
-  }
-  free(data->sprites);
-  data->sprites = NULL;
-  data->sprite_count = 0;
-
-  for (size_t i = 0; i < data->background_count; i++) {
-    free_background_data(&data->backgrounds[i]);
-  }
-  free(data->backgrounds);
-  data->backgrounds = NULL;
-  data->background_count = 0;
-
-  for (size_t i = 0; i < data->path_count; i++) {
-    free_path_data(&data->paths[i]);
-  }
-  free(data->paths);
-  data->paths = NULL;
-  data->path_count = 0;
-
-  for (size_t i = 0; i < data->font_count; i++) {
-    free_font_data(&data->fonts[i]);
-  }
-  free(data->fonts);
-  data->fonts = NULL;
-  data->font_count = 0;
-
-  for (size_t i = 0; i < data->code_entry_count; i++) {
-    free(data->code_entries[i].name);
-    free(data->code_entries[i].bytecode);
-  }
-  free(data->code_entries);
-  data->code_entries = NULL;
-  data->code_entry_count = 0;
-
-  for (size_t i = 0; i < data->sound_count; i++) {
-    free(data->sounds[i].name);
-    free(data->sounds[i].extension);
-    free(data->sounds[i].file_name);
-  }
-  free(data->sounds);
-  data->sounds = NULL;
-  data->sound_count = 0;
-
-  free(data->audio_data);
-  data->audio_data = NULL;
-  data->audio_data_count = 0;
-
-  for (size_t i = 0; i < data->script_count; i++) {
-    free(data->scripts[i].name);
-  }
-  free(data->scripts);
-  data->scripts = NULL;
-  data->script_count = 0;
-
-  for (size_t i = 0; i < data->variable_count; i++) {
-    free(data->variables[i].name);
-  }
-  free(data->variables);
-  data->variables = NULL;
-  data->variable_count = 0;
-
-  for (size_t i = 0; i < data->function_count; i++) {
-    free(data->functions[i].name);
-  }
-  free(data->functions);
-  data->functions = NULL;
-  data->function_count = 0;
-
-  for (size_t i = 0; i < data->object_count; i++) {
-    free_object_data(&data->objects[i]);
-  }
-  free(data->objects);
-  data->objects = NULL;
-  data->object_count = 0;
-
-  for (size_t i = 0; i < data->room_count; i++) {
-    free_room_data(&data->rooms[i]);
-  }
-  free(data->rooms);
-  data->rooms = NULL;
-  data->room_count = 0;
+  free_chunk_contents(data);
 
   free(data->chunks);
   data->chunks = NULL;
   data->chunk_count = 0;
   data->form_size = 0;
 
-  free(data->file_data);
+  if (data->file_mapped) {
+    bs_file_view view;
+    view.bytes = data->file_data;
+    view.size = data->file_size;
+    view.mapping = data->file_mapping;
+    bs_system_unmap_file(&view);
+  } else {
+    free((void *)data->file_data);
+  }
   data->file_data = NULL;
   data->file_size = 0;
+  data->file_mapping = NULL;
+  data->file_mapped = false;
 
   data->game_path[0] = '\0';
 }
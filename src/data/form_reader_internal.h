@@ -0,0 +1,10 @@
+#ifndef BS_DATA_FORM_READER_INTERNAL_H
+#define BS_DATA_FORM_READER_INTERNAL_H
+
+#include "bs/data/form_reader.h"
+
+/* Loader entry points for the bench executable; not part of the public API. */
+bool bs_form_reader_reparse(const bs_game_data *loaded, size_t thread_count, bs_game_data *out_scratch);
+void bs_form_reader_free_reparse(bs_game_data *scratch);
+
+#endif
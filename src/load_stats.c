@@ -0,0 +1,131 @@
+#include "bs/load_stats.h"
+
+#include <string.h>
+
+void bs_load_stats_reset(bs_load_stats *stats) {
+  if (stats == NULL) {
+    return;
+  }
+  memset(stats, 0, sizeof(*stats));
+}
+
+/* Returns a zeroed phase with millis filled in, or NULL once the table is full so callers can
+ * keep going without stats. */
+bs_load_phase *bs_load_stats_add(bs_load_stats *stats, const char *stage, const char *name, double millis) {
+  bs_load_phase *phase = NULL;
+
+  if (stats == NULL || stats->phase_count >= BS_LOAD_STATS_MAX_PHASES) {
+    return NULL;
+  }
+
+  phase = &stats->phases[stats->phase_count++];
+  memset(phase, 0, sizeof(*phase));
+  (void)snprintf(phase->stage, sizeof(phase->stage), "%s", stage != NULL ? stage : "");
+  (void)snprintf(phase->name, sizeof(phase->name), "%s", name != NULL ? name : "");
+  phase->millis = millis;
+  phase->max_millis = millis;
+  return phase;
+}
+
+const bs_load_phase *bs_load_stats_find(const bs_load_stats *stats, const char *stage, const char *name) {
+  if (stats == NULL || stage == NULL || name == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < stats->phase_count; i++) {
+    if (strcmp(stats->phases[i].stage, stage) == 0 && strcmp(stats->phases[i].name, name) == 0) {
+      return &stats->phases[i];
+    }
+  }
+  return NULL;
+}
+
+void bs_load_stats_append(bs_load_stats *dst, const bs_load_stats *src) {
+  if (dst == NULL || src == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < src->phase_count && dst->phase_count < BS_LOAD_STATS_MAX_PHASES; i++) {
+    dst->phases[dst->phase_count++] = src->phases[i];
+  }
+}
+
+static void write_json_string(FILE *out, const char *text) {
+  fputc('"', out);
+  for (const char *p = text != NULL ? text : ""; *p != '\0'; p++) {
+    unsigned char c = (unsigned char)*p;
+    if (c == '"' || c == '\\') {
+      fputc('\\', out);
+      fputc((int)c, out);
+    } else if (c < 0x20u) {
+      fprintf(out, "\\u%04x", (unsigned)c);
+    } else {
+      fputc((int)c, out);
+    }
+  }
+  fputc('"', out);
+}
+
+/* Writes one JSON object; field names are stable so dumps can be diffed across builds. */
+bool bs_load_stats_write_json(const bs_load_stats *stats, const char *game_path, FILE *out) {
+  double total_millis = 0.0;
+  size_t total_allocations = 0;
+  size_t total_bytes = 0;
+
+  if (stats == NULL || out == NULL) {
+    return false;
+  }
+
+  fputs("{\n  \"game\": ", out);
+  write_json_string(out, game_path);
+  fputs(",\n  \"phases\": [", out);
+  for (size_t i = 0; i < stats->phase_count; i++) {
+    const bs_load_phase *phase = &stats->phases[i];
+    fputs(i == 0 ? "\n    {\"stage\": " : ",\n    {\"stage\": ", out);
+    write_json_string(out, phase->stage);
+    fputs(", \"name\": ", out);
+    write_json_string(out, phase->name);
+    fprintf(out,
+            ", \"ms\": %.3f, \"max_ms\": %.3f, \"items\": %zu, \"allocations\": %zu, \"bytes\": %zu, "
+            "\"detail\": %s}",
+            phase->millis,
+            phase->max_millis,
+            phase->items,
+            phase->allocations,
+            phase->bytes,
+            phase->detail ? "true" : "false");
+    if (phase->detail) {
+      continue;
+    }
+    total_millis += phase->millis;
+    total_allocations += phase->allocations;
+    total_bytes += phase->bytes;
+  }
+  fprintf(out,
+          "\n  ],\n  \"total\": {\"ms\": %.3f, \"allocations\": %zu, \"bytes\": %zu}\n}\n",
+          total_millis,
+          total_allocations,
+          total_bytes);
+  return ferror(out) == 0;
+}
+
+bool bs_load_stats_dump_json(const bs_load_stats *stats, const char *game_path, const char *out_path) {
+  FILE *out = NULL;
+  bool ok = false;
+
+  if (out_path == NULL) {
+    return false;
+  }
+
+  out = fopen(out_path, "w");
+  if (out == NULL) {
+    fprintf(stderr, "Failed to open load stats output: %s\n", out_path);
+    return false;
+  }
+  ok = bs_load_stats_write_json(stats, game_path, out);
+  if (fclose(out) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    fprintf(stderr, "Failed to write load stats: %s\n", out_path);
+  }
+  return ok;
+}
@@ -2,16 +2,36 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 int main(int argc, char **argv) {
-  const char *game_path = "undertale/game.unx";
-  int frame_count = 3;
-  if (argc > 1 && argv[1] != NULL) {
-    game_path = argv[1];
+  bs_run_options options = {0};
+  int positional = 0;
+  options.game_path = "undertale/game.unx";
+  options.frame_count = 3;
+  if (argc > 1 && argv[1] != NULL && strcmp(argv[1], "--build-image") == 0) {
+    if (argc < 3) {
+      fprintf(stderr, "usage: %s --build-image <game_path> [image_path]\n", argv[0]);
+      return 1;
+    }
+    return bs_build_image(argv[2], argc > 3 ? argv[3] : NULL);
   }
-  if (argc > 2 && argv[2] != NULL) {
-    frame_count = atoi(argv[2]);
+  for (int i = 1; i < argc && argv[i] != NULL; i++) {
+    if (strcmp(argv[i], "--load-json") == 0) {
+      /* The loader and runner log to stdout, so the report only goes to a file. */
+      if (i + 1 >= argc || strcmp(argv[i + 1], "-") == 0) {
+        fprintf(stderr, "usage: %s [game_path] [frames] [--load-json <path>]\n", argv[0]);
+        return 1;
+      }
+      options.load_json_path = argv[++i];
+    } else if (positional == 0) {
+      options.game_path = argv[i];
+      positional++;
+    } else if (positional == 1) {
+      options.frame_count = atoi(argv[i]);
+      positional++;
+    }
   }
 
-  return bs_run(game_path, frame_count);
+  return bs_run_with_options(&options);
 }
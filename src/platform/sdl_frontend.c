@@ -3,6 +3,7 @@
 #include "bs/builtin/builtin_registry.h"
 #include "bs/data/form_reader.h"
 #include "bs/runtime/game_runner.h"
+#include "bs/vm/image.h"
 #include "bs/vm/vm.h"
 
 #if defined(__has_include)
@@ -553,10 +554,10 @@ static bool bs_sdl_get_sprite_frame(const bs_sdl_draw_context *ctx,
   if (ctx == NULL || ctx->game_data == NULL) {
     return false;
   }
-  if (sprite_index < 0 || (size_t)sprite_index >= ctx->game_data->sprite_count) {
+  sprite = bs_game_data_sprite(ctx->game_data, sprite_index);
+  if (sprite == NULL) {
     return false;
   }
-  sprite = &ctx->game_data->sprites[(size_t)sprite_index];
   if (sprite->tpag_indices == NULL || sprite->subimage_count == 0) {
     return false;
   }
@@ -612,10 +613,10 @@ static void bs_sdl_draw_sprite_ext(void *userdata,
   if (ctx == NULL || ctx->renderer == NULL || ctx->game_data == NULL || runner == NULL) {
     return;
   }
-  if (sprite_index < 0 || (size_t)sprite_index >= ctx->game_data->sprite_count) {
+  sprite = bs_game_data_sprite(ctx->game_data, sprite_index);
+  if (sprite == NULL) {
     return;
   }
-  sprite = &ctx->game_data->sprites[(size_t)sprite_index];
   if (xscale == 0.0 || yscale == 0.0) {
     return;
   }
@@ -807,8 +808,8 @@ static void bs_sdl_draw_sprite_part_ext(void *userdata,
   }
 #endif
 
-  if (sprite_index >= 0 && ctx->game_data != NULL && (size_t)sprite_index < ctx->game_data->sprite_count) {
-    sprite = &ctx->game_data->sprites[(size_t)sprite_index];
+  if (ctx->game_data != NULL) {
+    sprite = bs_game_data_sprite(ctx->game_data, sprite_index);
     (void)sprite;
   }
   {
@@ -878,8 +879,10 @@ static void bs_sdl_draw_text(void *userdata,
     return;
   }
 
-  if (ctx->game_data != NULL && font_index >= 0 && (size_t)font_index < ctx->game_data->font_count) {
-    font = &ctx->game_data->fonts[(size_t)font_index];
+  if (ctx->game_data != NULL) {
+    font = bs_game_data_font(ctx->game_data, font_index);
+  }
+  if (font != NULL) {
     if (font->em_size > 0) {
       line_height = font->em_size;
     }
@@ -1579,9 +1582,21 @@ static void bs_sdl_audio_channel_finished(int channel) {
 
 #endif /* BS_HAVE_SDL_MIXER */
 
+static double bs_sdl_millis_since(uint64_t start_ticks) {
+  uint64_t freq = SDL_GetPerformanceFrequency();
+  if (freq == 0) {
+    return 0.0;
+  }
+  return ((double)(SDL_GetPerformanceCounter() - start_ticks) * 1000.0) / (double)freq;
+}
+
 int bs_run_sdl(const char *game_path) {
   bs_game_data game_data = {0};
+  bs_image image = {0};
   bs_vm vm = {0};
+  bs_load_stats frontend_stats;
+  bs_load_phase *phase = NULL;
+  uint64_t phase_start_ticks = 0;
   bs_game_runner runner = {0};
   bs_sdl_draw_context draw_ctx = {0};
   SDL_Window *window = NULL;
@@ -1694,7 +1709,8 @@ int bs_run_sdl(const char *game_path) {
          renderer_output_height,
          has_vsync ? "on" : "off");
 
-  bs_vm_init(&vm, &game_data);
+  bs_load_stats_reset(&frontend_stats);
+  bs_vm_init_with_image(&vm, &game_data, bs_image_open_for_game(&game_data, &image) ? &image : NULL);
   bs_register_builtins(&vm);
   bs_game_runner_init(&runner, &game_data, &vm);
   runner.surface_width = window_width;
@@ -1710,11 +1726,22 @@ int bs_run_sdl(const char *game_path) {
   draw_ctx.texture_pages = NULL;
   draw_ctx.texture_page_count = 0;
   draw_ctx.texture_pages_ready = false;
+  phase_start_ticks = SDL_GetPerformanceCounter();
   if (bs_sdl_load_texture_pages(&draw_ctx, &game_data)) {
     printf("Loaded %zu texture pages for sprite rendering\n", draw_ctx.texture_page_count);
   } else {
     printf("Texture pages unavailable: using placeholder sprite/text rendering\n");
   }
+  phase = bs_load_stats_add(&frontend_stats, "frontend", "texture_pages", bs_sdl_millis_since(phase_start_ticks));
+  if (phase != NULL) {
+    for (size_t i = 0; i < draw_ctx.texture_page_count; i++) {
+      if (draw_ctx.texture_pages != NULL && draw_ctx.texture_pages[i] != NULL) {
+        phase->items++;
+        phase->bytes += game_data.texture_pages[i].png_length;
+      }
+    }
+    phase->allocations = (draw_ctx.texture_pages != NULL ? 1u : 0u) + phase->items;
+  }
   runner.render.userdata = &draw_ctx;
   runner.render.clear = bs_sdl_clear;
   runner.render.draw_sprite = bs_sdl_draw_sprite;
@@ -1726,6 +1753,7 @@ int bs_run_sdl(const char *game_path) {
   runner.render.draw_rect = bs_sdl_draw_rect;
 
 #if defined(BS_HAVE_SDL_MIXER)
+  phase_start_ticks = SDL_GetPerformanceCounter();
   if (bs_sdl_audio_init(&game_data)) {
     Mix_ChannelFinished(bs_sdl_audio_channel_finished);
     runner.audio.userdata = &g_audio_ctx;
@@ -1741,8 +1769,21 @@ int bs_run_sdl(const char *game_path) {
     runner.audio.set_track_position = bs_sdl_audio_set_track_position;
     runner.audio.get_track_position = bs_sdl_audio_get_track_position;
   }
+  phase = bs_load_stats_add(&frontend_stats, "frontend", "audio_init", bs_sdl_millis_since(phase_start_ticks));
+  if (phase != NULL) {
+    phase->items = game_data.audio_data_count;
+  }
 #endif
 
+  if (getenv("BS_LOAD_JSON") != NULL) {
+    bs_load_stats load_stats;
+    bs_load_stats_reset(&load_stats);
+    bs_load_stats_append(&load_stats, &game_data.load_stats);
+    bs_load_stats_append(&load_stats, &vm.load_stats);
+    bs_load_stats_append(&load_stats, &frontend_stats);
+    (void)bs_load_stats_dump_json(&load_stats, game_data.game_path, getenv("BS_LOAD_JSON"));
+  }
+
   while (running && !runner.should_quit) {
     uint64_t frame_start_ticks = SDL_GetPerformanceCounter();
     uint64_t frame_freq = SDL_GetPerformanceFrequency();
@@ -1866,6 +1907,7 @@ int bs_run_sdl(const char *game_path) {
 cleanup:
   bs_game_runner_dispose(&runner);
   bs_vm_dispose(&vm);
+  bs_image_close(&image);
   bs_game_data_free(&game_data);
   bs_sdl_free_texture_pages(&draw_ctx);
 
@@ -0,0 +1,144 @@
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bs/platform/system.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(BS_HAVE_MMAP) && !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+size_t bs_system_processor_count(void) {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (info.dwNumberOfProcessors > 0) ? (size_t)info.dwNumberOfProcessors : 1u;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  const long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return (count > 0) ? (size_t)count : 1u;
+#else
+  return 1u;
+#endif
+}
+
+size_t bs_system_thread_count(const char *env_name, size_t max_threads) {
+  const char *env = (env_name != NULL) ? getenv(env_name) : NULL;
+  size_t count = 1;
+  if (env != NULL && atoi(env) > 0) {
+    count = (size_t)atoi(env);
+  } else {
+#if defined(BS_HAVE_PTHREADS)
+    count = bs_system_processor_count();
+#endif
+  }
+  if (count > max_threads) {
+    count = max_threads;
+  }
+  return (count < 1u) ? 1u : count;
+}
+
+#if defined(_WIN32)
+bool bs_system_map_file(const char *path, bs_file_view *out_view) {
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = NULL;
+  LARGE_INTEGER size;
+  const uint8_t *view = NULL;
+
+  if (path == NULL || out_view == NULL) {
+    return false;
+  }
+  file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+    CloseHandle(file);
+    return false;
+  }
+
+  mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (mapping == NULL) {
+    return false;
+  }
+
+  view = (const uint8_t *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == NULL) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  out_view->bytes = view;
+  out_view->size = (size_t)size.QuadPart;
+  out_view->mapping = mapping;
+  return true;
+}
+
+void bs_system_unmap_file(bs_file_view *view) {
+  if (view == NULL || view->bytes == NULL) {
+    return;
+  }
+  UnmapViewOfFile(view->bytes);
+  CloseHandle((HANDLE)view->mapping);
+  memset(view, 0, sizeof(*view));
+}
+#elif defined(BS_HAVE_MMAP)
+bool bs_system_map_file(const char *path, bs_file_view *out_view) {
+  struct stat st;
+  void *view = NULL;
+  int fd = -1;
+
+  if (path == NULL || out_view == NULL) {
+    return false;
+  }
+  fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+  view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+
+  out_view->bytes = (const uint8_t *)view;
+  out_view->size = (size_t)st.st_size;
+  out_view->mapping = NULL;
+  return true;
+}
+
+void bs_system_unmap_file(bs_file_view *view) {
+  if (view == NULL || view->bytes == NULL) {
+    return;
+  }
+  munmap((void *)(uintptr_t)view->bytes, view->size);
+  memset(view, 0, sizeof(*view));
+}
+#else
+bool bs_system_map_file(const char *path, bs_file_view *out_view) {
+  (void)path;
+  (void)out_view;
+  return false;
+}
+
+void bs_system_unmap_file(bs_file_view *view) {
+  (void)view;
+}
+#endif
@@ -0,0 +1,439 @@
+#include "bs/runtime/collision_grid.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool cell_append(bs_collision_cell *cell, uint32_t entry) {
+  if (cell->count == cell->capacity) {
+    size_t capacity = (cell->capacity == 0) ? 8u : (cell->capacity * 2u);
+    uint32_t *grown = (uint32_t *)realloc(cell->entries, capacity * sizeof(uint32_t));
+    if (grown == NULL) {
+      return false;
+    }
+    cell->entries = grown;
+    cell->capacity = capacity;
+  }
+  cell->entries[cell->count++] = entry;
+  return true;
+}
+
+/* Order inside a cell does not matter since queries sort, so removal swaps in the last entry. */
+static void cell_remove(bs_collision_cell *cell, uint32_t entry) {
+  for (size_t i = 0; i < cell->count; i++) {
+    if (cell->entries[i] == entry) {
+      cell->entries[i] = cell->entries[cell->count - 1u];
+      cell->count--;
+      return;
+    }
+  }
+}
+
+static bs_collision_cell *cell_at(const bs_collision_grid *grid, int32_t column, int32_t row) {
+  return &grid->cells[(size_t)row * (size_t)grid->columns + (size_t)column];
+}
+
+/* Clamps in floating point before converting, so infinities land on the border cells. */
+static int32_t axis_cell(double coordinate, double cell_size, int32_t cell_count) {
+  const double cell = floor(coordinate / cell_size);
+  if (!(cell >= 0.0)) {
+    return 0;
+  }
+  if (cell >= (double)(cell_count - 1)) {
+    return cell_count - 1;
+  }
+  return (int32_t)cell;
+}
+
+/* False for boxes with NaN edges; those overlap nothing but are kept on the wide list. */
+static bool cell_range(const bs_collision_grid *grid, const bs_bbox *bbox, bs_collision_grid_entry *out_range) {
+  if (!(bbox->left <= bbox->right) || !(bbox->top <= bbox->bottom)) {
+    return false;
+  }
+  out_range->column_min = axis_cell(bbox->left, grid->cell_width, grid->columns);
+  out_range->column_max = axis_cell(bbox->right, grid->cell_width, grid->columns);
+  out_range->row_min = axis_cell(bbox->top, grid->cell_height, grid->rows);
+  out_range->row_max = axis_cell(bbox->bottom, grid->cell_height, grid->rows);
+  return true;
+}
+
+static int32_t axis_cell_count(double extent, double *out_cell_size) {
+  double cell_size = BS_COLLISION_GRID_MIN_CELL;
+  double count = 1.0;
+  if (extent > 0.0 && isfinite(extent)) {
+    if (extent / (double)BS_COLLISION_GRID_MAX_AXIS > cell_size) {
+      cell_size = extent / (double)BS_COLLISION_GRID_MAX_AXIS;
+    }
+    count = ceil(extent / cell_size);
+  }
+  *out_cell_size = cell_size;
+  if (count < 1.0) {
+    return 1;
+  }
+  return (count > (double)BS_COLLISION_GRID_MAX_AXIS) ? BS_COLLISION_GRID_MAX_AXIS : (int32_t)count;
+}
+
+static int compare_entries(const void *lhs, const void *rhs) {
+  const uint32_t a = *(const uint32_t *)lhs;
+  const uint32_t b = *(const uint32_t *)rhs;
+  return (a > b) - (a < b);
+}
+
+void bs_collision_grid_init(bs_collision_grid *grid) {
+  if (grid == NULL) {
+    return;
+  }
+  memset(grid, 0, sizeof(*grid));
+}
+
+void bs_collision_grid_dispose(bs_collision_grid *grid) {
+  if (grid == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < grid->cell_capacity; i++) {
+    free(grid->cells[i].entries);
+  }
+  free(grid->cells);
+  free(grid->wide.entries);
+  free(grid->entries);
+  free(grid->marks);
+  free(grid->results);
+  free(grid->moved);
+  free(grid->changed);
+  memset(grid, 0, sizeof(*grid));
+}
+
+/* Empties the grid and sizes it for a width x height room and entries 0..entry_count-1. Cell and
+ * entry storage is kept across resets so a steady room does not allocate. */
+bool bs_collision_grid_reset(bs_collision_grid *grid, double width, double height, size_t entry_count) {
+  size_t cell_count = 0;
+
+  if (grid == NULL || entry_count > UINT32_MAX) {
+    return false;
+  }
+
+  grid->columns = axis_cell_count(width, &grid->cell_width);
+  grid->rows = axis_cell_count(height, &grid->cell_height);
+  cell_count = (size_t)grid->columns * (size_t)grid->rows;
+  if (cell_count > grid->cell_capacity) {
+    bs_collision_cell *grown = (bs_collision_cell *)realloc(grid->cells, cell_count * sizeof(bs_collision_cell));
+    if (grown == NULL) {
+      return false;
+    }
+    memset(grown + grid->cell_capacity, 0, (cell_count - grid->cell_capacity) * sizeof(bs_collision_cell));
+    grid->cells = grown;
+    grid->cell_capacity = cell_count;
+  }
+  for (size_t i = 0; i < cell_count; i++) {
+    grid->cells[i].count = 0;
+  }
+  grid->wide.count = 0;
+
+  if (entry_count > grid->entry_capacity) {
+    bs_collision_grid_entry *entries =
+        (bs_collision_grid_entry *)realloc(grid->entries, entry_count * sizeof(bs_collision_grid_entry));
+    uint32_t *marks = NULL;
+    uint32_t *results = NULL;
+    uint32_t *moved = NULL;
+    if (entries == NULL) {
+      return false;
+    }
+    grid->entries = entries;
+    marks = (uint32_t *)realloc(grid->marks, entry_count * sizeof(uint32_t));
+    if (marks == NULL) {
+      return false;
+    }
+    grid->marks = marks;
+    results = (uint32_t *)realloc(grid->results, entry_count * sizeof(uint32_t));
+    if (results == NULL) {
+      return false;
+    }
+    grid->results = results;
+    moved = (uint32_t *)realloc(grid->moved, entry_count * sizeof(uint32_t));
+    if (moved == NULL) {
+      return false;
+    }
+    grid->moved = moved;
+    grid->entry_capacity = entry_count;
+    grid->result_capacity = entry_count;
+  }
+  if (entry_count > 0) {
+    memset(grid->entries, 0, entry_count * sizeof(bs_collision_grid_entry));
+    memset(grid->marks, 0, entry_count * sizeof(uint32_t));
+  }
+  grid->entry_count = entry_count;
+  grid->moved_count = 0;
+  grid->stamp = 0;
+  grid->tracking_changes = false;
+  grid->changed_everywhere = false;
+  return true;
+}
+
+static void mark_changed(bs_collision_grid *grid, const bs_collision_grid_entry *range) {
+  if (range->wide) {
+    grid->changed_everywhere = true;
+    return;
+  }
+  for (int32_t row = range->row_min; row <= range->row_max; row++) {
+    for (int32_t column = range->column_min; column <= range->column_max; column++) {
+      grid->changed[(size_t)row * (size_t)grid->columns + (size_t)column] = 1u;
+    }
+  }
+}
+
+/* Moves entry to the cells under bbox, or takes it out of the grid when bbox is NULL. On failure
+ * the grid no longer reflects the entry and callers should stop querying it. */
+bool bs_collision_grid_place(bs_collision_grid *grid, uint32_t entry, const bs_bbox *bbox) {
+  bs_collision_grid_entry *placement = NULL;
+  bs_collision_grid_entry range = {0};
+
+  if (grid == NULL || (size_t)entry >= grid->entry_count) {
+    return false;
+  }
+
+  placement = &grid->entries[entry];
+  if (placement->placed) {
+    if (grid->tracking_changes) {
+      mark_changed(grid, placement);
+    }
+    if (placement->wide) {
+      cell_remove(&grid->wide, entry);
+    } else {
+      for (int32_t row = placement->row_min; row <= placement->row_max; row++) {
+        for (int32_t column = placement->column_min; column <= placement->column_max; column++) {
+          cell_remove(cell_at(grid, column, row), entry);
+        }
+      }
+    }
+    placement->placed = false;
+  }
+  if (bbox == NULL) {
+    return true;
+  }
+
+  if (!cell_range(grid, bbox, &range) ||
+      (int64_t)(range.column_max - range.column_min + 1) * (int64_t)(range.row_max - range.row_min + 1) >
+          BS_COLLISION_GRID_MAX_SPAN) {
+    if (!cell_append(&grid->wide, entry)) {
+      return false;
+    }
+    placement->wide = true;
+    placement->placed = true;
+    if (grid->tracking_changes) {
+      grid->changed_everywhere = true;
+    }
+    return true;
+  }
+
+  for (int32_t row = range.row_min; row <= range.row_max; row++) {
+    for (int32_t column = range.column_min; column <= range.column_max; column++) {
+      if (!cell_append(cell_at(grid, column, row), entry)) {
+        return false;
+      }
+    }
+  }
+  range.placed = true;
+  range.wide = false;
+  range.moved = placement->moved;
+  *placement = range;
+  if (grid->tracking_changes) {
+    mark_changed(grid, &range);
+  }
+  return true;
+}
+
+/* Collects the entries under bbox into results, deduplicated through marks, and sorts them. */
+static size_t gather_entries(const bs_collision_grid *grid,
+                             const bs_bbox *bbox,
+                             uint32_t *marks,
+                             uint32_t stamp,
+                             uint32_t *results) {
+  bs_collision_grid_entry range = {0};
+  size_t count = 0;
+
+  for (size_t i = 0; i < grid->wide.count; i++) {
+    marks[grid->wide.entries[i]] = stamp;
+    results[count++] = grid->wide.entries[i];
+  }
+  if (cell_range(grid, bbox, &range)) {
+    for (int32_t row = range.row_min; row <= range.row_max; row++) {
+      for (int32_t column = range.column_min; column <= range.column_max; column++) {
+        const bs_collision_cell *cell = cell_at(grid, column, row);
+        for (size_t i = 0; i < cell->count; i++) {
+          const uint32_t entry = cell->entries[i];
+          if (marks[entry] != stamp) {
+            marks[entry] = stamp;
+            results[count++] = entry;
+          }
+        }
+      }
+    }
+  }
+
+  if (count > 1u) {
+    qsort(results, count, sizeof(uint32_t), compare_entries);
+  }
+  return count;
+}
+
+/* The returned array is owned by the grid and valid until the next query or reset. */
+const uint32_t *bs_collision_grid_query(bs_collision_grid *grid, const bs_bbox *bbox, size_t *out_count) {
+  if (out_count != NULL) {
+    *out_count = 0;
+  }
+  if (grid == NULL || bbox == NULL || out_count == NULL) {
+    return NULL;
+  }
+
+  grid->stamp++;
+  if (grid->stamp == 0) {
+    memset(grid->marks, 0, grid->entry_count * sizeof(uint32_t));
+    grid->stamp = 1;
+  }
+  *out_count = gather_entries(grid, bbox, grid->marks, grid->stamp, grid->results);
+  return grid->results;
+}
+
+void bs_collision_grid_reader_init(bs_collision_grid_reader *reader) {
+  if (reader == NULL) {
+    return;
+  }
+  memset(reader, 0, sizeof(*reader));
+}
+
+void bs_collision_grid_reader_dispose(bs_collision_grid_reader *reader) {
+  if (reader == NULL) {
+    return;
+  }
+  free(reader->marks);
+  free(reader->results);
+  memset(reader, 0, sizeof(*reader));
+}
+
+/* Same results as bs_collision_grid_query, but the scratch state lives in reader, so any number of
+ * threads can read one grid at once while nothing places entries. Returns NULL if the reader
+ * cannot grow to the grid's entry count; the array is valid until the reader's next read. */
+const uint32_t *bs_collision_grid_read(const bs_collision_grid *grid,
+                                       bs_collision_grid_reader *reader,
+                                       const bs_bbox *bbox,
+                                       size_t *out_count) {
+  if (out_count != NULL) {
+    *out_count = 0;
+  }
+  if (grid == NULL || reader == NULL || bbox == NULL || out_count == NULL) {
+    return NULL;
+  }
+
+  if (grid->entry_count > reader->capacity) {
+    uint32_t *marks = (uint32_t *)realloc(reader->marks, grid->entry_count * sizeof(uint32_t));
+    uint32_t *results = NULL;
+    if (marks == NULL) {
+      return NULL;
+    }
+    reader->marks = marks;
+    results = (uint32_t *)realloc(reader->results, grid->entry_count * sizeof(uint32_t));
+    if (results == NULL) {
+      return NULL;
+    }
+    reader->results = results;
+    reader->capacity = grid->entry_count;
+    memset(reader->marks, 0, reader->capacity * sizeof(uint32_t));
+    reader->stamp = 0;
+  }
+  reader->stamp++;
+  if (reader->stamp == 0) {
+    memset(reader->marks, 0, reader->capacity * sizeof(uint32_t));
+    reader->stamp = 1;
+  }
+  *out_count = gather_entries(grid, bbox, reader->marks, reader->stamp, reader->results);
+  return reader->results;
+}
+
+/* While enabled, every place records the cells an entry leaves and enters, for
+ * bs_collision_grid_region_changed; enabling clears what was recorded. If the cell flags cannot be
+ * allocated every region reads as changed. */
+void bs_collision_grid_track_changes(bs_collision_grid *grid, bool enabled) {
+  size_t cell_count = 0;
+  if (grid == NULL) {
+    return;
+  }
+  grid->tracking_changes = enabled;
+  grid->changed_everywhere = false;
+  if (!enabled) {
+    return;
+  }
+  cell_count = (size_t)grid->columns * (size_t)grid->rows;
+  if (cell_count > grid->changed_capacity) {
+    uint8_t *grown = (uint8_t *)realloc(grid->changed, cell_count);
+    if (grown == NULL) {
+      grid->changed_everywhere = true;
+      return;
+    }
+    grid->changed = grown;
+    grid->changed_capacity = cell_count;
+  }
+  memset(grid->changed, 0, cell_count);
+}
+
+/* Whether an entry placed since bs_collision_grid_track_changes was, or now is, in a cell under
+ * bbox. Conservative: a true answer only means something nearby may have changed. */
+bool bs_collision_grid_region_changed(const bs_collision_grid *grid, const bs_bbox *bbox) {
+  bs_collision_grid_entry range = {0};
+  if (grid == NULL || bbox == NULL || grid->changed_everywhere || !cell_range(grid, bbox, &range)) {
+    return true;
+  }
+  if (!grid->tracking_changes) {
+    return false;
+  }
+  for (int32_t row = range.row_min; row <= range.row_max; row++) {
+    for (int32_t column = range.column_min; column <= range.column_max; column++) {
+      if (grid->changed[(size_t)row * (size_t)grid->columns + (size_t)column] != 0u) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Records the cells under bbox as changed while tracking, for something that changed in place
+ * without being re-placed. */
+void bs_collision_grid_mark_changed(bs_collision_grid *grid, const bs_bbox *bbox) {
+  bs_collision_grid_entry range = {0};
+  if (grid == NULL || bbox == NULL || !grid->tracking_changes) {
+    return;
+  }
+  if (!cell_range(grid, bbox, &range) ||
+      (int64_t)(range.column_max - range.column_min + 1) * (int64_t)(range.row_max - range.row_min + 1) >
+          BS_COLLISION_GRID_MAX_SPAN) {
+    grid->changed_everywhere = true;
+    return;
+  }
+  range.wide = false;
+  mark_changed(grid, &range);
+}
+
+/* Queues entry for the caller to re-place; an entry is queued at most once per drain. */
+void bs_collision_grid_note_moved(bs_collision_grid *grid, uint32_t entry) {
+  if (grid == NULL || (size_t)entry >= grid->entry_count || grid->entries[entry].moved) {
+    return;
+  }
+  grid->entries[entry].moved = true;
+  grid->moved[grid->moved_count++] = entry;
+}
+
+/* Hands back the queued entries and empties the queue. The array stays valid until the next
+ * bs_collision_grid_note_moved. */
+const uint32_t *bs_collision_grid_drain_moved(bs_collision_grid *grid, size_t *out_count) {
+  const size_t count = (grid != NULL) ? grid->moved_count : 0;
+  if (out_count != NULL) {
+    *out_count = count;
+  }
+  if (grid == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < count; i++) {
+    grid->entries[grid->moved[i]].moved = false;
+  }
+  grid->moved_count = 0;
+  return grid->moved;
+}
@@ -0,0 +1,236 @@
+#include "bs/runtime/collision_mask.h"
+
+#include <math.h>
+
+/* Masks further than this from the origin skip the word path, and regions are clamped to it, so
+ * pixel coordinates always fit in int64_t. */
+#define BS_COLLISION_MASK_WORD_RANGE 1.0e12
+
+static bool local_pixel_set(const bs_collision_mask *mask, double lx, double ly) {
+  int64_t column = 0;
+  int64_t row = 0;
+  if (!(lx >= 0.0) || !(ly >= 0.0) || lx >= (double)mask->width || ly >= (double)mask->height) {
+    return false;
+  }
+  column = (int64_t)lx;
+  row = (int64_t)ly;
+  if (mask->rows == NULL) {
+    return column >= mask->margin_left && column <= mask->margin_right &&
+           row >= mask->margin_top && row <= mask->margin_bottom;
+  }
+  return ((mask->rows[(size_t)row * mask->stride + (size_t)(column >> 6)] >> (column & 63)) & 1u) != 0;
+}
+
+/* Whether the mask covers the room point (px, py), sampling the sprite pixel the point falls in. */
+bool bs_collision_mask_covers(const bs_collision_mask *mask, double px, double py) {
+  if (mask == NULL || mask->xscale == 0.0 || mask->yscale == 0.0) {
+    return false;
+  }
+  return local_pixel_set(mask,
+                         floor(((px - mask->x) / mask->xscale) + (double)mask->origin_x),
+                         floor(((py - mask->y) / mask->yscale) + (double)mask->origin_y));
+}
+
+static bool word_path_usable(const bs_collision_mask *mask) {
+  return mask->xscale == 1.0 && mask->yscale == 1.0 &&
+         fabs(mask->x) < BS_COLLISION_MASK_WORD_RANGE && fabs(mask->y) < BS_COLLISION_MASK_WORD_RANGE;
+}
+
+/* Room pixel i samples sprite column i + shift when the mask is unscaled. */
+static int64_t word_shift(double position, int32_t origin) {
+  return (int64_t)floor(0.5 - position) + (int64_t)origin;
+}
+
+static uint64_t low_bits(int64_t count) {
+  return (count >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << count) - 1u);
+}
+
+/* Bits for sprite columns start .. start+count-1 of one row (count <= 64), columns outside the
+ * sprite reading as clear. */
+static uint64_t row_window(const bs_collision_mask *mask, int64_t row, int64_t start, int64_t count) {
+  if (row < 0 || row >= mask->height) {
+    return 0;
+  }
+  if (mask->rows == NULL) {
+    int64_t lo = (mask->margin_left > 0) ? mask->margin_left : 0;
+    int64_t hi = (mask->margin_right < mask->width - 1) ? mask->margin_right : (int64_t)mask->width - 1;
+    if (row < mask->margin_top || row > mask->margin_bottom) {
+      return 0;
+    }
+    lo = (lo > start) ? lo - start : 0;
+    hi = (hi < start + count - 1) ? hi - start : count - 1;
+    return (lo > hi) ? 0 : (low_bits(hi - lo + 1) << lo);
+  }
+
+  {
+    const uint64_t *words = &mask->rows[(size_t)row * mask->stride];
+    const int64_t word = (start >= 0) ? (start / 64) : -((63 - start) / 64);
+    const unsigned shift = (unsigned)(start - word * 64);
+    const uint64_t lo = (word >= 0 && word < (int64_t)mask->stride) ? words[word] : 0;
+    const uint64_t hi = (word + 1 >= 0 && word + 1 < (int64_t)mask->stride) ? words[word + 1] : 0;
+    const uint64_t bits = (shift == 0) ? lo : ((lo >> shift) | (hi << (64u - shift)));
+    return bits & low_bits(count);
+  }
+}
+
+/* Room pixels whose cells touch region, as an inclusive range; false if there are none. */
+static bool region_pixels(const bs_bbox *region, int64_t *out_left, int64_t *out_top, int64_t *out_right, int64_t *out_bottom) {
+  const double limit = BS_COLLISION_MASK_WORD_RANGE;
+  if (!(region->left <= region->right) || !(region->top <= region->bottom)) {
+    return false;
+  }
+  *out_left = (int64_t)floor(fmin(fmax(region->left, -limit), limit));
+  *out_top = (int64_t)floor(fmin(fmax(region->top, -limit), limit));
+  *out_right = (int64_t)ceil(fmin(fmax(region->right, -limit), limit)) - 1;
+  *out_bottom = (int64_t)ceil(fmin(fmax(region->bottom, -limit), limit)) - 1;
+  if (*out_right < *out_left) {
+    *out_right = *out_left;
+  }
+  if (*out_bottom < *out_top) {
+    *out_bottom = *out_top;
+  }
+  return true;
+}
+
+static bool pixel_covered(const bs_collision_mask *mask, int64_t i, int64_t j) {
+  return bs_collision_mask_covers(mask, (double)i + 0.5, (double)j + 0.5);
+}
+
+/* Reference test: samples both masks at every pixel centre in region. */
+static bool masks_overlap_by_pixel(const bs_collision_mask *a, const bs_collision_mask *b, const bs_bbox *region) {
+  int64_t left = 0;
+  int64_t top = 0;
+  int64_t right = 0;
+  int64_t bottom = 0;
+  if (!region_pixels(region, &left, &top, &right, &bottom)) {
+    return false;
+  }
+  for (int64_t j = top; j <= bottom; j++) {
+    for (int64_t i = left; i <= right; i++) {
+      if (pixel_covered(a, i, j) && pixel_covered(b, i, j)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Whether a set pixel of a lands on a set pixel of b inside region, usually the intersection of
+ * the two boxes. Unscaled masks are compared 64 pixels at a time by ANDing shifted row words;
+ * scaled ones are sampled pixel by pixel. */
+bool bs_collision_masks_overlap(const bs_collision_mask *a, const bs_collision_mask *b, const bs_bbox *region) {
+  int64_t left = 0;
+  int64_t top = 0;
+  int64_t right = 0;
+  int64_t bottom = 0;
+  int64_t a_column = 0;
+  int64_t a_row = 0;
+  int64_t b_column = 0;
+  int64_t b_row = 0;
+  if (a == NULL || b == NULL || region == NULL) {
+    return false;
+  }
+  if (!word_path_usable(a) || !word_path_usable(b) || (a->rows == NULL && b->rows == NULL)) {
+    return masks_overlap_by_pixel(a, b, region);
+  }
+  if (!region_pixels(region, &left, &top, &right, &bottom)) {
+    return false;
+  }
+
+  a_column = word_shift(a->x, a->origin_x);
+  a_row = word_shift(a->y, a->origin_y);
+  b_column = word_shift(b->x, b->origin_x);
+  b_row = word_shift(b->y, b->origin_y);
+  for (int64_t j = top; j <= bottom; j++) {
+    for (int64_t i = left; i <= right; i += 64) {
+      const int64_t count = (right - i + 1 < 64) ? (right - i + 1) : 64;
+      if ((row_window(a, j + a_row, i + a_column, count) & row_window(b, j + b_row, i + b_column, count)) != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Whether any set pixel of the mask has its cell inside region. */
+bool bs_collision_mask_hits_rectangle(const bs_collision_mask *mask, const bs_bbox *region) {
+  int64_t left = 0;
+  int64_t top = 0;
+  int64_t right = 0;
+  int64_t bottom = 0;
+  if (mask == NULL || region == NULL || !region_pixels(region, &left, &top, &right, &bottom)) {
+    return false;
+  }
+
+  if (word_path_usable(mask)) {
+    const int64_t column = word_shift(mask->x, mask->origin_x);
+    const int64_t row = word_shift(mask->y, mask->origin_y);
+    for (int64_t j = top; j <= bottom; j++) {
+      for (int64_t i = left; i <= right; i += 64) {
+        const int64_t count = (right - i + 1 < 64) ? (right - i + 1) : 64;
+        if (row_window(mask, j + row, i + column, count) != 0) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  for (int64_t j = top; j <= bottom; j++) {
+    for (int64_t i = left; i <= right; i++) {
+      if (pixel_covered(mask, i, j)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Whether a set pixel inside region has its centre within radius of (cx, cy). */
+bool bs_collision_mask_hits_circle(const bs_collision_mask *mask,
+                                   const bs_bbox *region,
+                                   double cx,
+                                   double cy,
+                                   double radius) {
+  int64_t left = 0;
+  int64_t top = 0;
+  int64_t right = 0;
+  int64_t bottom = 0;
+  const double radius_sq = radius * radius;
+  if (mask == NULL || region == NULL || !region_pixels(region, &left, &top, &right, &bottom)) {
+    return false;
+  }
+  for (int64_t j = top; j <= bottom; j++) {
+    const double dy = ((double)j + 0.5) - cy;
+    for (int64_t i = left; i <= right; i++) {
+      const double dx = ((double)i + 0.5) - cx;
+      if ((dx * dx) + (dy * dy) <= radius_sq && pixel_covered(mask, i, j)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* Walks the segment in steps of at most one pixel and reports whether any sample is covered. */
+bool bs_collision_mask_hits_line(const bs_collision_mask *mask, double x1, double y1, double x2, double y2) {
+  const double dx = x2 - x1;
+  const double dy = y2 - y1;
+  double steps = 0.0;
+  if (mask == NULL) {
+    return false;
+  }
+  steps = ceil(fmax(fabs(dx), fabs(dy)));
+  if (!isfinite(steps)) {
+    return false;
+  }
+  if (steps < 1.0) {
+    return bs_collision_mask_covers(mask, x1, y1) || bs_collision_mask_covers(mask, x2, y2);
+  }
+  for (double k = 0.0; k <= steps; k += 1.0) {
+    if (bs_collision_mask_covers(mask, x1 + (dx * k / steps), y1 + (dy * k / steps))) {
+      return true;
+    }
+  }
+  return false;
+}
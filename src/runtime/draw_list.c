@@ -0,0 +1,204 @@
+#include "bs/runtime/draw_list.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static bool draws_before(const bs_draw_entry *a, const bs_draw_entry *b) {
+  if (a->depth != b->depth) {
+    return a->depth > b->depth;
+  }
+  if (a->kind != b->kind) {
+    return a->kind < b->kind;
+  }
+  return a->order < b->order;
+}
+
+static int compare_entries(const void *lhs, const void *rhs) {
+  const bs_draw_entry *a = (const bs_draw_entry *)lhs;
+  const bs_draw_entry *b = (const bs_draw_entry *)rhs;
+  if (draws_before(a, b)) {
+    return -1;
+  }
+  return draws_before(b, a) ? 1 : 0;
+}
+
+static bool reserve_keys(bs_draw_list *list, bs_draw_item_kind kind, uint32_t key) {
+  size_t capacity = list->key_capacity[kind];
+  uint32_t *grown = NULL;
+  if ((size_t)key < capacity) {
+    return true;
+  }
+  while (capacity <= (size_t)key) {
+    capacity = (capacity == 0) ? 256u : (capacity * 2u);
+  }
+  grown = (uint32_t *)realloc(list->positions[kind], capacity * sizeof(uint32_t));
+  if (grown == NULL) {
+    return false;
+  }
+  for (size_t i = list->key_capacity[kind]; i < capacity; i++) {
+    grown[i] = BS_DRAW_KEY_NONE;
+  }
+  list->positions[kind] = grown;
+  list->key_capacity[kind] = capacity;
+  return true;
+}
+
+static bool reserve_entries(bs_draw_entry **entries, size_t *capacity, size_t needed) {
+  size_t grown_capacity = *capacity;
+  bs_draw_entry *grown = NULL;
+  if (needed <= grown_capacity) {
+    return true;
+  }
+  while (grown_capacity < needed) {
+    grown_capacity = (grown_capacity == 0) ? 64u : (grown_capacity * 2u);
+  }
+  grown = (bs_draw_entry *)realloc(*entries, grown_capacity * sizeof(bs_draw_entry));
+  if (grown == NULL) {
+    return false;
+  }
+  *entries = grown;
+  *capacity = grown_capacity;
+  return true;
+}
+
+void bs_draw_list_init(bs_draw_list *list) {
+  if (list == NULL) {
+    return;
+  }
+  memset(list, 0, sizeof(*list));
+}
+
+void bs_draw_list_dispose(bs_draw_list *list) {
+  if (list == NULL) {
+    return;
+  }
+  free(list->entries);
+  free(list->scratch);
+  for (size_t kind = 0; kind < BS_DRAW_ITEM_KIND_COUNT; kind++) {
+    free(list->positions[kind]);
+  }
+  memset(list, 0, sizeof(*list));
+}
+
+/* Places key at depth. A key already at that depth stays where it is; otherwise its old entry is
+ * removed and a new one goes on the unsorted tail, so an instance that keeps its depth costs
+ * nothing per frame. */
+bool bs_draw_list_set(bs_draw_list *list, bs_draw_item_kind kind, uint32_t key, int32_t depth, uint64_t order) {
+  bs_draw_entry *entry = NULL;
+  if (list == NULL || (size_t)kind >= BS_DRAW_ITEM_KIND_COUNT || key == BS_DRAW_KEY_NONE) {
+    return false;
+  }
+  if (!reserve_keys(list, kind, key)) {
+    return false;
+  }
+  if (list->positions[kind][key] != BS_DRAW_KEY_NONE) {
+    const bs_draw_entry *current = &list->entries[list->positions[kind][key]];
+    if (current->depth == depth && current->order == order) {
+      return true;
+    }
+  }
+  if (!reserve_entries(&list->entries, &list->capacity, list->count + 1u)) {
+    return false;
+  }
+  bs_draw_list_remove(list, kind, key);
+  list->positions[kind][key] = (uint32_t)list->count;
+  entry = &list->entries[list->count++];
+  entry->depth = depth;
+  entry->kind = (uint32_t)kind;
+  entry->key = key;
+  entry->removed = 0;
+  entry->order = order;
+  return true;
+}
+
+/* Takes key out of the order. Its entry stays in place, marked removed, until the next sort, so a
+ * walk over the list in progress still finds it where it was. */
+void bs_draw_list_remove(bs_draw_list *list, bs_draw_item_kind kind, uint32_t key) {
+  uint32_t position = BS_DRAW_KEY_NONE;
+  if (list == NULL || (size_t)kind >= BS_DRAW_ITEM_KIND_COUNT || (size_t)key >= list->key_capacity[kind]) {
+    return;
+  }
+  position = list->positions[kind][key];
+  if (position == BS_DRAW_KEY_NONE) {
+    return;
+  }
+  list->entries[position].removed = 1;
+  list->positions[kind][key] = BS_DRAW_KEY_NONE;
+  list->removed_count++;
+}
+
+void bs_draw_list_remove_kind(bs_draw_list *list, bs_draw_item_kind kind) {
+  if (list == NULL || (size_t)kind >= BS_DRAW_ITEM_KIND_COUNT) {
+    return;
+  }
+  for (size_t key = 0; key < list->key_capacity[kind]; key++) {
+    bs_draw_list_remove(list, kind, (uint32_t)key);
+  }
+}
+
+/* Sorts the tail and merges it with the ordered prefix, dropping removed entries, in one pass
+ * over the list. Returns false if the merge buffer could not be allocated; the list is then
+ * unchanged. */
+bool bs_draw_list_sort(bs_draw_list *list) {
+  size_t a = 0;
+  size_t b = 0;
+  size_t merged = 0;
+  bs_draw_entry *swap = NULL;
+  if (list == NULL) {
+    return false;
+  }
+  if (list->sorted_count == list->count && list->removed_count == 0) {
+    return true;
+  }
+  if (!reserve_entries(&list->scratch, &list->scratch_capacity, list->capacity)) {
+    return false;
+  }
+
+  b = list->sorted_count;
+  if (list->count - b > 1u) {
+    qsort(&list->entries[b], list->count - b, sizeof(bs_draw_entry), compare_entries);
+  }
+  while (a < list->sorted_count || b < list->count) {
+    const bs_draw_entry *next = NULL;
+    if (a < list->sorted_count && list->entries[a].removed) {
+      a++;
+      continue;
+    }
+    if (b < list->count && list->entries[b].removed) {
+      b++;
+      continue;
+    }
+    if (b >= list->count || (a < list->sorted_count && !draws_before(&list->entries[b], &list->entries[a]))) {
+      next = &list->entries[a++];
+    } else {
+      next = &list->entries[b++];
+    }
+    list->positions[next->kind][next->key] = (uint32_t)merged;
+    list->scratch[merged++] = *next;
+  }
+
+  swap = list->entries;
+  list->entries = list->scratch;
+  list->scratch = swap;
+  {
+    const size_t capacity = list->capacity;
+    list->capacity = list->scratch_capacity;
+    list->scratch_capacity = capacity;
+  }
+  list->count = merged;
+  list->sorted_count = merged;
+  list->removed_count = 0;
+  return true;
+}
+
+/* True if entry was removed only because its key was placed again with the same order, i.e. the
+ * same item moved to another depth since the last sort, rather than being dropped or reused. */
+bool bs_draw_list_moved(const bs_draw_list *list, const bs_draw_entry *entry) {
+  uint32_t position = BS_DRAW_KEY_NONE;
+  if (list == NULL || entry == NULL || !entry->removed || entry->kind >= BS_DRAW_ITEM_KIND_COUNT ||
+      (size_t)entry->key >= list->key_capacity[entry->kind]) {
+    return false;
+  }
+  position = list->positions[entry->kind][entry->key];
+  return position != BS_DRAW_KEY_NONE && list->entries[position].order == entry->order;
+}
@@ -1,16 +1,39 @@
+#if defined(BS_HAVE_PTHREADS)
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "bs/runtime/game_runner.h"
 
+#include "bs/platform/system.h"
+
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#if defined(BS_HAVE_PTHREADS)
+#include <pthread.h>
+#endif
+
+/* Below this many snapshot entries per thread the collision narrowphase stays on one thread. */
+#define BS_COLLISION_ENTRIES_PER_THREAD 256u
+
 static void bs_game_runner_fire_event(bs_game_runner *runner,
                                       bs_instance *instance,
                                       int32_t event_type,
                                       int32_t subtype,
                                       bs_instance *other_instance);
+static void bs_game_runner_listen_instance(bs_game_runner *runner, const bs_instance *instance);
+static void bs_game_runner_reset_listeners(bs_game_runner *runner);
+static void bs_game_runner_rebuild_listeners(bs_game_runner *runner);
+static void bs_game_runner_unlisten_instance(bs_game_runner *runner, const bs_instance *instance);
+static void bs_game_runner_drop_released_listeners(bs_game_runner *runner);
+static void bs_game_runner_register_instance(bs_game_runner *runner, const bs_instance *instance);
+static void bs_game_runner_unregister_instance(bs_game_runner *runner, const bs_instance *instance);
+static void bs_game_runner_count_instance(bs_game_runner *runner, const bs_instance *instance, bool live);
+static void bs_game_runner_reset_registry(bs_game_runner *runner);
+static void bs_game_runner_note_depth(bs_game_runner *runner, const bs_instance *instance);
+static void bs_game_runner_note_mask_change(bs_game_runner *runner, const bs_instance *instance);
 
 static double bs_now_millis(void) {
   struct timespec ts;
@@ -76,8 +99,8 @@ static void bs_game_runner_trace_intro_state(const bs_game_runner *runner) {
   if (runner == NULL || !bs_trace_intro_state_enabled()) {
     return;
   }
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    const bs_instance *inst = &runner->instances[i];
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     if (inst->destroyed) {
       continue;
     }
@@ -87,14 +110,14 @@ static void bs_game_runner_trace_intro_state(const bs_game_runner *runner) {
              inst->object_index,
              inst->id,
              inst->sprite_index,
-             inst->image_index,
-             inst->image_speed,
+             BS_MOTION(inst, image_index),
+             BS_MOTION(inst, image_speed),
              inst->alarm[0],
              inst->alarm[1],
              inst->alarm[2],
              inst->visible ? 1 : 0,
-             inst->x,
-             inst->y);
+             BS_MOTION(inst, x),
+             BS_MOTION(inst, y));
     }
   }
 }
@@ -156,7 +179,9 @@ static void bs_saved_room_state_clear(bs_saved_room_state *state) {
     }
   }
   free(state->instances);
+  free(state->motion);
   state->instances = NULL;
+  state->motion = NULL;
   state->instance_count = 0;
 }
 
@@ -274,7 +299,7 @@ static bool bs_game_runner_try_get_global_builtin(const bs_game_runner *runner,
     return true;
   }
   if (strcmp(name, "instance_count") == 0) {
-    *out_value = (double)runner->instance_count;
+    *out_value = (double)runner->instance_pool.count;
     return true;
   }
   if (strcmp(name, "keyboard_key") == 0) {
@@ -347,39 +372,32 @@ static void bs_game_runner_clear_instances(bs_game_runner *runner) {
   if (runner == NULL) {
     return;
   }
-  if (runner->instances != NULL) {
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      bs_instance_dispose(&runner->instances[i]);
-    }
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    bs_instance_dispose(inst);
   }
-  free(runner->instances);
-  runner->instances = NULL;
-  runner->instance_count = 0;
-  runner->instance_capacity = 0;
+  bs_instance_pool_dispose(&runner->instance_pool);
+  bs_game_runner_reset_listeners(runner);
+  bs_game_runner_reset_registry(runner);
+  bs_draw_list_remove_kind(&runner->draw_list, BS_DRAW_ITEM_INSTANCE);
 }
 
-static bool bs_game_runner_ensure_instance_capacity(bs_game_runner *runner, size_t needed) {
-  if (runner == NULL) {
-    return false;
-  }
-
-  if (needed <= runner->instance_capacity) {
-    return true;
-  }
-
-  {
-    size_t new_capacity = (runner->instance_capacity == 0) ? 64u : (runner->instance_capacity * 2u);
-    while (new_capacity < needed) {
-      new_capacity *= 2u;
-    }
-    bs_instance *grown = (bs_instance *)realloc(runner->instances, new_capacity * sizeof(bs_instance));
-    if (grown == NULL) {
-      return false;
-    }
-    runner->instances = grown;
-    runner->instance_capacity = new_capacity;
-  }
-  return true;
+/* Frees the slots of instances destroyed since the last call. Returns true if any were freed. */
+static bool bs_game_runner_release_destroyed(bs_game_runner *runner) {
+  bs_instance *inst = NULL;
+  bool released = false;
+  while ((inst = bs_instance_pool_pop_released(&runner->instance_pool)) != NULL) {
+    bs_instance_dispose(inst);
+    bs_game_runner_unregister_instance(runner, inst);
+    bs_draw_list_remove(&runner->draw_list, BS_DRAW_ITEM_INSTANCE, bs_instance_slot_index(inst));
+    bs_game_runner_unlisten_instance(runner, inst);
+    bs_instance_pool_release(&runner->instance_pool, inst);
+    released = true;
+  }
+  if (released) {
+    bs_game_runner_drop_released_listeners(runner);
+  }
+  return released;
 }
 
 static bs_instance *bs_game_runner_create_instance(bs_game_runner *runner,
@@ -388,32 +406,32 @@ static bs_instance *bs_game_runner_create_instance(bs_game_runner *runner,
                                                    double y,
                                                    int32_t preferred_id) {
   bs_instance *instance = NULL;
+  bs_instance_motion motion = {0};
+  const bs_game_object_data *obj = NULL;
   if (runner == NULL) {
     return NULL;
   }
-  if (!bs_game_runner_ensure_instance_capacity(runner, runner->instance_count + 1u)) {
+  instance = bs_instance_pool_acquire(&runner->instance_pool,
+                                      (preferred_id >= 0) ? preferred_id : runner->next_instance_id);
+  if (instance == NULL) {
     return NULL;
   }
-
-  instance = &runner->instances[runner->instance_count];
-  memset(instance, 0, sizeof(*instance));
-  instance->id = (preferred_id >= 0) ? preferred_id : runner->next_instance_id;
   instance->object_index = object_index;
-  instance->x = x;
-  instance->y = y;
-  instance->xprevious = x;
-  instance->yprevious = y;
+  motion.x = x;
+  motion.y = y;
+  motion.xprevious = x;
+  motion.yprevious = y;
   instance->xstart = x;
   instance->ystart = y;
-  instance->hspeed = 0.0;
-  instance->vspeed = 0.0;
-  instance->speed = 0.0;
-  instance->direction = 0.0;
-  instance->friction = 0.0;
-  instance->gravity = 0.0;
-  instance->gravity_direction = 270.0;
-  if (object_index >= 0 && (size_t)object_index < runner->game_data->object_count) {
-    const bs_game_object_data *obj = &runner->game_data->objects[(size_t)object_index];
+  motion.hspeed = 0.0;
+  motion.vspeed = 0.0;
+  motion.speed = 0.0;
+  motion.direction = 0.0;
+  motion.friction = 0.0;
+  motion.gravity = 0.0;
+  motion.gravity_direction = 270.0;
+  obj = bs_game_data_object(runner->game_data, object_index);
+  if (obj != NULL) {
     instance->mask_index = obj->mask_id;
     instance->sprite_index = obj->sprite_index;
     instance->depth = obj->depth;
@@ -428,8 +446,9 @@ static bs_instance *bs_game_runner_create_instance(bs_game_runner *runner,
     instance->solid = false;
     instance->persistent = false;
   }
-  instance->image_index = 0.0;
-  instance->image_speed = 1.0;
+  motion.image_index = 0.0;
+  motion.image_speed = 1.0;
+  bs_instance_pool_store_motion(instance, &motion);
   instance->image_xscale = 1.0;
   instance->image_yscale = 1.0;
   instance->image_angle = 0.0;
@@ -453,7 +472,10 @@ static bs_instance *bs_game_runner_create_instance(bs_game_runner *runner,
   }
   instance->has_been_marked_as_outside_room = false;
   instance->destroyed = false;
-  runner->instance_count++;
+  bs_game_runner_note_bbox_change(runner, instance);
+  bs_game_runner_listen_instance(runner, instance);
+  bs_game_runner_register_instance(runner, instance);
+  bs_game_runner_note_depth(runner, instance);
 
   if (instance->id >= runner->next_instance_id) {
     runner->next_instance_id = instance->id + 1;
@@ -467,13 +489,120 @@ bs_instance *bs_game_runner_find_instance_by_id(bs_game_runner *runner, int32_t
     return NULL;
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    if (runner->instances[i].id == id) {
-      return &runner->instances[i];
+  return bs_instance_pool_find_id(&runner->instance_pool, id);
+}
+
+/* Fills out_enter and out_exit from the parent links: children grouped by parent in index order,
+ * then a depth-first walk from every root. Out-of-range parents make roots; objects on a cycle are
+ * never reached and keep BS_ANCESTRY_NONE. */
+static void bs_ancestry_number(size_t count,
+                               int32_t *parents,
+                               uint32_t *child_start,
+                               uint32_t *children,
+                               uint32_t *stack,
+                               uint32_t *next_child,
+                               uint32_t *out_enter,
+                               uint32_t *out_exit) {
+  uint32_t clock = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (parents[i] >= 0 && (size_t)parents[i] >= count) {
+      parents[i] = -1;
+    }
+    if (parents[i] >= 0) {
+      child_start[(size_t)parents[i] + 1u]++;
+    }
+    out_enter[i] = BS_ANCESTRY_NONE;
+    out_exit[i] = BS_ANCESTRY_NONE;
+  }
+  for (size_t i = 0; i < count; i++) {
+    child_start[i + 1u] += child_start[i];
+    next_child[i] = child_start[i];
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (parents[i] >= 0) {
+      children[next_child[(size_t)parents[i]]++] = (uint32_t)i;
     }
   }
 
-  return NULL;
+  for (size_t root = 0; root < count; root++) {
+    size_t height = 0;
+    if (parents[root] >= 0) {
+      continue;
+    }
+    stack[height++] = (uint32_t)root;
+    next_child[root] = child_start[root];
+    out_enter[root] = clock++;
+    while (height > 0) {
+      const uint32_t node = stack[height - 1u];
+      if (next_child[node] < child_start[node + 1u]) {
+        const uint32_t child = children[next_child[node]++];
+        stack[height++] = child;
+        next_child[child] = child_start[child];
+        out_enter[child] = clock++;
+        continue;
+      }
+      out_exit[node] = clock;
+      height--;
+    }
+  }
+
+  /* Past 64 links the chain walk gives up, so those objects keep walking to match it. */
+  for (size_t i = 0; i < count; i++) {
+    size_t depth = 0;
+    for (int32_t p = parents[i]; p >= 0 && depth <= 64u; p = parents[(size_t)p]) {
+      depth++;
+    }
+    if (depth > 64u) {
+      out_enter[i] = BS_ANCESTRY_NONE;
+    }
+  }
+}
+
+/* Builds the ancestry tables once the game is loaded, reading parent links from the object
+ * headers so no object is parsed. Leaves them NULL if memory runs out. */
+static void bs_game_runner_build_ancestry(bs_game_runner *runner) {
+  const size_t count = runner->game_data->object_count;
+  int32_t *parents = NULL;
+  uint32_t *child_start = NULL;
+  uint32_t *children = NULL;
+  uint32_t *stack = NULL;
+  uint32_t *next_child = NULL;
+
+  if (count == 0 || count >= (size_t)BS_ANCESTRY_NONE) {
+    return;
+  }
+  parents = (int32_t *)malloc(count * sizeof(int32_t));
+  child_start = (uint32_t *)calloc(count + 1u, sizeof(uint32_t));
+  children = (uint32_t *)malloc(count * sizeof(uint32_t));
+  stack = (uint32_t *)malloc(count * sizeof(uint32_t));
+  next_child = (uint32_t *)malloc(count * sizeof(uint32_t));
+  runner->ancestry_enter = (uint32_t *)malloc(count * sizeof(uint32_t));
+  runner->ancestry_exit = (uint32_t *)malloc(count * sizeof(uint32_t));
+  if (parents != NULL && child_start != NULL && children != NULL && stack != NULL && next_child != NULL &&
+      runner->ancestry_enter != NULL && runner->ancestry_exit != NULL) {
+    for (size_t i = 0; i < count; i++) {
+      parents[i] = bs_game_data_object_parent(runner->game_data, (int32_t)i);
+    }
+    bs_ancestry_number(count,
+                       parents,
+                       child_start,
+                       children,
+                       stack,
+                       next_child,
+                       runner->ancestry_enter,
+                       runner->ancestry_exit);
+  } else {
+    free(runner->ancestry_enter);
+    free(runner->ancestry_exit);
+    runner->ancestry_enter = NULL;
+    runner->ancestry_exit = NULL;
+  }
+
+  free(parents);
+  free(child_start);
+  free(children);
+  free(stack);
+  free(next_child);
 }
 
 bool bs_game_runner_object_is_child_of(const bs_game_runner *runner,
@@ -491,19 +620,25 @@ bool bs_game_runner_object_is_child_of(const bs_game_runner *runner,
     return true;
   }
 
-  while (depth < 64) {
-    const bs_game_object_data *obj = NULL;
-    if (current < 0 || (size_t)current >= runner->game_data->object_count) {
-      return false;
+  if (runner->ancestry_enter != NULL &&
+      (size_t)child_object_index < runner->game_data->object_count &&
+      (size_t)parent_object_index < runner->game_data->object_count) {
+    const uint32_t child_enter = runner->ancestry_enter[(size_t)child_object_index];
+    const uint32_t parent_enter = runner->ancestry_enter[(size_t)parent_object_index];
+    if (child_enter != BS_ANCESTRY_NONE && parent_enter != BS_ANCESTRY_NONE) {
+      return parent_enter < child_enter && child_enter < runner->ancestry_exit[(size_t)parent_object_index];
     }
-    obj = &runner->game_data->objects[(size_t)current];
-    if (obj->parent_id == parent_object_index) {
+  }
+
+  while (depth < 64) {
+    const int32_t parent_id = bs_game_data_object_parent(runner->game_data, current);
+    if (parent_id == parent_object_index) {
       return true;
     }
-    if (obj->parent_id < 0) {
+    if (parent_id < 0) {
       return false;
     }
-    current = obj->parent_id;
+    current = parent_id;
     depth++;
   }
 
@@ -511,16 +646,18 @@ bool bs_game_runner_object_is_child_of(const bs_game_runner *runner,
 }
 
 static size_t bs_game_runner_sprite_frame_count(const bs_game_runner *runner, int32_t sprite_index) {
+  const bs_sprite_data *sprite = NULL;
   if (runner == NULL || runner->game_data == NULL) {
     return 0;
   }
-  if (sprite_index < 0 || (size_t)sprite_index >= runner->game_data->sprite_count) {
+  sprite = bs_game_data_sprite(runner->game_data, sprite_index);
+  if (sprite == NULL) {
     return 0;
   }
-  if (runner->game_data->sprites[(size_t)sprite_index].subimage_count == 0) {
+  if (sprite->subimage_count == 0) {
     return 1;
   }
-  return runner->game_data->sprites[(size_t)sprite_index].subimage_count;
+  return sprite->subimage_count;
 }
 
 double bs_game_runner_instance_get_variable(bs_game_runner *runner,
@@ -538,16 +675,16 @@ double bs_game_runner_instance_get_variable(bs_game_runner *runner,
 
   if (variable_name != NULL) {
     if (strcmp(variable_name, "x") == 0) {
-      return instance->x;
+      return BS_MOTION(instance, x);
     }
     if (strcmp(variable_name, "y") == 0) {
-      return instance->y;
+      return BS_MOTION(instance, y);
     }
     if (strcmp(variable_name, "xprevious") == 0) {
-      return instance->xprevious;
+      return BS_MOTION(instance, xprevious);
     }
     if (strcmp(variable_name, "yprevious") == 0) {
-      return instance->yprevious;
+      return BS_MOTION(instance, yprevious);
     }
     if (strcmp(variable_name, "xstart") == 0) {
       return instance->xstart;
@@ -556,25 +693,25 @@ double bs_game_runner_instance_get_variable(bs_game_runner *runner,
       return instance->ystart;
     }
     if (strcmp(variable_name, "hspeed") == 0) {
-      return instance->hspeed;
+      return BS_MOTION(instance, hspeed);
     }
     if (strcmp(variable_name, "vspeed") == 0) {
-      return instance->vspeed;
+      return BS_MOTION(instance, vspeed);
     }
     if (strcmp(variable_name, "speed") == 0) {
-      return instance->speed;
+      return BS_MOTION(instance, speed);
     }
     if (strcmp(variable_name, "direction") == 0) {
-      return instance->direction;
+      return BS_MOTION(instance, direction);
     }
     if (strcmp(variable_name, "friction") == 0) {
-      return instance->friction;
+      return BS_MOTION(instance, friction);
     }
     if (strcmp(variable_name, "gravity") == 0) {
-      return instance->gravity;
+      return BS_MOTION(instance, gravity);
     }
     if (strcmp(variable_name, "gravity_direction") == 0) {
-      return instance->gravity_direction;
+      return BS_MOTION(instance, gravity_direction);
     }
     if (strcmp(variable_name, "id") == 0) {
       return (double)instance->id;
@@ -601,10 +738,10 @@ double bs_game_runner_instance_get_variable(bs_game_runner *runner,
       return instance->persistent ? 1.0 : 0.0;
     }
     if (strcmp(variable_name, "image_index") == 0) {
-      return instance->image_index;
+      return BS_MOTION(instance, image_index);
     }
     if (strcmp(variable_name, "image_speed") == 0) {
-      return instance->image_speed;
+      return BS_MOTION(instance, image_speed);
     }
     if (strcmp(variable_name, "image_xscale") == 0) {
       return instance->image_xscale;
@@ -685,21 +822,21 @@ double bs_game_runner_instance_get_variable(bs_game_runner *runner,
       return 0.0;
     }
     if (strcmp(variable_name, "sprite_width") == 0) {
-      if (runner != NULL &&
-          runner->game_data != NULL &&
-          instance->sprite_index >= 0 &&
-          (size_t)instance->sprite_index < runner->game_data->sprite_count) {
-        const bs_sprite_data *sprite = &runner->game_data->sprites[(size_t)instance->sprite_index];
+      const bs_sprite_data *sprite = NULL;
+      if (runner != NULL && runner->game_data != NULL) {
+        sprite = bs_game_data_sprite(runner->game_data, instance->sprite_index);
+      }
+      if (sprite != NULL) {
         return (double)sprite->width * fabs(instance->image_xscale);
       }
       return 0.0;
     }
     if (strcmp(variable_name, "sprite_height") == 0) {
-      if (runner != NULL &&
-          runner->game_data != NULL &&
-          instance->sprite_index >= 0 &&
-          (size_t)instance->sprite_index < runner->game_data->sprite_count) {
-        const bs_sprite_data *sprite = &runner->game_data->sprites[(size_t)instance->sprite_index];
+      const bs_sprite_data *sprite = NULL;
+      if (runner != NULL && runner->game_data != NULL) {
+        sprite = bs_game_data_sprite(runner->game_data, instance->sprite_index);
+      }
+      if (sprite != NULL) {
         return (double)sprite->height * fabs(instance->image_yscale);
       }
       return 0.0;
@@ -720,27 +857,34 @@ bool bs_game_runner_instance_set_variable(bs_game_runner *runner,
                                           int32_t variable_index,
                                           const char *variable_name,
                                           double value) {
+  bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
   bs_instance *instance = bs_game_runner_find_instance_by_id(runner, instance_id);
   const double pi = 3.14159265358979323846;
   if (instance == NULL) {
     return false;
   }
 
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+
   if (variable_name != NULL) {
     if (strcmp(variable_name, "x") == 0) {
-      instance->x = value;
+      motion->x[slot] = value;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "y") == 0) {
-      instance->y = value;
+      motion->y[slot] = value;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "xprevious") == 0) {
-      instance->xprevious = value;
+      motion->xprevious[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "yprevious") == 0) {
-      instance->yprevious = value;
+      motion->yprevious[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "xstart") == 0) {
@@ -752,52 +896,59 @@ bool bs_game_runner_instance_set_variable(bs_game_runner *runner,
       return true;
     }
     if (strcmp(variable_name, "hspeed") == 0) {
-      instance->hspeed = value;
-      instance->speed = sqrt(instance->hspeed * instance->hspeed + instance->vspeed * instance->vspeed);
-      instance->direction = fmod((atan2(-instance->vspeed, instance->hspeed) * (180.0 / pi)) + 360.0, 360.0);
+      motion->hspeed[slot] = value;
+      motion->speed[slot] = sqrt(motion->hspeed[slot] * motion->hspeed[slot] +
+                                 motion->vspeed[slot] * motion->vspeed[slot]);
+      motion->direction[slot] = fmod((atan2(-motion->vspeed[slot], motion->hspeed[slot]) * (180.0 / pi)) + 360.0,
+                                     360.0);
       return true;
     }
     if (strcmp(variable_name, "vspeed") == 0) {
-      instance->vspeed = value;
-      instance->speed = sqrt(instance->hspeed * instance->hspeed + instance->vspeed * instance->vspeed);
-      instance->direction = fmod((atan2(-instance->vspeed, instance->hspeed) * (180.0 / pi)) + 360.0, 360.0);
+      motion->vspeed[slot] = value;
+      motion->speed[slot] = sqrt(motion->hspeed[slot] * motion->hspeed[slot] +
+                                 motion->vspeed[slot] * motion->vspeed[slot]);
+      motion->direction[slot] = fmod((atan2(-motion->vspeed[slot], motion->hspeed[slot]) * (180.0 / pi)) + 360.0,
+                                     360.0);
       return true;
     }
     if (strcmp(variable_name, "speed") == 0) {
-      instance->speed = value;
-      instance->hspeed = instance->speed * cos(instance->direction * (pi / 180.0));
-      instance->vspeed = -instance->speed * sin(instance->direction * (pi / 180.0));
+      motion->speed[slot] = value;
+      motion->hspeed[slot] = motion->speed[slot] * cos(motion->direction[slot] * (pi / 180.0));
+      motion->vspeed[slot] = -motion->speed[slot] * sin(motion->direction[slot] * (pi / 180.0));
       return true;
     }
     if (strcmp(variable_name, "direction") == 0) {
-      instance->direction = value;
-      instance->hspeed = instance->speed * cos(instance->direction * (pi / 180.0));
-      instance->vspeed = -instance->speed * sin(instance->direction * (pi / 180.0));
+      motion->direction[slot] = value;
+      motion->hspeed[slot] = motion->speed[slot] * cos(motion->direction[slot] * (pi / 180.0));
+      motion->vspeed[slot] = -motion->speed[slot] * sin(motion->direction[slot] * (pi / 180.0));
       return true;
     }
     if (strcmp(variable_name, "friction") == 0) {
-      instance->friction = value;
+      motion->friction[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "gravity") == 0) {
-      instance->gravity = value;
+      motion->gravity[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "gravity_direction") == 0) {
-      instance->gravity_direction = value;
+      motion->gravity_direction[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "sprite_index") == 0) {
       instance->sprite_index = (int32_t)value;
-      instance->image_index = 0.0;
+      motion->image_index[slot] = 0.0;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "mask_index") == 0) {
       instance->mask_index = (int32_t)value;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "depth") == 0) {
       instance->depth = (int32_t)value;
+      bs_game_runner_note_depth(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "visible") == 0) {
@@ -813,19 +964,22 @@ bool bs_game_runner_instance_set_variable(bs_game_runner *runner,
       return true;
     }
     if (strcmp(variable_name, "image_index") == 0) {
-      instance->image_index = value;
+      motion->image_index[slot] = value;
+      bs_game_runner_note_mask_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "image_speed") == 0) {
-      instance->image_speed = value;
+      motion->image_speed[slot] = value;
       return true;
     }
     if (strcmp(variable_name, "image_xscale") == 0) {
       instance->image_xscale = value;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "image_yscale") == 0) {
       instance->image_yscale = value;
+      bs_game_runner_note_bbox_change(runner, instance);
       return true;
     }
     if (strcmp(variable_name, "image_angle") == 0) {
@@ -895,6 +1049,8 @@ void bs_game_runner_destroy_instance(bs_game_runner *runner, int32_t id) {
   if (instance != NULL && !instance->destroyed) {
     bs_game_runner_fire_event(runner, instance, BS_EVENT_DESTROY, 0, NULL);
     instance->destroyed = true;
+    bs_game_runner_count_instance(runner, instance, false);
+    bs_instance_pool_mark_released(&runner->instance_pool, instance);
   }
 }
 
@@ -911,11 +1067,10 @@ static const bs_event_entry *bs_game_runner_find_event_in_object_chain(const bs_
 
   while (depth < 64) {
     const bs_game_object_data *object_data = NULL;
-    if (current < 0 || (size_t)current >= runner->game_data->object_count) {
+    object_data = bs_game_data_object(runner->game_data, current);
+    if (object_data == NULL) {
       return NULL;
     }
-
-    object_data = &runner->game_data->objects[(size_t)current];
     if ((size_t)event_type < object_data->event_type_count) {
       const bs_object_event_list *event_list = &object_data->events[(size_t)event_type];
       for (size_t i = 0; i < event_list->entry_count; i++) {
@@ -938,241 +1093,872 @@ static const bs_event_entry *bs_game_runner_find_event_in_object_chain(const bs_
   return NULL;
 }
 
-static void bs_game_runner_execute_event_entry(bs_game_runner *runner,
-                                               bs_instance *instance,
-                                               int32_t event_type,
-                                               int32_t subtype,
-                                               int32_t owner_object_index,
-                                               const bs_event_entry *event_entry,
-                                               int32_t other_instance_id) {
-  int32_t prev_self_id = 0;
-  int32_t prev_other_id = 0;
-  bool prev_context_active = false;
-  int32_t prev_event_type = 0;
-  int32_t prev_event_subtype = 0;
-  int32_t prev_event_object_index = 0;
-  const bool trace_vm = bs_trace_vm_enabled();
-  if (runner == NULL ||
-      instance == NULL ||
-      instance->destroyed ||
-      runner->vm == NULL ||
-      event_entry == NULL) {
-    return;
+static bool bs_dispatch_row_has_subtype(const bs_event_dispatch_slot *slots, size_t count, int32_t subtype) {
+  for (size_t i = 0; i < count; i++) {
+    if (slots[i].subtype == subtype) {
+      return true;
+    }
   }
+  return false;
+}
 
-  prev_self_id = runner->vm->current_self_id;
-  prev_other_id = runner->vm->current_other_id;
-  prev_context_active = runner->event_context_active;
-  prev_event_type = runner->current_event_type;
-  prev_event_subtype = runner->current_event_subtype;
-  prev_event_object_index = runner->current_event_object_index;
-  runner->vm->current_self_id = instance->id;
-  runner->vm->current_other_id = other_instance_id;
-  runner->event_context_active = true;
-  runner->current_event_type = event_type;
-  runner->current_event_subtype = subtype;
-  runner->current_event_object_index = owner_object_index;
+/* Merges an object's own list for one event type with its parent's flattened row. The first entry
+ * for a subtype wins, matching the chain walk. With out_slots NULL it only counts. */
+static size_t bs_dispatch_row_fill(bs_event_dispatch_slot *out_slots,
+                                   int32_t object_index,
+                                   const bs_object_event_list *own_list,
+                                   const bs_event_dispatch_row *parent_row) {
+  bs_event_dispatch_slot *slots = out_slots;
+  size_t count = 0;
 
-  for (size_t i = 0; i < event_entry->action_count; i++) {
-    int32_t code_id = event_entry->actions[i].code_id;
-    if (code_id >= 0 && (size_t)code_id < runner->game_data->code_entry_count) {
-      bs_vm_execute_result result = {0};
-      if (runner->trace_events) {
-        const bs_code_entry_data *trace_entry = &runner->game_data->code_entries[(size_t)code_id];
-        printf("  [EVT] room=%d obj=%d inst=%d evt=%d sub=%d code=%d name=%s\n",
-               runner->current_room_index,
-               instance->object_index,
-               instance->id,
-               event_type,
-               subtype,
-               code_id,
-               trace_entry->name != NULL ? trace_entry->name : "<unnamed>");
+  if (own_list != NULL) {
+    for (size_t i = 0; i < own_list->entry_count; i++) {
+      const bs_event_entry *entry = &own_list->entries[i];
+      bool seen = false;
+      for (size_t j = 0; j < i && !seen; j++) {
+        seen = own_list->entries[j].subtype == entry->subtype;
       }
-      bool ok = bs_vm_execute_code(runner->vm,
-                                   (size_t)code_id,
-                                   120000u,
-                                   (runner->trace_events && trace_vm),
-                                   &result);
-      runner->total_vm_event_calls++;
-      runner->total_vm_instructions += result.instructions_executed;
-      if (!ok || result.exit_reason == BS_VM_EXIT_ERROR) {
-        const bs_code_entry_data *entry = &runner->game_data->code_entries[(size_t)code_id];
-        printf("  VM event error: obj=%d inst=%d code=%d name=%s ok=%s reason=%s instructions=%u\n",
-               instance->object_index,
-               instance->id,
-               code_id,
-               entry->name != NULL ? entry->name : "<unnamed>",
-               ok ? "true" : "false",
-               bs_vm_exit_reason_to_string(result.exit_reason),
-               (unsigned)result.instructions_executed);
+      if (seen) {
+        continue;
       }
+      if (slots != NULL) {
+        slots[count].subtype = entry->subtype;
+        slots[count].owner_object_index = object_index;
+        slots[count].entry = entry;
+      }
+      count++;
     }
   }
 
-  runner->vm->current_self_id = prev_self_id;
-  runner->vm->current_other_id = prev_other_id;
-  runner->event_context_active = prev_context_active;
-  runner->current_event_type = prev_event_type;
-  runner->current_event_subtype = prev_event_subtype;
-  runner->current_event_object_index = prev_event_object_index;
-}
-
-void bs_game_runner_fire_event_inherited(bs_game_runner *runner, bs_instance *instance) {
-  const bs_event_entry *event_entry = NULL;
-  int32_t owner_object_index = -1;
-  int32_t parent_object_index = -1;
-  if (runner == NULL ||
-      instance == NULL ||
-      instance->destroyed ||
-      runner->game_data == NULL ||
-      !runner->event_context_active ||
-      runner->current_event_object_index < 0 ||
-      (size_t)runner->current_event_object_index >= runner->game_data->object_count) {
-    return;
-  }
-
-  parent_object_index = runner->game_data->objects[(size_t)runner->current_event_object_index].parent_id;
-  if (parent_object_index < 0) {
-    return;
-  }
-
-  event_entry = bs_game_runner_find_event_in_object_chain(runner,
-                                                           parent_object_index,
-                                                           runner->current_event_type,
-                                                           runner->current_event_subtype,
-                                                           &owner_object_index);
-  if (event_entry == NULL) {
-    return;
+  if (parent_row != NULL) {
+    size_t own_count = count;
+    for (size_t i = 0; i < parent_row->slot_count; i++) {
+      const bs_event_dispatch_slot *inherited = &parent_row->slots[i];
+      bool overridden = false;
+      if (slots != NULL) {
+        overridden = bs_dispatch_row_has_subtype(slots, own_count, inherited->subtype);
+      } else if (own_list != NULL) {
+        for (size_t j = 0; j < own_list->entry_count && !overridden; j++) {
+          overridden = own_list->entries[j].subtype == inherited->subtype;
+        }
+      }
+      if (overridden) {
+        continue;
+      }
+      if (slots != NULL) {
+        slots[count] = *inherited;
+      }
+      count++;
+    }
   }
 
-  bs_game_runner_execute_event_entry(runner,
-                                     instance,
-                                     runner->current_event_type,
-                                     runner->current_event_subtype,
-                                     owner_object_index,
-                                     event_entry,
-                                     instance->id);
+  return count;
 }
 
-static void bs_game_runner_fire_event(bs_game_runner *runner,
-                                      bs_instance *instance,
-                                      int32_t event_type,
-                                      int32_t subtype,
-                                      bs_instance *other_instance) {
-  const bs_event_entry *event_entry = NULL;
-  int32_t owner_object_index = -1;
-  if (runner == NULL || instance == NULL || instance->destroyed || runner->vm == NULL) {
-    return;
+static void bs_dispatch_row_sort(bs_event_dispatch_row *row) {
+  for (size_t i = 0; i < row->slot_count; i++) {
+    row->sorted_slots[i] = (uint32_t)i;
   }
-
-  event_entry = bs_game_runner_find_event_in_object_chain(runner,
-                                                           instance->object_index,
-                                                           event_type,
-                                                           subtype,
-                                                           &owner_object_index);
-  if (event_entry == NULL) {
-    return;
+  for (size_t i = 1; i < row->slot_count; i++) {
+    uint32_t index = row->sorted_slots[i];
+    size_t j = i;
+    while (j > 0 && row->slots[row->sorted_slots[j - 1]].subtype > row->slots[index].subtype) {
+      row->sorted_slots[j] = row->sorted_slots[j - 1];
+      j--;
+    }
+    row->sorted_slots[j] = index;
   }
-
-  bs_game_runner_execute_event_entry(runner,
-                                     instance,
-                                     event_type,
-                                     subtype,
-                                     owner_object_index,
-                                     event_entry,
-                                     other_instance != NULL ? other_instance->id : instance->id);
-}
-
-void bs_game_runner_fire_event_for_instance(bs_game_runner *runner,
-                                            bs_instance *instance,
-                                            int32_t event_type,
-                                            int32_t subtype) {
-  bs_game_runner_fire_event(runner, instance, event_type, subtype, NULL);
 }
 
-void bs_game_runner_path_end_instance(bs_game_runner *runner, bs_instance *instance) {
-  (void)runner;
-  if (instance == NULL) {
-    return;
+static const bs_event_dispatch_slot *bs_dispatch_row_find(const bs_event_dispatch_row *row, int32_t subtype) {
+  size_t lo = 0;
+  size_t hi = row->slot_count;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) / 2u);
+    const bs_event_dispatch_slot *slot = &row->slots[row->sorted_slots[mid]];
+    if (slot->subtype < subtype) {
+      lo = mid + 1u;
+    } else if (slot->subtype > subtype) {
+      hi = mid;
+    } else {
+      return slot;
+    }
   }
-  instance->path_index = -1;
-  instance->path_speed = 0.0;
+  return NULL;
 }
 
-bs_instance *bs_game_runner_create_instance_runtime(bs_game_runner *runner,
-                                                    int32_t object_index,
-                                                    double x,
-                                                    double y,
-                                                    bool run_create_event) {
-  bs_instance *created = NULL;
-  if (runner == NULL || runner->game_data == NULL || object_index < 0) {
+/* Returns the flattened table for object_index, building it (and its ancestors') on first use.
+ * NULL means the table could not be built; callers then fall back to walking the chain. */
+static const bs_object_dispatch *bs_game_runner_object_dispatch(bs_game_runner *runner,
+                                                                int32_t object_index,
+                                                                int depth) {
+  bs_object_dispatch *dispatch = NULL;
+  const bs_object_dispatch *parent = NULL;
+  const bs_game_object_data *object_data = NULL;
+  size_t total = 0;
+  size_t collision_total = 0;
+  size_t offset = 0;
+  uint32_t *sorted = NULL;
+
+  if (runner == NULL ||
+      runner->object_dispatch == NULL ||
+      object_index < 0 ||
+      (size_t)object_index >= runner->object_dispatch_count ||
+      depth >= 64) {
     return NULL;
   }
-  if ((size_t)object_index >= runner->game_data->object_count) {
+
+  dispatch = &runner->object_dispatch[(size_t)object_index];
+  if (dispatch->state == BS_DISPATCH_READY) {
+    return dispatch;
+  }
+  if (dispatch->state == BS_DISPATCH_BUILDING) {
     return NULL;
   }
 
-  created = bs_game_runner_create_instance(runner, object_index, x, y, -1);
-  if (created == NULL) {
-    return NULL;
+  dispatch->state = BS_DISPATCH_BUILDING;
+  dispatch->parent_object_index = -1;
+  object_data = bs_game_data_object(runner->game_data, object_index);
+  if (object_data == NULL) {
+    dispatch->state = BS_DISPATCH_READY;
+    return dispatch;
+  }
+  dispatch->parent_object_index = object_data->parent_id;
+  if (object_data->parent_id >= 0) {
+    parent = bs_game_runner_object_dispatch(runner, object_data->parent_id, depth + 1);
   }
 
-  if (run_create_event) {
-    bs_game_runner_fire_event(runner, created, BS_EVENT_CREATE, 0, NULL);
+  for (size_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    const bs_object_event_list *own_list = t < object_data->event_type_count ? &object_data->events[t] : NULL;
+    const size_t count =
+        bs_dispatch_row_fill(NULL, object_index, own_list, parent != NULL ? &parent->rows[t] : NULL);
+    if (t == (size_t)BS_EVENT_COLLISION) {
+      collision_total = count;
+    }
+    total += count;
   }
-  return created;
-}
 
-static void bs_game_runner_dispatch_event_all(bs_game_runner *runner, int32_t event_type, int32_t subtype) {
-  size_t snapshot_count = 0;
-  if (runner == NULL) {
-    return;
+  if (total > 0) {
+    dispatch->storage = (bs_event_dispatch_slot *)malloc(
+        (total * (sizeof(bs_event_dispatch_slot) + sizeof(uint32_t))) + (collision_total * sizeof(int32_t)));
+    if (dispatch->storage == NULL) {
+      dispatch->state = BS_DISPATCH_UNBUILT;
+      return NULL;
+    }
+    sorted = (uint32_t *)(void *)(dispatch->storage + total);
+    dispatch->collision_targets = (int32_t *)(void *)(sorted + total);
   }
 
-  snapshot_count = runner->instance_count;
-  for (size_t i = 0; i < snapshot_count; i++) {
-    if (i >= runner->instance_count) {
-      break;
+  for (size_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    const bs_object_event_list *own_list = t < object_data->event_type_count ? &object_data->events[t] : NULL;
+    bs_event_dispatch_row *row = &dispatch->rows[t];
+    row->slots = dispatch->storage != NULL ? dispatch->storage + offset : NULL;
+    row->sorted_slots = sorted != NULL ? sorted + offset : NULL;
+    row->slot_count = row->slots != NULL
+                          ? bs_dispatch_row_fill(row->slots,
+                                                 object_index,
+                                                 own_list,
+                                                 parent != NULL ? &parent->rows[t] : NULL)
+                          : 0;
+    bs_dispatch_row_sort(row);
+    offset += row->slot_count;
+  }
+
+  dispatch->collision_target_count = 0;
+  for (size_t i = 0; i < dispatch->rows[BS_EVENT_COLLISION].slot_count; i++) {
+    const int32_t subtype = dispatch->rows[BS_EVENT_COLLISION].slots[i].subtype;
+    if (subtype >= 0) {
+      dispatch->collision_targets[dispatch->collision_target_count++] = subtype;
     }
-    bs_game_runner_fire_event(runner, &runner->instances[i], event_type, subtype, NULL);
   }
+
+  dispatch->state = BS_DISPATCH_READY;
+  return dispatch;
 }
 
-static bool bs_game_runner_contains_subtype(const int32_t *subtypes, size_t count, int32_t subtype) {
-  for (size_t i = 0; i < count; i++) {
-    if (subtypes[i] == subtype) {
-      return true;
+static void bs_game_runner_free_dispatch(bs_game_runner *runner) {
+  if (runner->object_dispatch != NULL) {
+    for (size_t i = 0; i < runner->object_dispatch_count; i++) {
+      free(runner->object_dispatch[i].storage);
     }
   }
-  return false;
+  free(runner->object_dispatch);
+  runner->object_dispatch = NULL;
+  runner->object_dispatch_count = 0;
 }
 
-bool bs_game_runner_compute_instance_bbox(const bs_game_runner *runner,
-                                          const bs_instance *instance,
-                                          bs_bbox *out_bbox) {
-  int32_t sprite_index = 0;
-  const bs_sprite_data *sprite = NULL;
-  double x1 = 0.0;
-  double x2 = 0.0;
-  double y1 = 0.0;
-  double y2 = 0.0;
+/* Create, destroy, collision and draw are fired per instance or by their own passes; everything
+ * else is broadcast and goes through listener lists. */
+static bool bs_event_type_has_listeners(int32_t event_type) {
+  return event_type == BS_EVENT_ALARM ||
+         event_type == BS_EVENT_STEP ||
+         event_type == BS_EVENT_KEYBOARD ||
+         event_type == BS_EVENT_MOUSE ||
+         event_type == BS_EVENT_OTHER ||
+         event_type == BS_EVENT_KEYPRESS ||
+         event_type == BS_EVENT_KEYRELEASE ||
+         event_type == BS_EVENT_TRIGGER;
+}
+
+static const bs_event_listener_list *bs_game_runner_listener_list(const bs_game_runner *runner,
+                                                                  int32_t event_type,
+                                                                  int32_t subtype) {
+  const bs_event_listener_row *row = &runner->event_listeners[event_type];
+  if (subtype < 0 || (size_t)subtype >= row->subtype_count) {
+    return NULL;
+  }
+  return &row->lists[(size_t)subtype];
+}
+
+static bool bs_game_runner_add_listener(bs_game_runner *runner, int32_t event_type, int32_t subtype, uint32_t slot) {
+  bs_event_listener_row *row = &runner->event_listeners[event_type];
+  bs_event_listener_list *list = NULL;
+
+  if ((size_t)subtype >= row->subtype_count) {
+    size_t new_count = (row->subtype_count == 0) ? 16u : row->subtype_count;
+    bs_event_listener_list *grown = NULL;
+    while (new_count <= (size_t)subtype) {
+      new_count *= 2u;
+    }
+    grown = (bs_event_listener_list *)realloc(row->lists, new_count * sizeof(bs_event_listener_list));
+    if (grown == NULL) {
+      return false;
+    }
+    memset(grown + row->subtype_count, 0, (new_count - row->subtype_count) * sizeof(bs_event_listener_list));
+    row->lists = grown;
+    row->subtype_count = new_count;
+  }
+
+  list = &row->lists[(size_t)subtype];
+  if (list->count == list->capacity) {
+    size_t new_capacity = (list->capacity == 0) ? 16u : (list->capacity * 2u);
+    uint32_t *grown = (uint32_t *)realloc(list->instance_slots, new_capacity * sizeof(uint32_t));
+    if (grown == NULL) {
+      return false;
+    }
+    list->instance_slots = grown;
+    list->capacity = new_capacity;
+  }
+  list->instance_slots[list->count++] = slot;
+  return true;
+}
+
+/* Lists the instance under every broadcast event its flattened dispatch table handles. New instances
+ * are always the newest, so each list stays in creation order. Any failure drops back to scanning
+ * every instance until the next rebuild. */
+static void bs_game_runner_listen_instance(bs_game_runner *runner, const bs_instance *instance) {
+  const bs_object_dispatch *dispatch = NULL;
+  uint32_t slot = 0;
+
+  if (runner == NULL || instance == NULL || !runner->event_listeners_ready) {
+    return;
+  }
+  if (bs_game_data_object(runner->game_data, instance->object_index) == NULL) {
+    return;
+  }
+  slot = bs_instance_slot_index(instance);
+  dispatch = bs_game_runner_object_dispatch(runner, instance->object_index, 0);
+  if (dispatch == NULL) {
+    runner->event_listeners_ready = false;
+    return;
+  }
+
+  for (int32_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    const bs_event_dispatch_row *row = &dispatch->rows[t];
+    if (!bs_event_type_has_listeners(t)) {
+      continue;
+    }
+    for (size_t s = 0; s < row->slot_count; s++) {
+      int32_t subtype = row->slots[s].subtype;
+      if (subtype < 0 || subtype >= BS_EVENT_LISTENER_MAX_SUBTYPE) {
+        continue;
+      }
+      if (!bs_game_runner_add_listener(runner, t, subtype, slot)) {
+        runner->event_listeners_ready = false;
+        return;
+      }
+    }
+  }
+}
+
+static void bs_game_runner_reset_listeners(bs_game_runner *runner) {
+  for (size_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    bs_event_listener_row *row = &runner->event_listeners[t];
+    for (size_t s = 0; s < row->subtype_count; s++) {
+      row->lists[s].count = 0;
+    }
+  }
+  runner->event_listeners_ready = true;
+}
+
+/* Lists every live instance from scratch; used on room changes and to recover after a failed
+ * append. */
+static void bs_game_runner_rebuild_listeners(bs_game_runner *runner) {
+  bs_game_runner_reset_listeners(runner);
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    if (!inst->destroyed) {
+      bs_game_runner_listen_instance(runner, inst);
+    }
+  }
+}
+
+/* Marks the lists the instance was added to as holding a slot about to be released. Called before
+ * the slot is freed; bs_game_runner_drop_released_listeners then removes it. */
+static void bs_game_runner_unlisten_instance(bs_game_runner *runner, const bs_instance *instance) {
+  const bs_object_dispatch *dispatch = NULL;
+
+  if (!runner->event_listeners_ready || bs_game_data_object(runner->game_data, instance->object_index) == NULL) {
+    return;
+  }
+  dispatch = bs_game_runner_object_dispatch(runner, instance->object_index, 0);
+  if (dispatch == NULL) {
+    runner->event_listeners_ready = false;
+    return;
+  }
+  for (int32_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    const bs_event_dispatch_row *row = &dispatch->rows[t];
+    bs_event_listener_row *listeners = &runner->event_listeners[t];
+    if (!bs_event_type_has_listeners(t)) {
+      continue;
+    }
+    for (size_t s = 0; s < row->slot_count; s++) {
+      int32_t subtype = row->slots[s].subtype;
+      if (subtype >= 0 && (size_t)subtype < listeners->subtype_count) {
+        listeners->lists[(size_t)subtype].stale = true;
+      }
+    }
+  }
+}
+
+/* Drops released slots from every stale list in one order-preserving pass per list. Slots are only
+ * reused by the next creation, so a slot that is not live here is one this frame released. */
+static void bs_game_runner_drop_released_listeners(bs_game_runner *runner) {
+  for (size_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    bs_event_listener_row *row = &runner->event_listeners[t];
+    for (size_t s = 0; s < row->subtype_count; s++) {
+      bs_event_listener_list *list = &row->lists[s];
+      size_t kept = 0;
+      if (!list->stale) {
+        continue;
+      }
+      for (size_t i = 0; i < list->count; i++) {
+        const uint32_t slot = list->instance_slots[i];
+        const bs_instance *instance = bs_instance_pool_at(&runner->instance_pool, slot);
+        if (((const bs_instance_slot *)(const void *)instance)->live) {
+          list->instance_slots[kept++] = slot;
+        }
+      }
+      list->count = kept;
+      list->stale = false;
+    }
+  }
+}
+
+static void bs_game_runner_free_listeners(bs_game_runner *runner) {
+  for (size_t t = 0; t < BS_EVENT_TYPE_COUNT; t++) {
+    bs_event_listener_row *row = &runner->event_listeners[t];
+    for (size_t s = 0; s < row->subtype_count; s++) {
+      free(row->lists[s].instance_slots);
+    }
+    free(row->lists);
+    row->lists = NULL;
+    row->subtype_count = 0;
+  }
+  runner->event_listeners_ready = true;
+}
+
+static bs_instance_slot *bs_game_runner_slot_of(const bs_instance *instance) {
+  return (bs_instance_slot *)(void *)instance;
+}
+
+static bool bs_game_runner_registered(const bs_game_runner *runner, const bs_instance *instance) {
+  return runner->object_registry != NULL &&
+         instance->object_index >= 0 &&
+         (size_t)instance->object_index < runner->object_registry_count;
+}
+
+/* Adds or removes one live instance of the instance's object: its own count, then live_count on
+ * the object and every ancestor is_child_of would report. Parent cycles are cut at the first
+ * repeat. */
+static void bs_game_runner_count_instance(bs_game_runner *runner, const bs_instance *instance, bool live) {
+  int32_t seen[65];
+  size_t seen_count = 0;
+  int32_t current = instance->object_index;
+  if (!bs_game_runner_registered(runner, instance)) {
+    return;
+  }
+
+  if (live) {
+    runner->object_registry[(size_t)current].own_count++;
+  } else {
+    runner->object_registry[(size_t)current].own_count--;
+  }
+  while (current >= 0 && (size_t)current < runner->object_registry_count && seen_count < 65u) {
+    bs_object_registry *registry = &runner->object_registry[(size_t)current];
+    bool repeat = false;
+    for (size_t i = 0; i < seen_count && !repeat; i++) {
+      repeat = seen[i] == current;
+    }
+    if (repeat) {
+      break;
+    }
+    seen[seen_count++] = current;
+    if (live) {
+      registry->live_count++;
+    } else {
+      registry->live_count--;
+    }
+    current = registry->parent_object_index;
+  }
+}
+
+/* Appends a new instance to its object's list. It is the newest, so the list stays in creation
+ * order. */
+static void bs_game_runner_register_instance(bs_game_runner *runner, const bs_instance *instance) {
+  bs_object_registry *registry = NULL;
+  bs_instance_slot *slot = bs_game_runner_slot_of(instance);
+  if (!bs_game_runner_registered(runner, instance)) {
+    return;
+  }
+  registry = &runner->object_registry[(size_t)instance->object_index];
+  slot->object_prev = registry->tail;
+  slot->object_next = BS_INSTANCE_SLOT_NONE;
+  if (registry->tail != BS_INSTANCE_SLOT_NONE) {
+    bs_game_runner_slot_of(bs_instance_pool_at(&runner->instance_pool, registry->tail))->object_next = slot->index;
+  } else {
+    registry->head = slot->index;
+  }
+  registry->tail = slot->index;
+  if (!instance->destroyed) {
+    bs_game_runner_count_instance(runner, instance, true);
+  }
+}
+
+/* Unlinks an instance about to be released; it is only counted if it was never destroyed. */
+static void bs_game_runner_unregister_instance(bs_game_runner *runner, const bs_instance *instance) {
+  bs_object_registry *registry = NULL;
+  bs_instance_slot *slot = bs_game_runner_slot_of(instance);
+  if (!bs_game_runner_registered(runner, instance)) {
+    return;
+  }
+  registry = &runner->object_registry[(size_t)instance->object_index];
+  if (slot->object_prev != BS_INSTANCE_SLOT_NONE) {
+    bs_game_runner_slot_of(bs_instance_pool_at(&runner->instance_pool, slot->object_prev))->object_next =
+        slot->object_next;
+  } else {
+    registry->head = slot->object_next;
+  }
+  if (slot->object_next != BS_INSTANCE_SLOT_NONE) {
+    bs_game_runner_slot_of(bs_instance_pool_at(&runner->instance_pool, slot->object_next))->object_prev =
+        slot->object_prev;
+  } else {
+    registry->tail = slot->object_prev;
+  }
+  slot->object_prev = BS_INSTANCE_SLOT_NONE;
+  slot->object_next = BS_INSTANCE_SLOT_NONE;
+  if (!instance->destroyed) {
+    bs_game_runner_count_instance(runner, instance, false);
+  }
+}
+
+static void bs_game_runner_reset_registry(bs_game_runner *runner) {
+  for (size_t i = 0; i < runner->object_registry_count; i++) {
+    runner->object_registry[i].head = BS_INSTANCE_SLOT_NONE;
+    runner->object_registry[i].tail = BS_INSTANCE_SLOT_NONE;
+    runner->object_registry[i].own_count = 0;
+    runner->object_registry[i].live_count = 0;
+  }
+}
+
+/* Allocated with the object tables; without it every lookup scans the instance list. */
+static void bs_game_runner_build_registry(bs_game_runner *runner) {
+  const size_t count = runner->game_data->object_count;
+  runner->object_registry = (bs_object_registry *)malloc(count * sizeof(bs_object_registry));
+  if (runner->object_registry == NULL) {
+    return;
+  }
+  runner->object_registry_count = count;
+  for (size_t i = 0; i < count; i++) {
+    runner->object_registry[i].parent_object_index = bs_game_data_object_parent(runner->game_data, (int32_t)i);
+  }
+  bs_game_runner_reset_registry(runner);
+}
+
+/* Live instances that are object_index or a descendant of it, as instance_number counts them. */
+size_t bs_game_runner_object_instance_count(const bs_game_runner *runner, int32_t object_index) {
+  size_t count = 0;
+  if (runner == NULL || object_index < 0) {
+    return 0;
+  }
+  if (runner->object_registry != NULL && (size_t)object_index < runner->object_registry_count) {
+    return runner->object_registry[(size_t)object_index].live_count;
+  }
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    if (!inst->destroyed && bs_game_runner_object_is_child_of(runner, inst->object_index, object_index)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void bs_game_runner_iterate_instances(const bs_game_runner *runner, int32_t target, bs_instance_iterator *out_iterator) {
+  out_iterator->target = target;
+  out_iterator->walk = BS_INSTANCE_WALK_DONE;
+  out_iterator->current.slot = BS_INSTANCE_SLOT_NONE;
+  out_iterator->current.generation = 0;
+  out_iterator->sequence_limit = 0;
+  if (runner == NULL) {
+    return;
+  }
+  out_iterator->sequence_limit = runner->instance_pool.next_sequence;
+  if (target >= 100000) {
+    out_iterator->walk = BS_INSTANCE_WALK_ID;
+  } else if (target >= 0) {
+    const bool own_list = runner->object_registry != NULL &&
+                          (size_t)target < runner->object_registry_count &&
+                          runner->object_registry[(size_t)target].live_count ==
+                              runner->object_registry[(size_t)target].own_count;
+    out_iterator->walk = own_list ? BS_INSTANCE_WALK_OBJECT : BS_INSTANCE_WALK_ALL;
+  }
+}
+
+/* The next instance the walk visits, or NULL once it is over. */
+bs_instance *bs_game_runner_iterator_next(const bs_game_runner *runner, bs_instance_iterator *iterator) {
+  uint32_t at = BS_INSTANCE_SLOT_NONE;
+  if (runner == NULL || iterator == NULL) {
+    return NULL;
+  }
+
+  if (iterator->walk == BS_INSTANCE_WALK_ID) {
+    bs_instance *inst = bs_instance_pool_find_id(&runner->instance_pool, iterator->target);
+    iterator->walk = BS_INSTANCE_WALK_DONE;
+    return (inst != NULL && !inst->destroyed) ? inst : NULL;
+  }
+  if (iterator->walk == BS_INSTANCE_WALK_DONE) {
+    return NULL;
+  }
+
+  if (iterator->current.slot == BS_INSTANCE_SLOT_NONE) {
+    at = (iterator->walk == BS_INSTANCE_WALK_OBJECT) ? runner->object_registry[(size_t)iterator->target].head
+                                                      : runner->instance_pool.head;
+  } else {
+    const bs_instance *current = bs_instance_pool_resolve(&runner->instance_pool, iterator->current);
+    if (current == NULL) {
+      iterator->walk = BS_INSTANCE_WALK_DONE;
+      return NULL;
+    }
+    at = (iterator->walk == BS_INSTANCE_WALK_OBJECT) ? bs_game_runner_slot_of(current)->object_next
+                                                      : bs_game_runner_slot_of(current)->next;
+  }
+
+  while (at != BS_INSTANCE_SLOT_NONE) {
+    bs_instance *inst = bs_instance_pool_at(&runner->instance_pool, at);
+    if (bs_instance_sequence(inst) >= iterator->sequence_limit) {
+      break;
+    }
+    if (!inst->destroyed &&
+        (iterator->walk == BS_INSTANCE_WALK_OBJECT ||
+         bs_game_runner_object_is_child_of(runner, inst->object_index, iterator->target))) {
+      iterator->current = bs_instance_pool_handle(inst);
+      return inst;
+    }
+    at = (iterator->walk == BS_INSTANCE_WALK_OBJECT) ? bs_game_runner_slot_of(inst)->object_next
+                                                      : bs_game_runner_slot_of(inst)->next;
+  }
+  iterator->walk = BS_INSTANCE_WALK_DONE;
+  return NULL;
+}
+
+/* One table probe for the usual event types; anything the table does not cover walks the chain. */
+static const bs_event_entry *bs_game_runner_resolve_event(bs_game_runner *runner,
+                                                          int32_t object_index,
+                                                          int32_t event_type,
+                                                          int32_t subtype,
+                                                          int32_t *out_owner_object_index) {
+  if (event_type >= 0 && event_type < BS_EVENT_TYPE_COUNT) {
+    const bs_object_dispatch *dispatch = bs_game_runner_object_dispatch(runner, object_index, 0);
+    if (dispatch != NULL) {
+      const bs_event_dispatch_slot *slot = bs_dispatch_row_find(&dispatch->rows[event_type], subtype);
+      if (slot == NULL) {
+        return NULL;
+      }
+      if (out_owner_object_index != NULL) {
+        *out_owner_object_index = slot->owner_object_index;
+      }
+      return slot->entry;
+    }
+  }
+  return bs_game_runner_find_event_in_object_chain(runner, object_index, event_type, subtype, out_owner_object_index);
+}
+
+static void bs_game_runner_execute_event_entry(bs_game_runner *runner,
+                                               bs_instance *instance,
+                                               int32_t event_type,
+                                               int32_t subtype,
+                                               int32_t owner_object_index,
+                                               const bs_event_entry *event_entry,
+                                               int32_t other_instance_id) {
+  int32_t prev_self_id = 0;
+  int32_t prev_other_id = 0;
+  bool prev_context_active = false;
+  int32_t prev_event_type = 0;
+  int32_t prev_event_subtype = 0;
+  int32_t prev_event_object_index = 0;
+  const bool trace_vm = bs_trace_vm_enabled();
   if (runner == NULL ||
       instance == NULL ||
-      out_bbox == NULL ||
-      runner->game_data == NULL) {
+      instance->destroyed ||
+      runner->vm == NULL ||
+      event_entry == NULL) {
+    return;
+  }
+
+  prev_self_id = runner->vm->current_self_id;
+  prev_other_id = runner->vm->current_other_id;
+  prev_context_active = runner->event_context_active;
+  prev_event_type = runner->current_event_type;
+  prev_event_subtype = runner->current_event_subtype;
+  prev_event_object_index = runner->current_event_object_index;
+  runner->vm->current_self_id = instance->id;
+  runner->vm->current_other_id = other_instance_id;
+  runner->event_context_active = true;
+  runner->current_event_type = event_type;
+  runner->current_event_subtype = subtype;
+  runner->current_event_object_index = owner_object_index;
+
+  for (size_t i = 0; i < event_entry->action_count; i++) {
+    int32_t code_id = event_entry->actions[i].code_id;
+    if (code_id >= 0 && (size_t)code_id < runner->game_data->code_entry_count) {
+      bs_vm_execute_result result = {0};
+      if (runner->trace_events) {
+        const bs_code_entry_data *trace_entry = &runner->game_data->code_entries[(size_t)code_id];
+        printf("  [EVT] room=%d obj=%d inst=%d evt=%d sub=%d code=%d name=%s\n",
+               runner->current_room_index,
+               instance->object_index,
+               instance->id,
+               event_type,
+               subtype,
+               code_id,
+               trace_entry->name != NULL ? trace_entry->name : "<unnamed>");
+      }
+      bool ok = bs_vm_execute_code(runner->vm,
+                                   (size_t)code_id,
+                                   120000u,
+                                   (runner->trace_events && trace_vm),
+                                   &result);
+      runner->total_vm_event_calls++;
+      runner->total_vm_instructions += result.instructions_executed;
+      if (!ok || result.exit_reason == BS_VM_EXIT_ERROR) {
+        const bs_code_entry_data *entry = &runner->game_data->code_entries[(size_t)code_id];
+        printf("  VM event error: obj=%d inst=%d code=%d name=%s ok=%s reason=%s instructions=%u\n",
+               instance->object_index,
+               instance->id,
+               code_id,
+               entry->name != NULL ? entry->name : "<unnamed>",
+               ok ? "true" : "false",
+               bs_vm_exit_reason_to_string(result.exit_reason),
+               (unsigned)result.instructions_executed);
+      }
+    }
+  }
+
+  runner->vm->current_self_id = prev_self_id;
+  runner->vm->current_other_id = prev_other_id;
+  runner->event_context_active = prev_context_active;
+  runner->current_event_type = prev_event_type;
+  runner->current_event_subtype = prev_event_subtype;
+  runner->current_event_object_index = prev_event_object_index;
+}
+
+void bs_game_runner_fire_event_inherited(bs_game_runner *runner, bs_instance *instance) {
+  const bs_event_entry *event_entry = NULL;
+  const bs_object_dispatch *current_dispatch = NULL;
+  int32_t owner_object_index = -1;
+  int32_t parent_object_index = -1;
+  if (runner == NULL ||
+      instance == NULL ||
+      instance->destroyed ||
+      runner->game_data == NULL ||
+      !runner->event_context_active) {
+    return;
+  }
+
+  current_dispatch = bs_game_runner_object_dispatch(runner, runner->current_event_object_index, 0);
+  if (current_dispatch != NULL) {
+    parent_object_index = current_dispatch->parent_object_index;
+  } else {
+    const bs_game_object_data *current_object =
+        bs_game_data_object(runner->game_data, runner->current_event_object_index);
+    if (current_object == NULL) {
+      return;
+    }
+    parent_object_index = current_object->parent_id;
+  }
+  if (parent_object_index < 0) {
+    return;
+  }
+
+  event_entry = bs_game_runner_resolve_event(runner,
+                                             parent_object_index,
+                                             runner->current_event_type,
+                                             runner->current_event_subtype,
+                                             &owner_object_index);
+  if (event_entry == NULL) {
+    return;
+  }
+
+  bs_game_runner_execute_event_entry(runner,
+                                     instance,
+                                     runner->current_event_type,
+                                     runner->current_event_subtype,
+                                     owner_object_index,
+                                     event_entry,
+                                     instance->id);
+}
+
+static void bs_game_runner_fire_event(bs_game_runner *runner,
+                                      bs_instance *instance,
+                                      int32_t event_type,
+                                      int32_t subtype,
+                                      bs_instance *other_instance) {
+  const bs_event_entry *event_entry = NULL;
+  int32_t owner_object_index = -1;
+  if (runner == NULL || instance == NULL || instance->destroyed || runner->vm == NULL) {
+    return;
+  }
+
+  event_entry = bs_game_runner_resolve_event(runner, instance->object_index, event_type, subtype, &owner_object_index);
+  if (event_entry == NULL) {
+    return;
+  }
+
+  bs_game_runner_execute_event_entry(runner,
+                                     instance,
+                                     event_type,
+                                     subtype,
+                                     owner_object_index,
+                                     event_entry,
+                                     other_instance != NULL ? other_instance->id : instance->id);
+}
+
+void bs_game_runner_fire_event_for_instance(bs_game_runner *runner,
+                                            bs_instance *instance,
+                                            int32_t event_type,
+                                            int32_t subtype) {
+  bs_game_runner_fire_event(runner, instance, event_type, subtype, NULL);
+}
+
+void bs_game_runner_path_end_instance(bs_game_runner *runner, bs_instance *instance) {
+  (void)runner;
+  if (instance == NULL) {
+    return;
+  }
+  instance->path_index = -1;
+  instance->path_speed = 0.0;
+}
+
+bs_instance *bs_game_runner_create_instance_runtime(bs_game_runner *runner,
+                                                    int32_t object_index,
+                                                    double x,
+                                                    double y,
+                                                    bool run_create_event) {
+  bs_instance *created = NULL;
+  if (runner == NULL || runner->game_data == NULL || object_index < 0) {
+    return NULL;
+  }
+  if ((size_t)object_index >= runner->game_data->object_count) {
+    return NULL;
+  }
+
+  created = bs_game_runner_create_instance(runner, object_index, x, y, -1);
+  if (created == NULL) {
+    return NULL;
+  }
+
+  if (run_create_event) {
+    bs_game_runner_fire_event(runner, created, BS_EVENT_CREATE, 0, NULL);
+  }
+  return created;
+}
+
+/* Fires for the listed instances only. Instances created by a handler land past the snapshot and
+ * wait for the next broadcast, as they did when this scanned every instance. */
+static void bs_game_runner_dispatch_event_all(bs_game_runner *runner, int32_t event_type, int32_t subtype) {
+  const bs_event_listener_list *list = NULL;
+  bs_instance *last = NULL;
+  size_t snapshot_count = 0;
+  if (runner == NULL) {
+    return;
+  }
+
+  if (runner->event_listeners_ready &&
+      bs_event_type_has_listeners(event_type) &&
+      subtype >= 0 &&
+      subtype < BS_EVENT_LISTENER_MAX_SUBTYPE) {
+    list = bs_game_runner_listener_list(runner, event_type, subtype);
+    snapshot_count = (list != NULL) ? list->count : 0;
+    for (size_t i = 0; i < snapshot_count; i++) {
+      /* Handlers that create instances can grow the lists, so re-fetch every time. */
+      list = bs_game_runner_listener_list(runner, event_type, subtype);
+      if (list == NULL || i >= list->count) {
+        break;
+      }
+      bs_game_runner_fire_event(runner,
+                                bs_instance_pool_at(&runner->instance_pool, list->instance_slots[i]),
+                                event_type,
+                                subtype,
+                                NULL);
+    }
+    return;
+  }
+
+  last = bs_instance_pool_last(&runner->instance_pool);
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    bs_game_runner_fire_event(runner, inst, event_type, subtype, NULL);
+    if (inst == last) {
+      break;
+    }
+  }
+}
+
+static bool bs_game_runner_contains_subtype(const int32_t *subtypes, size_t count, int32_t subtype) {
+  for (size_t i = 0; i < count; i++) {
+    if (subtypes[i] == subtype) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* instance's box from its sprite margins as if it stood at (x, y). */
+bool bs_game_runner_instance_bbox_at(const bs_game_runner *runner,
+                                     const bs_instance *instance,
+                                     double x,
+                                     double y,
+                                     bs_bbox *out_bbox) {
+  int32_t sprite_index = 0;
+  const bs_sprite_data *sprite = NULL;
+  double x1 = 0.0;
+  double x2 = 0.0;
+  double y1 = 0.0;
+  double y2 = 0.0;
+  if (runner == NULL || instance == NULL || out_bbox == NULL || runner->game_data == NULL) {
     return false;
   }
 
   sprite_index = (instance->mask_index >= 0) ? instance->mask_index : instance->sprite_index;
-  if (sprite_index < 0 || (size_t)sprite_index >= runner->game_data->sprite_count) {
+  sprite = bs_game_data_sprite(runner->game_data, sprite_index);
+  if (sprite == NULL) {
     return false;
   }
-  sprite = &runner->game_data->sprites[(size_t)sprite_index];
 
-  x1 = instance->x + (((double)sprite->margin_left - (double)sprite->origin_x) * instance->image_xscale);
-  x2 = instance->x + ((((double)sprite->margin_right + 1.0) - (double)sprite->origin_x) * instance->image_xscale);
-  y1 = instance->y + (((double)sprite->margin_top - (double)sprite->origin_y) * instance->image_yscale);
-  y2 = instance->y + ((((double)sprite->margin_bottom + 1.0) - (double)sprite->origin_y) * instance->image_yscale);
+  x1 = x + (((double)sprite->margin_left - (double)sprite->origin_x) * instance->image_xscale);
+  x2 = x + ((((double)sprite->margin_right + 1.0) - (double)sprite->origin_x) * instance->image_xscale);
+  y1 = y + (((double)sprite->margin_top - (double)sprite->origin_y) * instance->image_yscale);
+  y2 = y + ((((double)sprite->margin_bottom + 1.0) - (double)sprite->origin_y) * instance->image_yscale);
 
   out_bbox->left = fmin(x1, x2);
   out_bbox->right = fmax(x1, x2);
@@ -1181,19 +1967,201 @@ bool bs_game_runner_compute_instance_bbox(const bs_game_runner *runner,
   return true;
 }
 
+/* Recomputes instance's box at its position into the slot cache. */
+static void bs_game_runner_measure_instance_bbox(bs_game_runner *runner, const bs_instance *instance) {
+  bs_instance_motion_columns *motion = bs_instance_motion_of(instance);
+  const uint32_t slot = bs_instance_slot_index(instance);
+  bs_bbox bbox = {0};
+
+  if (!bs_game_runner_instance_bbox_at(runner, instance, BS_MOTION(instance, x), BS_MOTION(instance, y), &bbox)) {
+    motion->bbox_state[slot] = BS_BBOX_NONE;
+    return;
+  }
+  motion->bbox_left[slot] = bbox.left;
+  motion->bbox_right[slot] = bbox.right;
+  motion->bbox_top[slot] = bbox.top;
+  motion->bbox_bottom[slot] = bbox.bottom;
+  motion->bbox_state[slot] = BS_BBOX_READY;
+}
+
+/* Reads the cached box, measuring it into the cache first if one of its inputs changed since the
+ * last read. */
+bool bs_game_runner_compute_instance_bbox(bs_game_runner *runner,
+                                          const bs_instance *instance,
+                                          bs_bbox *out_bbox) {
+  const bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
+  if (runner == NULL ||
+      instance == NULL ||
+      out_bbox == NULL ||
+      runner->game_data == NULL) {
+    return false;
+  }
+
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+  if (motion->bbox_state[slot] == BS_BBOX_DIRTY) {
+    bs_game_runner_measure_instance_bbox(runner, instance);
+  }
+  if ((motion->bbox_state[slot] & BS_BBOX_STATE_MASK) != BS_BBOX_READY) {
+    return false;
+  }
+  out_bbox->left = motion->bbox_left[slot];
+  out_bbox->right = motion->bbox_right[slot];
+  out_bbox->top = motion->bbox_top[slot];
+  out_bbox->bottom = motion->bbox_bottom[slot];
+  return true;
+}
+
+/* Reads instance's box without writing anything: the cached box when it is current, otherwise one
+ * measured on the spot and not stored. The collision threads read boxes only through this, after
+ * bs_game_runner_refresh_bboxes has filled every live one, so they always take the cached branch
+ * and never race on the slot columns. */
+bool bs_game_runner_read_instance_bbox(const bs_game_runner *runner,
+                                       const bs_instance *instance,
+                                       bs_bbox *out_bbox) {
+  const bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
+  if (runner == NULL ||
+      instance == NULL ||
+      out_bbox == NULL ||
+      runner->game_data == NULL) {
+    return false;
+  }
+
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+  if (motion->bbox_state[slot] == BS_BBOX_DIRTY) {
+    return bs_game_runner_instance_bbox_at(runner, instance, BS_MOTION(instance, x), BS_MOTION(instance, y), out_bbox);
+  }
+  if ((motion->bbox_state[slot] & BS_BBOX_STATE_MASK) != BS_BBOX_READY) {
+    return false;
+  }
+  out_bbox->left = motion->bbox_left[slot];
+  out_bbox->right = motion->bbox_right[slot];
+  out_bbox->top = motion->bbox_top[slot];
+  out_bbox->bottom = motion->bbox_bottom[slot];
+  return true;
+}
+
+/* Measures every live box the motion and step passes left dirty in one walk over the slot columns,
+ * so the collision passes that follow only read the cache. */
+static void bs_game_runner_refresh_bboxes(bs_game_runner *runner) {
+  const bs_instance_motion_columns *motion = &runner->instance_pool.motion;
+  if (runner->game_data == NULL) {
+    return;
+  }
+  for (size_t slot = 0; slot < runner->instance_pool.slot_count; slot++) {
+    if (motion->active[slot] && motion->bbox_state[slot] == BS_BBOX_DIRTY) {
+      bs_game_runner_measure_instance_bbox(runner, bs_instance_pool_at(&runner->instance_pool, (uint32_t)slot));
+    }
+  }
+}
+
+/* Places instance's collision mask (mask_index, else sprite_index) at its position and scale, using
+ * the subimage under image_index when the sprite has one mask per frame. Returns true only for a
+ * precise mask; otherwise out_mask, when filled, is the margin rectangle its box already describes. */
+bool bs_game_runner_instance_mask(const bs_game_runner *runner,
+                                  const bs_instance *instance,
+                                  bs_collision_mask *out_mask) {
+  const bs_sprite_data *sprite = NULL;
+  size_t frame = 0;
+  if (runner == NULL || instance == NULL || out_mask == NULL || runner->game_data == NULL) {
+    return false;
+  }
+
+  sprite = bs_game_data_sprite(runner->game_data,
+                               (instance->mask_index >= 0) ? instance->mask_index : instance->sprite_index);
+  if (sprite == NULL) {
+    return false;
+  }
+  if (sprite->collision_masks != NULL && sprite->collision_mask_count > 1u) {
+    const double image_index = floor(BS_MOTION(instance, image_index));
+    const double count = (double)sprite->collision_mask_count;
+    if (isfinite(image_index)) {
+      const double wrapped = fmod(image_index, count);
+      frame = (size_t)((wrapped < 0.0) ? wrapped + count : wrapped);
+    }
+  }
+
+  out_mask->rows = (sprite->collision_masks != NULL)
+                       ? &sprite->collision_masks[frame * (size_t)sprite->height * sprite->collision_mask_stride]
+                       : NULL;
+  out_mask->stride = sprite->collision_mask_stride;
+  out_mask->width = sprite->width;
+  out_mask->height = sprite->height;
+  out_mask->margin_left = sprite->margin_left;
+  out_mask->margin_top = sprite->margin_top;
+  out_mask->margin_right = sprite->margin_right;
+  out_mask->margin_bottom = sprite->margin_bottom;
+  out_mask->origin_x = sprite->origin_x;
+  out_mask->origin_y = sprite->origin_y;
+  out_mask->x = BS_MOTION(instance, x);
+  out_mask->y = BS_MOTION(instance, y);
+  out_mask->xscale = instance->image_xscale;
+  out_mask->yscale = instance->image_yscale;
+  return out_mask->rows != NULL;
+}
+
+/* a's box and mask stand at (ax, ay) with a_bbox already measured there. Boxes first; when either
+ * side has a precise mask the hit is confirmed pixel by pixel over the box intersection. */
+static bool bs_game_runner_overlap_from(const bs_game_runner *runner,
+                                        const bs_instance *a,
+                                        const bs_bbox *a_bbox,
+                                        double ax,
+                                        double ay,
+                                        const bs_instance *b) {
+  bs_bbox b_bbox = {0};
+  bs_bbox region = {0};
+  bs_collision_mask a_mask = {0};
+  bs_collision_mask b_mask = {0};
+  bool a_precise = false;
+  bool b_precise = false;
+  if (!bs_game_runner_read_instance_bbox(runner, b, &b_bbox)) {
+    return false;
+  }
+  if (!(a_bbox->left < b_bbox.right &&
+        a_bbox->right > b_bbox.left &&
+        a_bbox->top < b_bbox.bottom &&
+        a_bbox->bottom > b_bbox.top)) {
+    return false;
+  }
+
+  a_precise = bs_game_runner_instance_mask(runner, a, &a_mask);
+  b_precise = bs_game_runner_instance_mask(runner, b, &b_mask);
+  if (!a_precise && !b_precise) {
+    return true;
+  }
+  a_mask.x = ax;
+  a_mask.y = ay;
+  region.left = fmax(a_bbox->left, b_bbox.left);
+  region.right = fmin(a_bbox->right, b_bbox.right);
+  region.top = fmax(a_bbox->top, b_bbox.top);
+  region.bottom = fmin(a_bbox->bottom, b_bbox.bottom);
+  return bs_collision_masks_overlap(&a_mask, &b_mask, &region);
+}
+
 bool bs_game_runner_instances_overlap(const bs_game_runner *runner,
                                       const bs_instance *a,
                                       const bs_instance *b) {
   bs_bbox a_bbox = {0};
-  bs_bbox b_bbox = {0};
-  if (!bs_game_runner_compute_instance_bbox(runner, a, &a_bbox) ||
-      !bs_game_runner_compute_instance_bbox(runner, b, &b_bbox)) {
+  if (!bs_game_runner_read_instance_bbox(runner, a, &a_bbox)) {
+    return false;
+  }
+  return bs_game_runner_overlap_from(runner, a, &a_bbox, BS_MOTION(a, x), BS_MOTION(a, y), b);
+}
+
+/* Whether a would overlap b if it stood at (x, y); b stays where it is. */
+bool bs_game_runner_instance_overlaps_at(const bs_game_runner *runner,
+                                         const bs_instance *a,
+                                         double x,
+                                         double y,
+                                         const bs_instance *b) {
+  bs_bbox a_bbox = {0};
+  if (!bs_game_runner_instance_bbox_at(runner, a, x, y, &a_bbox)) {
     return false;
   }
-  return a_bbox.left < b_bbox.right &&
-         a_bbox.right > b_bbox.left &&
-         a_bbox.top < b_bbox.bottom &&
-         a_bbox.bottom > b_bbox.top;
+  return bs_game_runner_overlap_from(runner, a, &a_bbox, x, y, b);
 }
 
 static size_t bs_game_runner_collect_collision_targets(const bs_game_runner *runner,
@@ -1210,10 +2178,10 @@ static size_t bs_game_runner_collect_collision_targets(const bs_game_runner *run
   while (depth < 64) {
     const bs_game_object_data *obj = NULL;
     const bs_object_event_list *collision_events = NULL;
-    if (current < 0 || (size_t)current >= runner->game_data->object_count) {
+    obj = bs_game_data_object(runner->game_data, current);
+    if (obj == NULL) {
       break;
     }
-    obj = &runner->game_data->objects[(size_t)current];
     if ((size_t)BS_EVENT_COLLISION < obj->event_type_count) {
       collision_events = &obj->events[(size_t)BS_EVENT_COLLISION];
       for (size_t i = 0; i < collision_events->entry_count; i++) {
@@ -1241,6 +2209,21 @@ static size_t bs_game_runner_collect_collision_targets(const bs_game_runner *run
   return count;
 }
 
+/* object_index's collision targets from its dispatch table, in the order the chain walk above
+ * produces them. Returns false if the table could not be built; callers then walk the chain. */
+static bool bs_game_runner_collision_targets(bs_game_runner *runner,
+                                             int32_t object_index,
+                                             const int32_t **out_targets,
+                                             size_t *out_count) {
+  const bs_object_dispatch *dispatch = bs_game_runner_object_dispatch(runner, object_index, 0);
+  if (dispatch == NULL) {
+    return false;
+  }
+  *out_targets = dispatch->collision_targets;
+  *out_count = dispatch->collision_target_count;
+  return true;
+}
+
 static void bs_game_runner_update_direction_from_path(bs_instance *instance,
                                                       double old_x,
                                                       double old_y,
@@ -1255,7 +2238,7 @@ static void bs_game_runner_update_direction_from_path(bs_instance *instance,
   dx = new_x - old_x;
   dy = new_y - old_y;
   if (dx != 0.0 || dy != 0.0) {
-    instance->direction = fmod((atan2(-dy, dx) * (180.0 / pi)) + 360.0, 360.0);
+    BS_MOTION(instance, direction) = fmod((atan2(-dy, dx) * (180.0 / pi)) + 360.0, 360.0);
   }
 }
 
@@ -1266,10 +2249,10 @@ static double bs_game_runner_compute_path_length(const bs_game_runner *runner, i
   if (runner == NULL || runner->game_data == NULL) {
     return 0.0;
   }
-  if (path_index < 0 || (size_t)path_index >= runner->game_data->path_count) {
+  path = bs_game_data_path(runner->game_data, path_index);
+  if (path == NULL) {
     return 0.0;
   }
-  path = &runner->game_data->paths[(size_t)path_index];
   if (path->point_count < 2) {
     return 0.0;
   }
@@ -1299,10 +2282,10 @@ static bool bs_game_runner_interpolate_path_position(const bs_game_runner *runne
   if (out_x == NULL || out_y == NULL || runner == NULL || runner->game_data == NULL) {
     return false;
   }
-  if (path_index < 0 || (size_t)path_index >= runner->game_data->path_count) {
+  path = bs_game_data_path(runner->game_data, path_index);
+  if (path == NULL) {
     return false;
   }
-  path = &runner->game_data->paths[(size_t)path_index];
   if (path->point_count == 0) {
     return false;
   }
@@ -1364,8 +2347,8 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
     return;
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     double path_length = 0.0;
     double old_x = 0.0;
     double old_y = 0.0;
@@ -1378,8 +2361,8 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
       continue;
     }
 
-    old_x = inst->x;
-    old_y = inst->y;
+    old_x = BS_MOTION(inst, x);
+    old_y = BS_MOTION(inst, y);
     inst->path_position += inst->path_speed / path_length;
 
     if (inst->path_position >= 1.0) {
@@ -1393,8 +2376,9 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
             new_x += inst->path_x_offset;
             new_y += inst->path_y_offset;
             bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
-            inst->x = new_x;
-            inst->y = new_y;
+            BS_MOTION(inst, x) = new_x;
+            BS_MOTION(inst, y) = new_y;
+            bs_game_runner_note_bbox_change(runner, inst);
           }
           continue;
         }
@@ -1410,12 +2394,13 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
             new_x += inst->path_x_offset;
             new_y += inst->path_y_offset;
             bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
-            inst->x = new_x;
-            inst->y = new_y;
+            BS_MOTION(inst, x) = new_x;
+            BS_MOTION(inst, y) = new_y;
+            bs_game_runner_note_bbox_change(runner, inst);
           }
-          inst->speed = speed;
-          inst->hspeed = speed * cos(inst->direction * (pi / 180.0));
-          inst->vspeed = -speed * sin(inst->direction * (pi / 180.0));
+          BS_MOTION(inst, speed) = speed;
+          BS_MOTION(inst, hspeed) = speed * cos(BS_MOTION(inst, direction) * (pi / 180.0));
+          BS_MOTION(inst, vspeed) = -speed * sin(BS_MOTION(inst, direction) * (pi / 180.0));
           bs_game_runner_path_end_instance(runner, inst);
           continue;
         }
@@ -1437,8 +2422,9 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
             new_x += inst->path_x_offset;
             new_y += inst->path_y_offset;
             bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
-            inst->x = new_x;
-            inst->y = new_y;
+            BS_MOTION(inst, x) = new_x;
+            BS_MOTION(inst, y) = new_y;
+            bs_game_runner_note_bbox_change(runner, inst);
           }
           continue;
         }
@@ -1454,12 +2440,13 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
             new_x += inst->path_x_offset;
             new_y += inst->path_y_offset;
             bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
-            inst->x = new_x;
-            inst->y = new_y;
+            BS_MOTION(inst, x) = new_x;
+            BS_MOTION(inst, y) = new_y;
+            bs_game_runner_note_bbox_change(runner, inst);
           }
-          inst->speed = speed;
-          inst->hspeed = speed * cos(inst->direction * (pi / 180.0));
-          inst->vspeed = -speed * sin(inst->direction * (pi / 180.0));
+          BS_MOTION(inst, speed) = speed;
+          BS_MOTION(inst, hspeed) = speed * cos(BS_MOTION(inst, direction) * (pi / 180.0));
+          BS_MOTION(inst, vspeed) = -speed * sin(BS_MOTION(inst, direction) * (pi / 180.0));
           bs_game_runner_path_end_instance(runner, inst);
           continue;
         }
@@ -1472,30 +2459,720 @@ static void bs_game_runner_update_path_following(bs_game_runner *runner) {
       }
     }
 
-    {
-      double new_x = 0.0;
-      double new_y = 0.0;
-      if (inst->path_index >= 0 &&
-          bs_game_runner_interpolate_path_position(runner, inst->path_index, inst->path_position, &new_x, &new_y)) {
-        new_x += inst->path_x_offset;
-        new_y += inst->path_y_offset;
-        bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
-        inst->x = new_x;
-        inst->y = new_y;
+    {
+      double new_x = 0.0;
+      double new_y = 0.0;
+      if (inst->path_index >= 0 &&
+          bs_game_runner_interpolate_path_position(runner, inst->path_index, inst->path_position, &new_x, &new_y)) {
+        new_x += inst->path_x_offset;
+        new_y += inst->path_y_offset;
+        bs_game_runner_update_direction_from_path(inst, old_x, old_y, new_x, new_y);
+        BS_MOTION(inst, x) = new_x;
+        BS_MOTION(inst, y) = new_y;
+        bs_game_runner_note_bbox_change(runner, inst);
+      }
+    }
+  }
+}
+
+/* Called wherever x, y, sprite_index, mask_index or the image scales change, and when a slot is
+ * (re)used. Drops the cached box, queues the slot for re-binning in the query grid and, while
+ * collision dispatch is running, in the collision grid too. */
+void bs_game_runner_note_bbox_change(bs_game_runner *runner, const bs_instance *instance) {
+  uint32_t slot = 0;
+  if (instance == NULL) {
+    return;
+  }
+  bs_instance_invalidate_bbox(instance);
+  if (runner == NULL) {
+    return;
+  }
+  slot = bs_instance_slot_index(instance);
+  if (runner->query_grid_ready) {
+    if ((size_t)slot < runner->query_grid.entry_count) {
+      bs_collision_grid_note_moved(&runner->query_grid, slot);
+    } else {
+      runner->query_grid_ready = false;
+    }
+  }
+  if (!runner->collision_tracking) {
+    return;
+  }
+  if ((size_t)slot < runner->collision_entry_of_slot_capacity &&
+      runner->collision_entry_of_slot[slot] != BS_INSTANCE_SLOT_NONE) {
+    bs_collision_grid_note_moved(&runner->collision_grid, runner->collision_entry_of_slot[slot]);
+  }
+}
+
+/* Called when image_index changes. The box, its grid cells and the baked flag all stay; only a
+ * per-frame mask may differ, so while collision dispatch is running the cells under the box are
+ * marked changed and precomputed narrowphase results there are searched again. */
+static void bs_game_runner_note_mask_change(bs_game_runner *runner, const bs_instance *instance) {
+  bs_bbox bbox = {0};
+  if (runner == NULL || instance == NULL || !runner->collision_tracking) {
+    return;
+  }
+  if (bs_game_runner_compute_instance_bbox(runner, instance, &bbox)) {
+    bs_collision_grid_mark_changed(&runner->collision_grid, &bbox);
+  }
+}
+
+static bool bs_game_runner_instance_baked(const bs_instance *instance) {
+  return (bs_instance_motion_of(instance)->bbox_state[bs_instance_slot_index(instance)] & BS_BBOX_BAKED) != 0;
+}
+
+/* Nothing is set up to move the instance: no step event in its object chain, no path and no
+ * motion. Whatever moves it later anyway un-bakes it through the bbox invalidation. */
+static bool bs_game_runner_instance_looks_static(bs_game_runner *runner, const bs_instance *inst) {
+  bs_bbox bbox = {0};
+  if (inst->destroyed ||
+      inst->path_index >= 0 ||
+      BS_MOTION(inst, speed) != 0.0 ||
+      BS_MOTION(inst, hspeed) != 0.0 ||
+      BS_MOTION(inst, vspeed) != 0.0 ||
+      BS_MOTION(inst, gravity) != 0.0) {
+    return false;
+  }
+  for (int32_t subtype = 0; subtype <= 2; subtype++) {
+    if (bs_game_runner_resolve_event(runner, inst->object_index, BS_EVENT_STEP, subtype, NULL) != NULL) {
+      return false;
+    }
+  }
+  return bs_game_runner_compute_instance_bbox(runner, inst, &bbox);
+}
+
+static void bs_game_runner_unbake_static_instances(bs_game_runner *runner) {
+  for (size_t i = 0; i < runner->static_entry_count; i++) {
+    const bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, runner->static_entries[i]);
+    if (inst != NULL) {
+      bs_instance_motion_of(inst)->bbox_state[bs_instance_slot_index(inst)] &= (uint8_t)~BS_BBOX_BAKED;
+    }
+  }
+  runner->static_entry_count = 0;
+  runner->query_grid_ready = false;
+}
+
+/* Runs once a room is set up. Static-looking instances go into static_grid, which is built once
+ * per room, and are left out of the per-frame collision grid and solid sweep list. An instance
+ * stays baked only while its box is untouched, so lookups skip entries that lost the flag. */
+static void bs_game_runner_bake_static_instances(bs_game_runner *runner) {
+  size_t count = 0;
+  bs_game_runner_unbake_static_instances(runner);
+  if (runner->current_room == NULL) {
+    return;
+  }
+
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    if (!bs_game_runner_instance_looks_static(runner, inst)) {
+      continue;
+    }
+    if (count == runner->static_entry_capacity) {
+      size_t capacity = (runner->static_entry_capacity == 0) ? 64u : (runner->static_entry_capacity * 2u);
+      bs_instance_handle *grown =
+          (bs_instance_handle *)realloc(runner->static_entries, capacity * sizeof(bs_instance_handle));
+      if (grown == NULL) {
+        return;
+      }
+      runner->static_entries = grown;
+      runner->static_entry_capacity = capacity;
+    }
+    runner->static_entries[count++] = bs_instance_pool_handle(inst);
+  }
+  if (count == 0 ||
+      !bs_collision_grid_reset(&runner->static_grid,
+                               (double)runner->current_room->width,
+                               (double)runner->current_room->height,
+                               count)) {
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, runner->static_entries[i]);
+    bs_bbox bbox = {0};
+    if (inst == NULL || !bs_game_runner_compute_instance_bbox(runner, inst, &bbox) ||
+        !bs_collision_grid_place(&runner->static_grid, (uint32_t)i, &bbox)) {
+      return;
+    }
+  }
+  for (size_t i = 0; i < count; i++) {
+    const bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, runner->static_entries[i]);
+    bs_instance_motion_of(inst)->bbox_state[bs_instance_slot_index(inst)] |= BS_BBOX_BAKED;
+  }
+  runner->static_entry_count = count;
+  runner->query_grid_ready = false;
+}
+
+/* Static-grid entry i, if it is still baked. */
+static bs_instance *bs_game_runner_static_instance(const bs_game_runner *runner, uint32_t i) {
+  bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, runner->static_entries[i]);
+  if (inst == NULL || inst->destroyed || !bs_game_runner_instance_baked(inst)) {
+    return NULL;
+  }
+  return inst;
+}
+
+/* Places slot in the query grid under its cached box, or removes it if it is gone, baked or has
+ * no box. */
+static bool bs_game_runner_place_query_slot(bs_game_runner *runner, uint32_t slot) {
+  const bs_instance *inst = bs_instance_pool_at(&runner->instance_pool, slot);
+  bs_bbox bbox = {0};
+
+  if (!runner->instance_pool.motion.active[slot] ||
+      bs_game_runner_instance_baked(inst) ||
+      !bs_game_runner_compute_instance_bbox(runner, inst, &bbox)) {
+    return bs_collision_grid_place(&runner->query_grid, slot, NULL);
+  }
+  return bs_collision_grid_place(&runner->query_grid, slot, &bbox);
+}
+
+/* Brings query_grid up to date. It is rebuilt after anything that moves boxes wholesale (the
+ * motion pass, baking, a pool that outgrew it) and otherwise only re-bins the slots reported
+ * through bs_game_runner_note_bbox_change since the last query. */
+static bool bs_game_runner_sync_query_grid(bs_game_runner *runner) {
+  const double room_w = (runner->current_room != NULL) ? (double)runner->current_room->width : 0.0;
+  const double room_h = (runner->current_room != NULL) ? (double)runner->current_room->height : 0.0;
+  const size_t slot_count = runner->instance_pool.slot_count;
+  const uint32_t *moved = NULL;
+  size_t moved_count = 0;
+
+  if (!runner->query_grid_ready) {
+    bs_game_runner_refresh_bboxes(runner);
+    if (!bs_collision_grid_reset(&runner->query_grid, room_w, room_h, slot_count)) {
+      return false;
+    }
+    for (size_t slot = 0; slot < slot_count; slot++) {
+      if (!bs_game_runner_place_query_slot(runner, (uint32_t)slot)) {
+        return false;
+      }
+    }
+    runner->query_grid_ready = true;
+    return true;
+  }
+
+  moved = bs_collision_grid_drain_moved(&runner->query_grid, &moved_count);
+  for (size_t i = 0; i < moved_count; i++) {
+    if (!bs_game_runner_place_query_slot(runner, moved[i])) {
+      runner->query_grid_ready = false;
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool bs_game_runner_reserve_query_results(bs_game_runner *runner, size_t count) {
+  uint32_t *grown = NULL;
+  size_t capacity = 0;
+  if (count <= runner->query_result_capacity) {
+    return true;
+  }
+  capacity = (runner->query_result_capacity == 0) ? 64u : runner->query_result_capacity;
+  while (capacity < count) {
+    capacity *= 2u;
+  }
+  grown = (uint32_t *)realloc(runner->query_results, capacity * sizeof(uint32_t));
+  if (grown == NULL) {
+    return false;
+  }
+  runner->query_results = grown;
+  runner->query_result_capacity = capacity;
+  return true;
+}
+
+/* Pool slots of the instances whose boxes may touch bbox: a superset, in no particular order, and
+ * possibly including slots that are no longer active. Live instances come from query_grid and
+ * baked ones from static_grid. If the grid cannot be built every active slot is returned. The
+ * array is valid until the next call. */
+const uint32_t *bs_game_runner_query_instances(bs_game_runner *runner, const bs_bbox *bbox, size_t *out_count) {
+  const uint32_t *dynamic = NULL;
+  const uint32_t *statics = NULL;
+  size_t dynamic_count = 0;
+  size_t static_count = 0;
+  size_t count = 0;
+  if (out_count != NULL) {
+    *out_count = 0;
+  }
+  if (runner == NULL || bbox == NULL || out_count == NULL || runner->game_data == NULL) {
+    return NULL;
+  }
+
+  if (!bs_game_runner_sync_query_grid(runner)) {
+    const size_t slot_count = runner->instance_pool.slot_count;
+    if (!bs_game_runner_reserve_query_results(runner, slot_count)) {
+      return NULL;
+    }
+    for (size_t slot = 0; slot < slot_count; slot++) {
+      if (runner->instance_pool.motion.active[slot]) {
+        runner->query_results[count++] = (uint32_t)slot;
+      }
+    }
+    *out_count = count;
+    return runner->query_results;
+  }
+
+  dynamic = bs_collision_grid_query(&runner->query_grid, bbox, &dynamic_count);
+  if (runner->static_entry_count > 0) {
+    statics = bs_collision_grid_query(&runner->static_grid, bbox, &static_count);
+  }
+  if (!bs_game_runner_reserve_query_results(runner, dynamic_count + static_count)) {
+    return NULL;
+  }
+  for (size_t i = 0; i < dynamic_count; i++) {
+    runner->query_results[count++] = dynamic[i];
+  }
+  for (size_t s = 0; s < static_count; s++) {
+    const bs_instance *inst = bs_game_runner_static_instance(runner, statics[s]);
+    if (inst != NULL) {
+      runner->query_results[count++] = bs_instance_slot_index(inst);
+    }
+  }
+  *out_count = count;
+  return runner->query_results;
+}
+
+/* Adds the still-baked instances among statics (static_grid entries under the query box) to the
+ * collision grid's candidates, in snapshot order. Statics were baked in instance-list order, which
+ * is also snapshot order, so their entries come out ascending and a merge suffices; if that ever
+ * fails, NULL asks the caller to test every snapshot entry. */
+static const uint32_t *bs_game_runner_merge_static_candidates(const bs_game_runner *runner,
+                                                              const uint32_t *statics,
+                                                              size_t static_count,
+                                                              const uint32_t *candidates,
+                                                              size_t *inout_count,
+                                                              uint32_t *out) {
+  const size_t candidate_count = *inout_count;
+  size_t c = 0;
+  size_t n = 0;
+  uint32_t previous = 0;
+  bool merged_any = false;
+
+  for (size_t s = 0; s < static_count; s++) {
+    const bs_instance *inst = bs_game_runner_static_instance(runner, statics[s]);
+    uint32_t entry = BS_INSTANCE_SLOT_NONE;
+    uint32_t slot = 0;
+    if (inst == NULL) {
+      continue;
+    }
+    slot = bs_instance_slot_index(inst);
+    if ((size_t)slot < runner->collision_entry_of_slot_capacity) {
+      entry = runner->collision_entry_of_slot[slot];
+    }
+    if (entry == BS_INSTANCE_SLOT_NONE) {
+      continue;
+    }
+    if (merged_any && entry < previous) {
+      return NULL;
+    }
+    while (c < candidate_count && candidates[c] < entry) {
+      out[n++] = candidates[c++];
+    }
+    out[n++] = entry;
+    previous = entry;
+    merged_any = true;
+  }
+  while (c < candidate_count) {
+    out[n++] = candidates[c++];
+  }
+  *inout_count = n;
+  return out;
+}
+
+/* Places snapshot entry i in the grid under its current box, or removes it if it has none. */
+static bool bs_game_runner_place_collision_entry(bs_game_runner *runner,
+                                                 const bs_instance_handle *snapshot,
+                                                 size_t i) {
+  const bs_instance *other = bs_instance_pool_resolve(&runner->instance_pool, snapshot[i]);
+  bs_bbox bbox = {0};
+
+  if (other == NULL ||
+      other->destroyed ||
+      bs_game_runner_instance_baked(other) ||
+      !bs_game_runner_compute_instance_bbox(runner, other, &bbox)) {
+    return bs_collision_grid_place(&runner->collision_grid, (uint32_t)i, NULL);
+  }
+  return bs_collision_grid_place(&runner->collision_grid, (uint32_t)i, &bbox);
+}
+
+static bool bs_game_runner_build_collision_grid(bs_game_runner *runner,
+                                                const bs_instance_handle *snapshot,
+                                                size_t snapshot_count) {
+  const double room_w = (runner->current_room != NULL) ? (double)runner->current_room->width : 0.0;
+  const double room_h = (runner->current_room != NULL) ? (double)runner->current_room->height : 0.0;
+  const size_t slot_count = runner->instance_pool.slot_count;
+
+  if (slot_count > runner->collision_entry_of_slot_capacity) {
+    uint32_t *grown = (uint32_t *)realloc(runner->collision_entry_of_slot, slot_count * sizeof(uint32_t));
+    if (grown == NULL) {
+      return false;
+    }
+    runner->collision_entry_of_slot = grown;
+    runner->collision_entry_of_slot_capacity = slot_count;
+  }
+  for (size_t slot = 0; slot < runner->collision_entry_of_slot_capacity; slot++) {
+    runner->collision_entry_of_slot[slot] = BS_INSTANCE_SLOT_NONE;
+  }
+  for (size_t i = 0; i < snapshot_count; i++) {
+    runner->collision_entry_of_slot[snapshot[i].slot] = (uint32_t)i;
+  }
+
+  if (!bs_collision_grid_reset(&runner->collision_grid, room_w, room_h, snapshot_count)) {
+    return false;
+  }
+  for (size_t i = 0; i < snapshot_count; i++) {
+    if (!bs_game_runner_place_collision_entry(runner, snapshot, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* The snapshot entry of the first candidate, in snapshot order, that is target_obj or a child of it
+ * and overlaps inst, or BS_INSTANCE_SLOT_NONE. candidates NULL means every snapshot entry. Only
+ * reads, so the narrowphase threads share it with the serial path. */
+static uint32_t bs_game_runner_first_collision(const bs_game_runner *runner,
+                                               const bs_instance *inst,
+                                               int32_t target_obj,
+                                               const bs_instance_handle *snapshot,
+                                               const uint32_t *candidates,
+                                               size_t candidate_count) {
+  for (size_t c = 0; c < candidate_count; c++) {
+    const uint32_t j = (candidates != NULL) ? candidates[c] : (uint32_t)c;
+    const bs_instance *other = bs_instance_pool_resolve(&runner->instance_pool, snapshot[j]);
+    if (other == NULL || other == inst || other->destroyed) {
+      continue;
+    }
+    if (!bs_game_runner_object_is_child_of(runner, other->object_index, target_obj)) {
+      continue;
+    }
+    if (bs_game_runner_instances_overlap(runner, inst, other)) {
+      return j;
+    }
+  }
+  return BS_INSTANCE_SLOT_NONE;
+}
+
+/* What one narrowphase thread reads. Every snapshot entry's object has a built dispatch table. */
+typedef struct bs_collision_job {
+  const bs_game_runner *runner;
+  bs_collision_worker *worker;
+  const bs_instance_handle *snapshot;
+  size_t snapshot_count;
+} bs_collision_job;
+
+static bool bs_collision_worker_push(bs_collision_worker *worker, uint32_t self, uint32_t other, int32_t target) {
+  if (worker->hit_count == worker->hit_capacity) {
+    size_t capacity = (worker->hit_capacity == 0) ? 256u : (worker->hit_capacity * 2u);
+    bs_collision_hit *grown = (bs_collision_hit *)realloc(worker->hits, capacity * sizeof(bs_collision_hit));
+    if (grown == NULL) {
+      return false;
+    }
+    worker->hits = grown;
+    worker->hit_capacity = capacity;
+  }
+  worker->hits[worker->hit_count].self = self;
+  worker->hits[worker->hit_count].other = other;
+  worker->hits[worker->hit_count].target = target;
+  worker->hit_count++;
+  return true;
+}
+
+/* Finds, for each entry in the worker's range and each of its targets, the instance the serial
+ * pass would pick if nothing moved in between. Writes only to the worker: every box was refreshed
+ * and every object and sprite it touches was loaded before the threads started. A box is READY
+ * only once its sprite was returned and NONE only once the lookup failed, so the lazy
+ * bs_game_data_sprite calls made here never parse anything. */
+static void bs_game_runner_run_collision_job(const bs_collision_job *job) {
+  const bs_game_runner *runner = job->runner;
+  bs_collision_worker *worker = job->worker;
+  worker->hit_count = 0;
+  worker->ok = true;
+
+  if (runner->static_entry_count > 0 && worker->merged_capacity < job->snapshot_count) {
+    uint32_t *grown = (uint32_t *)realloc(worker->merged, job->snapshot_count * sizeof(uint32_t));
+    if (grown == NULL) {
+      worker->ok = false;
+      return;
+    }
+    worker->merged = grown;
+    worker->merged_capacity = job->snapshot_count;
+  }
+
+  for (size_t i = worker->begin; i < worker->end; i++) {
+    const bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, job->snapshot[i]);
+    const bs_object_dispatch *dispatch = NULL;
+    const uint32_t *candidates = NULL;
+    size_t candidate_count = 0;
+    bs_bbox bbox = {0};
+    if (inst == NULL || inst->destroyed) {
+      continue;
+    }
+    dispatch = &runner->object_dispatch[(size_t)inst->object_index];
+    if (dispatch->collision_target_count == 0 || !bs_game_runner_read_instance_bbox(runner, inst, &bbox)) {
+      continue;
+    }
+
+    candidates = bs_collision_grid_read(&runner->collision_grid, &worker->grid_reader, &bbox, &candidate_count);
+    if (candidates == NULL) {
+      worker->ok = false;
+      return;
+    }
+    if (runner->static_entry_count > 0) {
+      size_t static_count = 0;
+      const uint32_t *statics = bs_collision_grid_read(&runner->static_grid, &worker->static_reader, &bbox, &static_count);
+      if (statics == NULL) {
+        worker->ok = false;
+        return;
+      }
+      candidates = bs_game_runner_merge_static_candidates(runner,
+                                                          statics,
+                                                          static_count,
+                                                          candidates,
+                                                          &candidate_count,
+                                                          worker->merged);
+      if (candidates == NULL) {
+        candidate_count = job->snapshot_count;
+      }
+    }
+
+    for (size_t t = 0; t < dispatch->collision_target_count; t++) {
+      const int32_t target = dispatch->collision_targets[t];
+      const uint32_t other = bs_game_runner_first_collision(runner, inst, target, job->snapshot, candidates, candidate_count);
+      if (other != BS_INSTANCE_SLOT_NONE && !bs_collision_worker_push(worker, (uint32_t)i, other, target)) {
+        worker->ok = false;
+        return;
       }
     }
   }
 }
 
+#if defined(BS_HAVE_PTHREADS)
+typedef struct bs_collision_pool_thread {
+  struct bs_collision_pool *pool;
+  size_t index;
+} bs_collision_pool_thread;
+
+/* Narrowphase threads kept for the runner's lifetime, so a step pays a wake-up rather than a
+ * thread start. Thread i (from 1) runs jobs[i] of each generation; the caller runs jobs[0]. */
+struct bs_collision_pool {
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  pthread_t threads[BS_COLLISION_MAX_THREADS];
+  bs_collision_pool_thread args[BS_COLLISION_MAX_THREADS];
+  size_t thread_count;
+  const bs_collision_job *jobs;
+  size_t job_count;
+  uint64_t generation;
+  size_t pending;
+  bool stopping;
+};
+
+static void *bs_game_runner_collision_thread(void *arg) {
+  const bs_collision_pool_thread *self = (const bs_collision_pool_thread *)arg;
+  struct bs_collision_pool *pool = self->pool;
+  uint64_t seen = 0;
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    const bs_collision_job *job = NULL;
+    while (!pool->stopping && pool->generation == seen) {
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+    if (pool->stopping) {
+      break;
+    }
+    seen = pool->generation;
+    if (self->index < pool->job_count) {
+      job = &pool->jobs[self->index];
+    }
+    pthread_mutex_unlock(&pool->lock);
+    if (job != NULL) {
+      bs_game_runner_run_collision_job(job);
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->pending--;
+    if (pool->pending == 0) {
+      pthread_cond_signal(&pool->done);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+static void bs_game_runner_stop_collision_pool(bs_game_runner *runner) {
+  struct bs_collision_pool *pool = runner->collision_pool;
+  if (pool == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&pool->lock);
+  pool->stopping = true;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  for (size_t t = 1; t <= pool->thread_count; t++) {
+    pthread_join(pool->threads[t], NULL);
+  }
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool);
+  runner->collision_pool = NULL;
+}
+
+/* Starts collision_thread_count - 1 threads on first use. Threads that fail to start leave their
+ * jobs to the caller; if none start the pool is not kept and the next step tries again. */
+static struct bs_collision_pool *bs_game_runner_collision_pool(bs_game_runner *runner) {
+  struct bs_collision_pool *pool = runner->collision_pool;
+  if (pool != NULL) {
+    return pool;
+  }
+  pool = (struct bs_collision_pool *)calloc(1, sizeof(*pool));
+  if (pool == NULL) {
+    return NULL;
+  }
+  if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+    free(pool);
+    return NULL;
+  }
+  if (pthread_cond_init(&pool->wake, NULL) != 0) {
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    return NULL;
+  }
+  if (pthread_cond_init(&pool->done, NULL) != 0) {
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    return NULL;
+  }
+  runner->collision_pool = pool;
+  for (size_t t = 1; t < runner->collision_thread_count; t++) {
+    pool->args[t].pool = pool;
+    pool->args[t].index = t;
+    if (pthread_create(&pool->threads[t], NULL, bs_game_runner_collision_thread, &pool->args[t]) != 0) {
+      break;
+    }
+    pool->thread_count = t;
+  }
+  if (pool->thread_count == 0) {
+    bs_game_runner_stop_collision_pool(runner);
+    return NULL;
+  }
+  return pool;
+}
+#endif
+
+/* Runs the jobs, the calling thread taking the first one and any the pool has no thread for. */
+static void bs_game_runner_run_collision_jobs(bs_game_runner *runner, const bs_collision_job *jobs, size_t job_count) {
+#if defined(BS_HAVE_PTHREADS)
+  struct bs_collision_pool *pool = bs_game_runner_collision_pool(runner);
+  size_t pooled = 0;
+  if (pool != NULL) {
+    pthread_mutex_lock(&pool->lock);
+    pool->jobs = jobs;
+    pool->job_count = job_count;
+    pool->pending = pool->thread_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    pooled = pool->thread_count;
+  }
+  for (size_t t = 0; t < job_count; t++) {
+    if (t == 0 || t > pooled) {
+      bs_game_runner_run_collision_job(&jobs[t]);
+    }
+  }
+  if (pool != NULL) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+      pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pool->jobs = NULL;
+    pool->job_count = 0;
+    pthread_mutex_unlock(&pool->lock);
+  }
+#else
+  (void)runner;
+  for (size_t t = 0; t < job_count; t++) {
+    bs_game_runner_run_collision_job(&jobs[t]);
+  }
+#endif
+}
+
+/* Threads worth starting for a snapshot this size; 1 keeps the whole pass on the calling thread. */
+static size_t bs_game_runner_narrowphase_threads(const bs_game_runner *runner, size_t snapshot_count) {
+  size_t count = snapshot_count / BS_COLLISION_ENTRIES_PER_THREAD;
+  if (count > runner->collision_thread_count) {
+    count = runner->collision_thread_count;
+  }
+  return (count < 2u) ? 1u : count;
+}
+
+/* Position in the workers' hit lists, which read in snapshot order when taken worker by worker. */
+typedef struct bs_collision_cursor {
+  size_t worker;
+  size_t index;
+} bs_collision_cursor;
+
+/* Looks up the narrowphase result for (self, target), moving the cursor past it. Returns false if
+ * self's worker did not finish, in which case nothing is known. */
+static bool bs_game_runner_take_collision_hit(const bs_game_runner *runner,
+                                              size_t worker_count,
+                                              bs_collision_cursor *cursor,
+                                              uint32_t self,
+                                              int32_t target,
+                                              uint32_t *out_other) {
+  const bs_collision_worker *worker = NULL;
+  *out_other = BS_INSTANCE_SLOT_NONE;
+  while (cursor->worker < worker_count && (size_t)self >= runner->collision_workers[cursor->worker].end) {
+    cursor->worker++;
+    cursor->index = 0;
+  }
+  if (cursor->worker >= worker_count) {
+    return false;
+  }
+  worker = &runner->collision_workers[cursor->worker];
+  if (!worker->ok) {
+    return false;
+  }
+  while (cursor->index < worker->hit_count && worker->hits[cursor->index].self < self) {
+    cursor->index++;
+  }
+  if (cursor->index < worker->hit_count &&
+      worker->hits[cursor->index].self == self &&
+      worker->hits[cursor->index].target == target) {
+    *out_other = worker->hits[cursor->index].other;
+    cursor->index++;
+  }
+  return true;
+}
+
+/* Collision events fire in the same order as a full scan: for each instance and each target
+ * object, the first snapshot instance (in creation order) that overlaps it. The grid only narrows
+ * which snapshot entries are tested. It is built on first use; instances that event code moves
+ * are reported through bs_game_runner_note_bbox_change and re-binned before the next query.
+ * Baked static instances are found through static_grid instead. One instance's targets share a
+ * query while nothing has moved since. If the grid cannot be allocated every entry is tested, as
+ * before.
+ *
+ * Large snapshots first run the side-effect-free narrowphase on several threads over contiguous
+ * ranges, then fire on this thread in snapshot order. A precomputed result is used only while no
+ * grid entry has been re-placed in a cell under the instance's box since the threads ran, and a
+ * hit only while its other instance still exists and overlaps; otherwise that target is searched
+ * again here. Events therefore see exactly what the serial pass would show them. */
 static void bs_game_runner_dispatch_collision_events(bs_game_runner *runner) {
-  int32_t *snapshot_ids = NULL;
+  bs_instance_handle *snapshot = NULL;
+  uint32_t *merged = NULL;
   size_t snapshot_count = 0;
+  size_t worker_count = 0;
+  bs_collision_cursor cursor = {0, 0};
+  bool grid_built = false;
+  bool grid_usable = true;
   if (runner == NULL) {
     return;
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    if (!runner->instances[i].destroyed) {
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    if (!inst->destroyed) {
       snapshot_count++;
     }
   }
@@ -1503,24 +3180,76 @@ static void bs_game_runner_dispatch_collision_events(bs_game_runner *runner) {
     return;
   }
 
-  snapshot_ids = (int32_t *)malloc(snapshot_count * sizeof(int32_t));
-  if (snapshot_ids == NULL) {
+  bs_game_runner_refresh_bboxes(runner);
+  snapshot = (bs_instance_handle *)malloc(snapshot_count * sizeof(bs_instance_handle));
+  if (snapshot == NULL) {
     return;
   }
+  if (runner->static_entry_count > 0) {
+    merged = (uint32_t *)malloc(snapshot_count * sizeof(uint32_t));
+    grid_usable = (merged != NULL);
+  }
   {
     size_t at = 0;
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      if (!runner->instances[i].destroyed) {
-        snapshot_ids[at] = runner->instances[i].id;
+    for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+         inst = bs_game_runner_next_instance(runner, inst)) {
+      if (!inst->destroyed) {
+        snapshot[at] = bs_instance_pool_handle(inst);
         at++;
       }
     }
   }
 
+  worker_count = grid_usable ? bs_game_runner_narrowphase_threads(runner, snapshot_count) : 1u;
+  if (worker_count > 1u) {
+    /* Builds every dispatch table the threads will read. */
+    bool tables_ready = true;
+    size_t total = 0;
+    for (size_t i = 0; i < snapshot_count && tables_ready; i++) {
+      const bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, snapshot[i]);
+      const int32_t *targets = NULL;
+      size_t count = 0;
+      tables_ready = bs_game_runner_collision_targets(runner, inst->object_index, &targets, &count);
+      total += count;
+    }
+    if (!tables_ready) {
+      total = 0;
+    }
+    if (total > 0) {
+      grid_built = true;
+      grid_usable = bs_game_runner_build_collision_grid(runner, snapshot, snapshot_count);
+      runner->collision_tracking = grid_usable;
+    }
+    if (total > 0 && grid_usable) {
+      bs_collision_job jobs[BS_COLLISION_MAX_THREADS];
+      for (size_t w = 0; w < worker_count; w++) {
+        bs_collision_worker *worker = &runner->collision_workers[w];
+        worker->begin = (snapshot_count * w) / worker_count;
+        worker->end = (snapshot_count * (w + 1u)) / worker_count;
+        jobs[w].runner = runner;
+        jobs[w].worker = worker;
+        jobs[w].snapshot = snapshot;
+        jobs[w].snapshot_count = snapshot_count;
+      }
+      bs_game_runner_run_collision_jobs(runner, jobs, worker_count);
+      bs_collision_grid_track_changes(&runner->collision_grid, true);
+    } else {
+      worker_count = 1u;
+    }
+  }
+  if (worker_count <= 1u) {
+    worker_count = 0;
+  }
+
   for (size_t i = 0; i < snapshot_count; i++) {
-    bs_instance *inst = bs_game_runner_find_instance_by_id(runner, snapshot_ids[i]);
+    bs_instance *inst = bs_instance_pool_resolve(&runner->instance_pool, snapshot[i]);
     bs_bbox inst_bbox = {0};
-    int32_t targets[256];
+    bs_bbox query_bbox = {0};
+    bool have_query = false;
+    const uint32_t *candidates = NULL;
+    size_t candidate_count = snapshot_count;
+    int32_t collected[256];
+    const int32_t *targets = NULL;
     size_t target_count = 0;
     if (inst == NULL || inst->destroyed) {
       continue;
@@ -1529,46 +3258,90 @@ static void bs_game_runner_dispatch_collision_events(bs_game_runner *runner) {
       continue;
     }
 
-    target_count = bs_game_runner_collect_collision_targets(runner,
-                                                            inst->object_index,
-                                                            targets,
-                                                            sizeof(targets) / sizeof(targets[0]));
+    if (!bs_game_runner_collision_targets(runner, inst->object_index, &targets, &target_count)) {
+      target_count = bs_game_runner_collect_collision_targets(runner,
+                                                              inst->object_index,
+                                                              collected,
+                                                              sizeof(collected) / sizeof(collected[0]));
+      targets = collected;
+    }
     for (size_t t = 0; t < target_count; t++) {
       int32_t target_obj = targets[t];
+      uint32_t hit = BS_INSTANCE_SLOT_NONE;
+      bool known = false;
       if (inst->destroyed) {
         break;
       }
 
-      for (size_t j = 0; j < snapshot_count; j++) {
-        bs_instance *other = NULL;
-        if (snapshot_ids[j] == inst->id) {
-          continue;
-        }
-        other = bs_game_runner_find_instance_by_id(runner, snapshot_ids[j]);
-        if (other == NULL || other->destroyed) {
-          continue;
+      if (grid_usable && !grid_built) {
+        grid_built = true;
+        grid_usable = bs_game_runner_build_collision_grid(runner, snapshot, snapshot_count);
+        runner->collision_tracking = grid_usable;
+      } else if (grid_usable) {
+        size_t moved_count = 0;
+        const uint32_t *moved = bs_collision_grid_drain_moved(&runner->collision_grid, &moved_count);
+        for (size_t m = 0; m < moved_count && grid_usable; m++) {
+          grid_usable = bs_game_runner_place_collision_entry(runner, snapshot, moved[m]);
         }
-        if (!bs_game_runner_object_is_child_of(runner, other->object_index, target_obj)) {
-          continue;
+        runner->collision_tracking = grid_usable;
+        have_query = have_query && moved_count == 0;
+      }
+
+      if (worker_count > 0) {
+        known = bs_game_runner_take_collision_hit(runner, worker_count, &cursor, (uint32_t)i, target_obj, &hit) &&
+                grid_usable &&
+                !bs_collision_grid_region_changed(&runner->collision_grid, &inst_bbox);
+        if (known && hit != BS_INSTANCE_SLOT_NONE) {
+          const bs_instance *other = bs_instance_pool_resolve(&runner->instance_pool, snapshot[hit]);
+          known = other != NULL && !other->destroyed && bs_game_runner_instances_overlap(runner, inst, other);
         }
-        if (!bs_game_runner_instances_overlap(runner, inst, other)) {
-          continue;
+      }
+      if (!known) {
+        if (!grid_usable) {
+          candidates = NULL;
+          candidate_count = snapshot_count;
+        } else if (!have_query ||
+                   query_bbox.left != inst_bbox.left ||
+                   query_bbox.right != inst_bbox.right ||
+                   query_bbox.top != inst_bbox.top ||
+                   query_bbox.bottom != inst_bbox.bottom) {
+          candidates = bs_collision_grid_query(&runner->collision_grid, &inst_bbox, &candidate_count);
+          if (merged != NULL) {
+            size_t static_count = 0;
+            const uint32_t *statics = bs_collision_grid_query(&runner->static_grid, &inst_bbox, &static_count);
+            candidates = bs_game_runner_merge_static_candidates(runner,
+                                                                statics,
+                                                                static_count,
+                                                                candidates,
+                                                                &candidate_count,
+                                                                merged);
+            if (candidates == NULL) {
+              candidate_count = snapshot_count;
+            }
+          }
+          query_bbox = inst_bbox;
+          have_query = true;
         }
+        hit = bs_game_runner_first_collision(runner, inst, target_obj, snapshot, candidates, candidate_count);
+      }
 
+      if (hit != BS_INSTANCE_SLOT_NONE) {
+        bs_instance *other = bs_instance_pool_resolve(&runner->instance_pool, snapshot[hit]);
+        bool blocked = false;
         if (other->solid) {
-          inst->x = inst->xprevious;
-          inst->y = inst->yprevious;
-          if (!bs_game_runner_compute_instance_bbox(runner, inst, &inst_bbox)) {
-            break;
-          }
+          BS_MOTION(inst, x) = BS_MOTION(inst, xprevious);
+          BS_MOTION(inst, y) = BS_MOTION(inst, yprevious);
+          bs_game_runner_note_bbox_change(runner, inst);
+          blocked = !bs_game_runner_compute_instance_bbox(runner, inst, &inst_bbox);
         }
-        if (inst->solid) {
-          other->x = other->xprevious;
-          other->y = other->yprevious;
+        if (!blocked) {
+          if (inst->solid) {
+            BS_MOTION(other, x) = BS_MOTION(other, xprevious);
+            BS_MOTION(other, y) = BS_MOTION(other, yprevious);
+            bs_game_runner_note_bbox_change(runner, other);
+          }
+          bs_game_runner_fire_event(runner, inst, BS_EVENT_COLLISION, target_obj, other);
         }
-
-        bs_game_runner_fire_event(runner, inst, BS_EVENT_COLLISION, target_obj, other);
-        break;
       }
 
       if (!bs_game_runner_compute_instance_bbox(runner, inst, &inst_bbox)) {
@@ -1577,36 +3350,92 @@ static void bs_game_runner_dispatch_collision_events(bs_game_runner *runner) {
     }
   }
 
-  free(snapshot_ids);
+  bs_collision_grid_track_changes(&runner->collision_grid, false);
+  runner->collision_tracking = false;
+  free(merged);
+  free(snapshot);
+}
+
+/* Brings the solid sweep list up to date with every live solid instance that is not baked into
+ * static_grid, keyed by pool slot. */
+static bool bs_game_runner_refresh_solid_sweep(bs_game_runner *runner) {
+  bool ok = true;
+  bs_sweep_list_begin_update(&runner->solid_sweep);
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL && ok;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    bs_bbox bbox = {0};
+    if (inst->destroyed ||
+        !inst->solid ||
+        bs_game_runner_instance_baked(inst) ||
+        !bs_game_runner_compute_instance_bbox(runner, inst, &bbox)) {
+      continue;
+    }
+    ok = bs_sweep_list_set(&runner->solid_sweep, bs_instance_slot_index(inst), &bbox);
+  }
+  bs_sweep_list_end_update(&runner->solid_sweep);
+  return ok;
 }
 
+/* An instance that moved into any solid goes back to its previous position. No events run here,
+ * so the only boxes that change mid-pass are the ones reverted below, and those are moved within
+ * the sweep list straight away. Baked solids never moved, so they are looked up in static_grid.
+ * Falls back to testing every instance if the list cannot grow. */
 static void bs_game_runner_resolve_solid_overlaps(bs_game_runner *runner) {
+  bool swept = false;
   if (runner == NULL) {
     return;
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
+  bs_game_runner_refresh_bboxes(runner);
+  swept = bs_game_runner_refresh_solid_sweep(runner);
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     bs_bbox inst_bbox = {0};
+    bool blocked = false;
     if (inst->destroyed) {
       continue;
     }
-    if (inst->x == inst->xprevious && inst->y == inst->yprevious) {
+    if (BS_MOTION(inst, x) == BS_MOTION(inst, xprevious) && BS_MOTION(inst, y) == BS_MOTION(inst, yprevious)) {
       continue;
     }
     if (!bs_game_runner_compute_instance_bbox(runner, inst, &inst_bbox)) {
       continue;
     }
 
-    for (size_t j = 0; j < runner->instance_count; j++) {
-      bs_instance *other = &runner->instances[j];
-      if (other->destroyed || other == inst || !other->solid) {
-        continue;
+    if (swept) {
+      size_t cursor = bs_sweep_list_first_candidate(&runner->solid_sweep, &inst_bbox);
+      uint32_t slot = 0;
+      while (!blocked &&
+             bs_sweep_list_next_overlap(&runner->solid_sweep, &inst_bbox, bs_instance_slot_index(inst), &cursor, &slot)) {
+        blocked = bs_game_runner_instances_overlap(runner, inst, bs_instance_pool_at(&runner->instance_pool, slot));
       }
-      if (bs_game_runner_instances_overlap(runner, inst, other)) {
-        inst->x = inst->xprevious;
-        inst->y = inst->yprevious;
-        break;
+      if (!blocked && runner->static_entry_count > 0) {
+        size_t static_count = 0;
+        const uint32_t *statics = bs_collision_grid_query(&runner->static_grid, &inst_bbox, &static_count);
+        for (size_t s = 0; s < static_count && !blocked; s++) {
+          const bs_instance *other = bs_game_runner_static_instance(runner, statics[s]);
+          if (other != NULL && other != inst && other->solid) {
+            blocked = bs_game_runner_instances_overlap(runner, inst, other);
+          }
+        }
+      }
+    } else {
+      for (const bs_instance *other = bs_game_runner_first_instance(runner); other != NULL && !blocked;
+           other = bs_game_runner_next_instance(runner, other)) {
+        if (other->destroyed || other == inst || !other->solid) {
+          continue;
+        }
+        blocked = bs_game_runner_instances_overlap(runner, inst, other);
+      }
+    }
+
+    if (blocked) {
+      BS_MOTION(inst, x) = BS_MOTION(inst, xprevious);
+      BS_MOTION(inst, y) = BS_MOTION(inst, yprevious);
+      bs_game_runner_note_bbox_change(runner, inst);
+      if (swept && inst->solid) {
+        const bool has_bbox = bs_game_runner_compute_instance_bbox(runner, inst, &inst_bbox);
+        bs_sweep_list_move(&runner->solid_sweep, bs_instance_slot_index(inst), has_bbox ? &inst_bbox : NULL);
       }
     }
   }
@@ -1621,8 +3450,9 @@ static void bs_game_runner_check_outside_room_events(bs_game_runner *runner) {
 
   room_w = (double)runner->current_room->width;
   room_h = (double)runner->current_room->height;
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
+  bs_game_runner_refresh_bboxes(runner);
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     bs_bbox bbox = {0};
     bool outside = false;
     if (inst->destroyed) {
@@ -1632,7 +3462,9 @@ static void bs_game_runner_check_outside_room_events(bs_game_runner *runner) {
     if (bs_game_runner_compute_instance_bbox(runner, inst, &bbox)) {
       outside = (bbox.right < 0.0 || bbox.left > room_w || bbox.bottom < 0.0 || bbox.top > room_h);
     } else {
-      outside = (inst->x < 0.0 || inst->x > room_w || inst->y < 0.0 || inst->y > room_h);
+      const double x = BS_MOTION(inst, x);
+      const double y = BS_MOTION(inst, y);
+      outside = (x < 0.0 || x > room_w || y < 0.0 || y > room_h);
     }
 
     if (outside) {
@@ -1647,44 +3479,27 @@ static void bs_game_runner_check_outside_room_events(bs_game_runner *runner) {
 }
 
 static void bs_game_runner_dispatch_draw_events_for_instance(bs_game_runner *runner, bs_instance *instance) {
-  int32_t seen_subtypes[64];
-  size_t seen_count = 0;
-  int32_t current_object = 0;
-  int depth = 0;
+  const bs_object_dispatch *dispatch = NULL;
   bool has_any_draw_event = false;
   if (runner == NULL || instance == NULL || instance->destroyed || runner->game_data == NULL) {
     return;
   }
 
-  current_object = instance->object_index;
-  while (depth < 64) {
-    const bs_game_object_data *obj = NULL;
-    const bs_object_event_list *draw_list = NULL;
-    if (current_object < 0 || (size_t)current_object >= runner->game_data->object_count) {
-      break;
-    }
-    obj = &runner->game_data->objects[(size_t)current_object];
-    if ((size_t)BS_EVENT_DRAW < obj->event_type_count) {
-      draw_list = &obj->events[(size_t)BS_EVENT_DRAW];
-      if (draw_list->entry_count > 0) {
-        has_any_draw_event = true;
-      }
-      for (size_t i = 0; i < draw_list->entry_count; i++) {
-        int32_t subtype = draw_list->entries[i].subtype;
-        if (!bs_game_runner_contains_subtype(seen_subtypes, seen_count, subtype)) {
-          bs_game_runner_fire_event(runner, instance, BS_EVENT_DRAW, subtype, NULL);
-          if (seen_count < (sizeof(seen_subtypes) / sizeof(seen_subtypes[0]))) {
-            seen_subtypes[seen_count] = subtype;
-            seen_count++;
-          }
-        }
-      }
-    }
-    current_object = obj->parent_id;
-    if (current_object < 0) {
-      break;
+  /* The DRAW row already lists each subtype once, in chain order, with its resolved handler. */
+  dispatch = bs_game_runner_object_dispatch(runner, instance->object_index, 0);
+  if (dispatch != NULL) {
+    const bs_event_dispatch_row *draw_row = &dispatch->rows[BS_EVENT_DRAW];
+    has_any_draw_event = draw_row->slot_count > 0;
+    for (size_t i = 0; i < draw_row->slot_count && runner->vm != NULL; i++) {
+      const bs_event_dispatch_slot *slot = &draw_row->slots[i];
+      bs_game_runner_execute_event_entry(runner,
+                                         instance,
+                                         BS_EVENT_DRAW,
+                                         slot->subtype,
+                                         slot->owner_object_index,
+                                         slot->entry,
+                                         instance->id);
     }
-    depth++;
   }
 
   if (!has_any_draw_event &&
@@ -1695,15 +3510,15 @@ static void bs_game_runner_dispatch_draw_events_for_instance(bs_game_runner *run
     if (instance->image_single >= 0.0) {
       draw_frame = (int32_t)instance->image_single;
     } else {
-      draw_frame = (int32_t)floor(instance->image_index);
+      draw_frame = (int32_t)floor(BS_MOTION(instance, image_index));
     }
     if (runner->render.draw_sprite_ext != NULL) {
       runner->render.draw_sprite_ext(runner->render.userdata,
                                      runner,
                                      instance->sprite_index,
                                      draw_frame,
-                                     instance->x,
-                                     instance->y,
+                                     BS_MOTION(instance, x),
+                                     BS_MOTION(instance, y),
                                      instance->image_xscale,
                                      instance->image_yscale,
                                      instance->image_angle,
@@ -1714,8 +3529,8 @@ static void bs_game_runner_dispatch_draw_events_for_instance(bs_game_runner *run
                                  runner,
                                  instance->sprite_index,
                                  draw_frame,
-                                 instance->x,
-                                 instance->y,
+                                 BS_MOTION(instance, x),
+                                 BS_MOTION(instance, y),
                                  instance->image_blend,
                                  instance->image_alpha);
     }
@@ -1770,7 +3585,217 @@ static void bs_game_runner_draw_room_backgrounds(bs_game_runner *runner, bool fo
   }
 }
 
-static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
+/* A room tile paired with its index, for grouping tiles into layers. */
+typedef struct bs_tile_order {
+  int32_t depth;
+  uint32_t index;
+} bs_tile_order;
+
+static int bs_tile_order_compare(const void *lhs, const void *rhs) {
+  const bs_tile_order *a = (const bs_tile_order *)lhs;
+  const bs_tile_order *b = (const bs_tile_order *)rhs;
+  if (a->depth != b->depth) {
+    return (a->depth > b->depth) ? -1 : 1;
+  }
+  return (a->index > b->index) - (a->index < b->index);
+}
+
+/* The area a tile covers once scaled; a negative scale flips it back across x or y, as the
+ * frontend draws it. */
+static bs_bbox bs_game_runner_tile_bbox(const bs_room_tile_data *tile) {
+  const double width = (double)tile->width * (double)tile->scale_x;
+  const double height = (double)tile->height * (double)tile->scale_y;
+  bs_bbox bbox;
+  bbox.left = (width < 0.0) ? (double)tile->x + width : (double)tile->x;
+  bbox.right = (width < 0.0) ? (double)tile->x : (double)tile->x + width;
+  bbox.top = (height < 0.0) ? (double)tile->y + height : (double)tile->y;
+  bbox.bottom = (height < 0.0) ? (double)tile->y : (double)tile->y + height;
+  return bbox;
+}
+
+/* The world rectangle of the first enabled view, the one the frontend draws through, padded by a
+ * pixel for the rounding of tile positions. False when no view is enabled; tiles are then not
+ * culled. */
+static bool bs_game_runner_tile_view(const bs_game_runner *runner, bs_bbox *out_view) {
+  const bs_room_data *room = runner->current_room;
+  if (room == NULL || room->views == NULL) {
+    return false;
+  }
+  for (size_t i = 0; i < room->view_count; i++) {
+    const bs_room_view_data *view = &room->views[i];
+    if (view->enabled && view->view_w > 0 && view->view_h > 0) {
+      out_view->left = (double)view->view_x - 1.0;
+      out_view->top = (double)view->view_y - 1.0;
+      out_view->right = (double)view->view_x + (double)view->view_w + 1.0;
+      out_view->bottom = (double)view->view_y + (double)view->view_h + 1.0;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool bs_game_runner_draw_tile(bs_game_runner *runner, const bs_room_tile_data *tile) {
+  int32_t tpag_index = bs_game_runner_background_tpag_index(runner, tile->bg_def_index);
+  if (tpag_index < 0) {
+    return false;
+  }
+  runner->render.draw_tile(runner->render.userdata,
+                           runner,
+                           tpag_index,
+                           tile->x,
+                           tile->y,
+                           tile->source_x,
+                           tile->source_y,
+                           tile->width,
+                           tile->height,
+                           tile->scale_x,
+                           tile->scale_y,
+                           (int32_t)tile->color);
+  return true;
+}
+
+/* Draws the room tile if it reaches into view (NULL draws it regardless) and counts it. */
+static void bs_game_runner_visit_tile(bs_game_runner *runner, uint32_t tile_index, const bs_bbox *view) {
+  const bs_room_tile_data *tile = &runner->current_room->tiles[tile_index];
+  runner->tile_stats.tiles_visited++;
+  if (view != NULL) {
+    const bs_bbox bbox = bs_game_runner_tile_bbox(tile);
+    if (!(bbox.left <= view->right && bbox.right >= view->left && bbox.top <= view->bottom &&
+          bbox.bottom >= view->top)) {
+      return;
+    }
+  }
+  if (bs_game_runner_draw_tile(runner, tile)) {
+    runner->tile_stats.tiles_drawn++;
+  }
+}
+
+/* Draws one layer's tiles in room order, visiting only the grid cells the view touches. The view is
+ * read per layer, so a Draw event that moves it affects the layers drawn after it. */
+static void bs_game_runner_draw_tile_layer(bs_game_runner *runner, bs_tile_layer *layer) {
+  bs_bbox view_bbox;
+  const bs_bbox *view = NULL;
+  const uint32_t *positions = NULL;
+  size_t position_count = 0;
+  if (bs_game_runner_tile_view(runner, &view_bbox)) {
+    view = &view_bbox;
+  }
+  runner->tile_stats.layers_drawn++;
+  if (view == NULL || !layer->grid_ready) {
+    for (size_t i = 0; i < layer->tile_count; i++) {
+      bs_game_runner_visit_tile(runner, layer->tiles[i], view);
+    }
+    return;
+  }
+  positions = bs_collision_grid_query(&layer->grid, view, &position_count);
+  for (size_t i = 0; i < position_count; i++) {
+    bs_game_runner_visit_tile(runner, layer->tiles[positions[i]], view);
+  }
+}
+
+/* Moves the instance to its current depth in the draw list; called on creation and whenever depth
+ * is assigned. */
+static void bs_game_runner_note_depth(bs_game_runner *runner, const bs_instance *instance) {
+  if (!runner->draw_list_ready) {
+    return;
+  }
+  runner->draw_list_ready = bs_draw_list_set(&runner->draw_list,
+                                             BS_DRAW_ITEM_INSTANCE,
+                                             bs_instance_slot_index(instance),
+                                             instance->depth,
+                                             bs_instance_sequence(instance));
+}
+
+/* Groups the current room's tiles into one layer per depth, deepest first, and files each layer's
+ * tiles in a grid over the room. A layer whose grid cannot be built is drawn by testing every
+ * tile. */
+static bool bs_game_runner_build_tile_layers(bs_game_runner *runner) {
+  const bs_room_data *room = runner->current_room;
+  bs_tile_order *order = NULL;
+  size_t layer_count = 0;
+  runner->tile_layer_count = 0;
+  if (room == NULL || room->tile_count == 0) {
+    return true;
+  }
+  if (room->tile_count > UINT32_MAX) {
+    return false;
+  }
+
+  if (room->tile_count > runner->tile_layer_index_capacity) {
+    uint32_t *grown = (uint32_t *)realloc(runner->tile_layer_indices, room->tile_count * sizeof(uint32_t));
+    if (grown == NULL) {
+      return false;
+    }
+    runner->tile_layer_indices = grown;
+    runner->tile_layer_index_capacity = room->tile_count;
+  }
+  order = (bs_tile_order *)malloc(room->tile_count * sizeof(bs_tile_order));
+  if (order == NULL) {
+    return false;
+  }
+  for (size_t i = 0; i < room->tile_count; i++) {
+    order[i].depth = room->tiles[i].depth;
+    order[i].index = (uint32_t)i;
+  }
+  qsort(order, room->tile_count, sizeof(bs_tile_order), bs_tile_order_compare);
+  for (size_t i = 0; i < room->tile_count; i++) {
+    runner->tile_layer_indices[i] = order[i].index;
+    if (i == 0 || order[i].depth != order[i - 1u].depth) {
+      layer_count++;
+    }
+  }
+
+  if (layer_count > runner->tile_layer_capacity) {
+    bs_tile_layer *grown = (bs_tile_layer *)realloc(runner->tile_layers, layer_count * sizeof(bs_tile_layer));
+    if (grown == NULL) {
+      free(order);
+      return false;
+    }
+    for (size_t i = runner->tile_layer_capacity; i < layer_count; i++) {
+      bs_collision_grid_init(&grown[i].grid);
+    }
+    runner->tile_layers = grown;
+    runner->tile_layer_capacity = layer_count;
+  }
+
+  for (size_t start = 0; start < room->tile_count;) {
+    bs_tile_layer *layer = &runner->tile_layers[runner->tile_layer_count++];
+    size_t end = start + 1u;
+    while (end < room->tile_count && order[end].depth == order[start].depth) {
+      end++;
+    }
+    layer->depth = order[start].depth;
+    layer->tiles = &runner->tile_layer_indices[start];
+    layer->tile_count = end - start;
+    layer->grid_ready =
+        bs_collision_grid_reset(&layer->grid, (double)room->width, (double)room->height, layer->tile_count);
+    for (size_t i = 0; i < layer->tile_count && layer->grid_ready; i++) {
+      const bs_bbox bbox = bs_game_runner_tile_bbox(&room->tiles[layer->tiles[i]]);
+      layer->grid_ready = bs_collision_grid_place(&layer->grid, (uint32_t)i, &bbox);
+    }
+    start = end;
+  }
+  free(order);
+  return true;
+}
+
+/* Rebuilds the tile layers for the current room and swaps them into the draw list. */
+static void bs_game_runner_track_room_tiles(bs_game_runner *runner) {
+  bs_draw_list_remove_kind(&runner->draw_list, BS_DRAW_ITEM_TILE);
+  runner->tile_layers_ready = bs_game_runner_build_tile_layers(runner);
+  if (!runner->tile_layers_ready) {
+    runner->draw_list_ready = false;
+    return;
+  }
+  for (size_t i = 0; i < runner->tile_layer_count && runner->draw_list_ready; i++) {
+    runner->draw_list_ready =
+        bs_draw_list_set(&runner->draw_list, BS_DRAW_ITEM_TILE, (uint32_t)i, runner->tile_layers[i].depth, 0);
+  }
+}
+
+/* Fallback when the draw list could not grow: collects the depths in use and scans every tile and
+ * instance once per depth. */
+static void bs_game_runner_dispatch_draw_events_scan(bs_game_runner *runner) {
   const bs_room_data *room = NULL;
   int32_t *depths = NULL;
   size_t depth_count = 0;
@@ -1780,7 +3805,7 @@ static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
   }
   room = runner->current_room;
 
-  depth_capacity = runner->instance_count + (room != NULL ? room->tile_count : 0);
+  depth_capacity = runner->instance_pool.count + (room != NULL ? room->tile_count : 0);
   if (depth_capacity > 0) {
     depths = (int32_t *)malloc(depth_capacity * sizeof(int32_t));
     if (depths == NULL) {
@@ -1788,10 +3813,10 @@ static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
     }
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    if (!runner->instances[i].destroyed &&
-        !bs_game_runner_depth_seen(depths, depth_count, runner->instances[i].depth)) {
-      depths[depth_count++] = runner->instances[i].depth;
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    if (!inst->destroyed && !bs_game_runner_depth_seen(depths, depth_count, inst->depth)) {
+      depths[depth_count++] = inst->depth;
     }
   }
   if (room != NULL) {
@@ -1815,35 +3840,24 @@ static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
 
   for (size_t d = 0; d < depth_count; d++) {
     int32_t depth = depths[d];
-    if (room != NULL && runner->render.draw_tile != NULL) {
-      for (size_t i = 0; i < room->tile_count; i++) {
-        const bs_room_tile_data *tile = &room->tiles[i];
-        int32_t tpag_index = -1;
-        if (tile->depth != depth) {
-          continue;
+    if (room != NULL && runner->render.draw_tile != NULL && runner->tile_layers_ready) {
+      for (size_t i = 0; i < runner->tile_layer_count; i++) {
+        if (runner->tile_layers[i].depth == depth) {
+          bs_game_runner_draw_tile_layer(runner, &runner->tile_layers[i]);
         }
-        tpag_index = bs_game_runner_background_tpag_index(runner, tile->bg_def_index);
-        if (tpag_index < 0) {
-          continue;
+      }
+    } else if (room != NULL && runner->render.draw_tile != NULL) {
+      for (size_t i = 0; i < room->tile_count; i++) {
+        if (room->tiles[i].depth == depth) {
+          bs_game_runner_visit_tile(runner, (uint32_t)i, NULL);
         }
-        runner->render.draw_tile(runner->render.userdata,
-                                 runner,
-                                 tpag_index,
-                                 tile->x,
-                                 tile->y,
-                                 tile->source_x,
-                                 tile->source_y,
-                                 tile->width,
-                                 tile->height,
-                                 tile->scale_x,
-                                 tile->scale_y,
-                                 (int32_t)tile->color);
       }
     }
 
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      if (!runner->instances[i].destroyed && runner->instances[i].depth == depth) {
-        bs_game_runner_dispatch_draw_events_for_instance(runner, &runner->instances[i]);
+    for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+         inst = bs_game_runner_next_instance(runner, inst)) {
+      if (!inst->destroyed && inst->depth == depth) {
+        bs_game_runner_dispatch_draw_events_for_instance(runner, inst);
       }
     }
   }
@@ -1851,14 +3865,58 @@ static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
   free(depths);
 }
 
+/* Draws tiles and instances in the order the draw list keeps: depth descending, tiles first within
+ * a depth, then instances in creation order. The walk covers the order as it was sorted at the
+ * start of the frame: an instance moved to another depth while drawing is still drawn once, at its
+ * old place, and instances created while drawing wait for the next frame. Tiles outside the active
+ * view are skipped. */
+static void bs_game_runner_dispatch_draw_events_all(bs_game_runner *runner) {
+  const bs_room_data *room = NULL;
+  size_t count = 0;
+  if (runner == NULL) {
+    return;
+  }
+  memset(&runner->tile_stats, 0, sizeof(runner->tile_stats));
+  if (!runner->draw_list_ready || !bs_draw_list_sort(&runner->draw_list)) {
+    runner->draw_list_ready = false;
+    bs_game_runner_dispatch_draw_events_scan(runner);
+    return;
+  }
+  room = runner->current_room;
+
+  count = runner->draw_list.sorted_count;
+  for (size_t i = 0; i < count; i++) {
+    const bs_draw_entry entry = runner->draw_list.entries[i];
+    if (entry.removed &&
+        (entry.kind != BS_DRAW_ITEM_INSTANCE || !bs_draw_list_moved(&runner->draw_list, &entry))) {
+      continue;
+    }
+    if (entry.kind == BS_DRAW_ITEM_TILE) {
+      if (room != NULL && runner->render.draw_tile != NULL && (size_t)entry.key < runner->tile_layer_count) {
+        bs_game_runner_draw_tile_layer(runner, &runner->tile_layers[entry.key]);
+      }
+    } else {
+      bs_instance *inst = bs_instance_pool_at(&runner->instance_pool, entry.key);
+      if (!inst->destroyed) {
+        bs_game_runner_dispatch_draw_events_for_instance(runner, inst);
+      }
+    }
+  }
+}
+
 static void bs_game_runner_advance_instance_animation(bs_game_runner *runner, bs_instance *instance) {
+  bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
   size_t image_number = 0;
   if (runner == NULL || instance == NULL || instance->destroyed) {
     return;
   }
 
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+
   if (instance->sprite_index < 0) {
-    instance->image_index = 0.0;
+    motion->image_index[slot] = 0.0;
     return;
   }
 
@@ -1868,27 +3926,27 @@ static void bs_game_runner_advance_instance_animation(bs_game_runner *runner, bs
 
   image_number = bs_game_runner_sprite_frame_count(runner, instance->sprite_index);
   if (image_number <= 1u) {
-    instance->image_index = 0.0;
+    motion->image_index[slot] = 0.0;
     return;
   }
 
-  if (!isfinite(instance->image_index)) {
-    instance->image_index = 0.0;
+  if (!isfinite(motion->image_index[slot])) {
+    motion->image_index[slot] = 0.0;
   }
-  if (!isfinite(instance->image_speed)) {
-    instance->image_speed = 0.0;
+  if (!isfinite(motion->image_speed[slot])) {
+    motion->image_speed[slot] = 0.0;
   }
 
-  instance->image_index += instance->image_speed;
-  while (instance->image_index >= (double)image_number) {
-    instance->image_index -= (double)image_number;
+  motion->image_index[slot] += motion->image_speed[slot];
+  while (motion->image_index[slot] >= (double)image_number) {
+    motion->image_index[slot] -= (double)image_number;
     bs_game_runner_fire_event(runner, instance, BS_EVENT_OTHER, BS_OTHER_ANIMATION_END, NULL);
     if (instance->destroyed) {
       return;
     }
   }
-  while (instance->image_index < 0.0) {
-    instance->image_index += (double)image_number;
+  while (motion->image_index[slot] < 0.0) {
+    motion->image_index[slot] += (double)image_number;
     bs_game_runner_fire_event(runner, instance, BS_EVENT_OTHER, BS_OTHER_ANIMATION_END, NULL);
     if (instance->destroyed) {
       return;
@@ -1913,8 +3971,8 @@ static bs_instance *bs_game_runner_find_view_follow_instance(bs_game_runner *run
   if (follow_object_id >= 100000) {
     return bs_game_runner_find_instance_by_id(runner, follow_object_id);
   }
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     if (inst->destroyed) {
       continue;
     }
@@ -1975,15 +4033,15 @@ static void bs_game_runner_update_views(bs_game_runner *runner) {
 
     desired_x = view->view_x;
     desired_y = view->view_y;
-    if (target->x < (double)view->view_x + (double)border_h) {
-      desired_x = (int32_t)floor(target->x - (double)border_h);
-    } else if (target->x > (double)view->view_x + (double)(view_w - border_h)) {
-      desired_x = (int32_t)floor(target->x + (double)border_h - (double)view_w);
+    if (BS_MOTION(target, x) < (double)view->view_x + (double)border_h) {
+      desired_x = (int32_t)floor(BS_MOTION(target, x) - (double)border_h);
+    } else if (BS_MOTION(target, x) > (double)view->view_x + (double)(view_w - border_h)) {
+      desired_x = (int32_t)floor(BS_MOTION(target, x) + (double)border_h - (double)view_w);
     }
-    if (target->y < (double)view->view_y + (double)border_v) {
-      desired_y = (int32_t)floor(target->y - (double)border_v);
-    } else if (target->y > (double)view->view_y + (double)(view_h - border_v)) {
-      desired_y = (int32_t)floor(target->y + (double)border_v - (double)view_h);
+    if (BS_MOTION(target, y) < (double)view->view_y + (double)border_v) {
+      desired_y = (int32_t)floor(BS_MOTION(target, y) - (double)border_v);
+    } else if (BS_MOTION(target, y) > (double)view->view_y + (double)(view_h - border_v)) {
+      desired_y = (int32_t)floor(BS_MOTION(target, y) + (double)border_v - (double)view_h);
     }
 
     max_x = room_w - view_w;
@@ -2056,8 +4114,8 @@ static void bs_game_runner_save_room_state(bs_game_runner *runner, int32_t room_
   state = &runner->saved_room_states[(size_t)room_index];
   bs_saved_room_state_clear(state);
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    const bs_instance *inst = &runner->instances[i];
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     if (!inst->destroyed && !inst->persistent) {
       count++;
     }
@@ -2068,13 +4126,18 @@ static void bs_game_runner_save_room_state(bs_game_runner *runner, int32_t room_
   }
 
   state->instances = (bs_instance *)calloc(count, sizeof(bs_instance));
-  if (state->instances == NULL) {
+  state->motion = (bs_instance_motion *)calloc(count, sizeof(bs_instance_motion));
+  if (state->instances == NULL || state->motion == NULL) {
+    free(state->instances);
+    free(state->motion);
+    state->instances = NULL;
+    state->motion = NULL;
     state->instance_count = 0;
     return;
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    const bs_instance *inst = &runner->instances[i];
+  for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     if (inst->destroyed || inst->persistent) {
       continue;
     }
@@ -2083,10 +4146,13 @@ static void bs_game_runner_save_room_state(bs_game_runner *runner, int32_t room_
         bs_instance_dispose(&state->instances[j]);
       }
       free(state->instances);
+      free(state->motion);
       state->instances = NULL;
+      state->motion = NULL;
       state->instance_count = 0;
       return;
     }
+    bs_instance_pool_load_motion(inst, &state->motion[write]);
     write++;
   }
   state->instance_count = write;
@@ -2105,20 +4171,26 @@ static bool bs_game_runner_restore_room_state(bs_game_runner *runner, int32_t ro
   if (state->instance_count == 0 || state->instances == NULL) {
     return false;
   }
-  if (!bs_game_runner_ensure_instance_capacity(runner, runner->instance_count + state->instance_count)) {
-    return false;
-  }
-
   for (size_t i = 0; i < state->instance_count; i++) {
-    bs_instance *dst = &runner->instances[runner->instance_count];
+    bs_instance *dst = bs_instance_pool_acquire(&runner->instance_pool, state->instances[i].id);
+    if (dst == NULL) {
+      bs_instance_dispose(&state->instances[i]);
+      continue;
+    }
     *dst = state->instances[i];
     dst->destroyed = false;
-    runner->instance_count++;
+    bs_instance_pool_store_motion(dst, &state->motion[i]);
+    bs_game_runner_note_bbox_change(runner, dst);
+    bs_game_runner_listen_instance(runner, dst);
+    bs_game_runner_register_instance(runner, dst);
+    bs_game_runner_note_depth(runner, dst);
     memset(&state->instances[i], 0, sizeof(state->instances[i]));
   }
 
   free(state->instances);
+  free(state->motion);
   state->instances = NULL;
+  state->motion = NULL;
   state->instance_count = 0;
   return true;
 }
@@ -2138,7 +4210,8 @@ void bs_game_runner_goto_room(bs_game_runner *runner, int32_t room_index) {
   if (runner == NULL || runner->game_data == NULL || runner->vm == NULL) {
     return;
   }
-  if (room_index < 0 || (size_t)room_index >= runner->game_data->room_count) {
+  room = bs_game_data_room(runner->game_data, room_index);
+  if (room == NULL) {
     printf("WARNING: room_goto ignored (invalid room index %d)\n", room_index);
     return;
   }
@@ -2155,27 +4228,25 @@ void bs_game_runner_goto_room(bs_game_runner *runner, int32_t room_index) {
     bs_game_runner_save_room_state(runner, leaving_room_index);
   }
 
-  room = &runner->game_data->rooms[(size_t)room_index];
+  (void)bs_game_runner_release_destroyed(runner);
   {
-    size_t write_index = 0;
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      bs_instance *inst = &runner->instances[i];
-      bool keep_instance = (!inst->destroyed && inst->persistent);
-      if (keep_instance) {
-        if (write_index != i) {
-          runner->instances[write_index] = runner->instances[i];
-          memset(&runner->instances[i], 0, sizeof(runner->instances[i]));
-        }
-        write_index++;
-      } else {
+    bs_instance *inst = bs_game_runner_first_instance(runner);
+    while (inst != NULL) {
+      bs_instance *next = bs_game_runner_next_instance(runner, inst);
+      if (!inst->persistent) {
         bs_instance_dispose(inst);
+        bs_game_runner_unregister_instance(runner, inst);
+        bs_draw_list_remove(&runner->draw_list, BS_DRAW_ITEM_INSTANCE, bs_instance_slot_index(inst));
+        bs_instance_pool_release(&runner->instance_pool, inst);
       }
+      inst = next;
     }
-    runner->instance_count = write_index;
   }
+  bs_game_runner_rebuild_listeners(runner);
   runner->current_room_index = room_index;
   runner->current_room = room;
   runner->pending_room_goto = -1;
+  bs_game_runner_track_room_tiles(runner);
   restored_persistent_room = bs_game_runner_restore_room_state(runner, room_index);
 
   calls_before_create = runner->total_vm_event_calls;
@@ -2227,14 +4298,14 @@ void bs_game_runner_goto_room(bs_game_runner *runner, int32_t room_index) {
     printf("Room restore: id=%d name=%s restored_instances=%zu\n",
            room_index,
            room->name != NULL ? room->name : "<unnamed>",
-           runner->instance_count);
+           runner->instance_pool.count);
   }
 
   if (runner->trace_events && room_index == 1) {
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      const bs_instance *inst = &runner->instances[i];
-      if (inst->object_index >= 0 && (size_t)inst->object_index < runner->game_data->object_count) {
-        const bs_game_object_data *obj = &runner->game_data->objects[(size_t)inst->object_index];
+    for (const bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+         inst = bs_game_runner_next_instance(runner, inst)) {
+      const bs_game_object_data *obj = bs_game_data_object(runner->game_data, inst->object_index);
+      if (obj != NULL) {
         printf("  [OBJ EVT] obj=%d name=%s\n",
                inst->object_index,
                obj->name != NULL ? obj->name : "<unnamed>");
@@ -2281,6 +4352,7 @@ void bs_game_runner_goto_room(bs_game_runner *runner, int32_t room_index) {
   }
 
   bs_game_runner_dispatch_event_all(runner, BS_EVENT_OTHER, BS_OTHER_ROOM_START);
+  bs_game_runner_bake_static_instances(runner);
 
   printf("  Room setup events executed: calls=%llu instructions=%llu\n",
          (unsigned long long)(runner->total_vm_event_calls - calls_before_create),
@@ -2308,13 +4380,56 @@ void bs_game_runner_init(bs_game_runner *runner, const bs_game_data *game_data,
   runner->current_room = NULL;
   runner->pending_room_goto = -1;
   runner->next_instance_id = 100000;
-  runner->instances = NULL;
-  runner->instance_count = 0;
-  runner->instance_capacity = 0;
+  bs_instance_pool_init(&runner->instance_pool);
+  bs_collision_grid_init(&runner->collision_grid);
+  runner->collision_entry_of_slot = NULL;
+  runner->collision_entry_of_slot_capacity = 0;
+  runner->collision_tracking = false;
+  bs_sweep_list_init(&runner->solid_sweep);
+  bs_draw_list_init(&runner->draw_list);
+  runner->draw_list_ready = true;
+  runner->tile_layers = NULL;
+  runner->tile_layer_count = 0;
+  runner->tile_layer_capacity = 0;
+  runner->tile_layer_indices = NULL;
+  runner->tile_layer_index_capacity = 0;
+  runner->tile_layers_ready = false;
+  memset(&runner->tile_stats, 0, sizeof(runner->tile_stats));
+  bs_collision_grid_init(&runner->static_grid);
+  runner->static_entries = NULL;
+  runner->static_entry_count = 0;
+  runner->static_entry_capacity = 0;
+  bs_collision_grid_init(&runner->query_grid);
+  runner->query_grid_ready = false;
+  runner->query_results = NULL;
+  runner->query_result_capacity = 0;
+  for (size_t w = 0; w < BS_COLLISION_MAX_THREADS; w++) {
+    bs_collision_worker *worker = &runner->collision_workers[w];
+    bs_collision_grid_reader_init(&worker->grid_reader);
+    bs_collision_grid_reader_init(&worker->static_reader);
+    worker->merged = NULL;
+    worker->merged_capacity = 0;
+    worker->hits = NULL;
+    worker->hit_count = 0;
+    worker->hit_capacity = 0;
+    worker->begin = 0;
+    worker->end = 0;
+    worker->ok = false;
+  }
+  runner->collision_thread_count = bs_system_thread_count("BS_COLLISION_THREADS", BS_COLLISION_MAX_THREADS);
+  runner->collision_pool = NULL;
   runner->room_persistent_flags = NULL;
   runner->room_persistent_flag_count = 0;
   runner->saved_room_states = NULL;
   runner->saved_room_state_count = 0;
+  runner->object_dispatch = NULL;
+  runner->object_dispatch_count = 0;
+  runner->ancestry_enter = NULL;
+  runner->ancestry_exit = NULL;
+  runner->object_registry = NULL;
+  runner->object_registry_count = 0;
+  memset(runner->event_listeners, 0, sizeof(runner->event_listeners));
+  runner->event_listeners_ready = true;
   memset(runner->keys_held, 0, sizeof(runner->keys_held));
   memset(runner->keys_pressed, 0, sizeof(runner->keys_pressed));
   memset(runner->keys_released, 0, sizeof(runner->keys_released));
@@ -2351,6 +4466,14 @@ void bs_game_runner_init(bs_game_runner *runner, const bs_game_data *game_data,
   runner->render.draw_text = NULL;
   runner->render.draw_rect = NULL;
   memset(&runner->audio, 0, sizeof(runner->audio));
+  if (game_data != NULL && game_data->object_count > 0) {
+    runner->object_dispatch = (bs_object_dispatch *)calloc(game_data->object_count, sizeof(bs_object_dispatch));
+    if (runner->object_dispatch != NULL) {
+      runner->object_dispatch_count = game_data->object_count;
+    }
+    bs_game_runner_build_ancestry(runner);
+    bs_game_runner_build_registry(runner);
+  }
   if (game_data != NULL && game_data->room_count > 0) {
     runner->room_persistent_flags = (bool *)calloc(game_data->room_count, sizeof(bool));
     runner->saved_room_states = (bs_saved_room_state *)calloc(game_data->room_count, sizeof(bs_saved_room_state));
@@ -2358,7 +4481,7 @@ void bs_game_runner_init(bs_game_runner *runner, const bs_game_data *game_data,
       runner->room_persistent_flag_count = game_data->room_count;
       runner->saved_room_state_count = game_data->room_count;
       for (size_t i = 0; i < game_data->room_count; i++) {
-        runner->room_persistent_flags[i] = game_data->rooms[i].persistent;
+        runner->room_persistent_flags[i] = bs_game_data_room_persistent(game_data, (int32_t)i);
       }
     } else {
       free(runner->room_persistent_flags);
@@ -2393,7 +4516,6 @@ void bs_game_runner_init(bs_game_runner *runner, const bs_game_data *game_data,
 void bs_game_runner_step(bs_game_runner *runner) {
   uint64_t calls_before = 0;
   uint64_t instructions_before = 0;
-  const double pi = 3.14159265358979323846;
   const bool trace_frame = bs_trace_frame_enabled();
 
   if (runner == NULL || !runner->initialized || runner->game_data == NULL) {
@@ -2405,28 +4527,22 @@ void bs_game_runner_step(bs_game_runner *runner) {
     printf("Frame %llu room=%d instances=%zu\n",
            (unsigned long long)runner->frame_count,
            runner->current_room_index,
-           runner->instance_count);
+           runner->instance_pool.count);
   }
 
   if (runner->pending_room_goto >= 0) {
     bs_game_runner_goto_room(runner, runner->pending_room_goto);
   }
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    if (runner->instances[i].destroyed) {
-      continue;
-    }
-    runner->instances[i].xprevious = runner->instances[i].x;
-    runner->instances[i].yprevious = runner->instances[i].y;
-  }
+  bs_instance_motion_store_previous(&runner->instance_pool.motion, runner->instance_pool.slot_count);
 
   calls_before = runner->total_vm_event_calls;
   instructions_before = runner->total_vm_instructions;
 
   bs_game_runner_dispatch_event_all(runner, BS_EVENT_STEP, 1);
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
     if (inst->destroyed) {
       continue;
     }
@@ -2459,44 +4575,14 @@ void bs_game_runner_step(bs_game_runner *runner) {
   bs_game_runner_dispatch_event_all(runner, BS_EVENT_STEP, 2);
   bs_game_runner_update_path_following(runner);
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_instance *inst = &runner->instances[i];
-    if (inst->destroyed) {
-      continue;
-    }
-
-    if (inst->gravity != 0.0) {
-      const double dir_rad = inst->gravity_direction * (pi / 180.0);
-      inst->hspeed += inst->gravity * cos(dir_rad);
-      inst->vspeed -= inst->gravity * sin(dir_rad);
-      inst->speed = sqrt(inst->hspeed * inst->hspeed + inst->vspeed * inst->vspeed);
-      inst->direction = fmod((atan2(-inst->vspeed, inst->hspeed) * (180.0 / pi)) + 360.0, 360.0);
-    }
-
-    if (inst->friction != 0.0 && inst->speed != 0.0) {
-      const double new_speed = inst->speed - inst->friction;
-      if (new_speed <= 0.0) {
-        inst->speed = 0.0;
-        inst->hspeed = 0.0;
-        inst->vspeed = 0.0;
-      } else {
-        const double dir_rad = inst->direction * (pi / 180.0);
-        inst->speed = new_speed;
-        inst->hspeed = new_speed * cos(dir_rad);
-        inst->vspeed = -new_speed * sin(dir_rad);
-      }
-    }
-
-    if (inst->hspeed != 0.0 || inst->vspeed != 0.0) {
-      inst->x += inst->hspeed;
-      inst->y += inst->vspeed;
-    }
-  }
+  bs_instance_motion_integrate(&runner->instance_pool.motion, runner->instance_pool.slot_count);
+  runner->query_grid_ready = false;
 
   bs_game_runner_check_outside_room_events(runner);
 
-  for (size_t i = 0; i < runner->instance_count; i++) {
-    bs_game_runner_advance_instance_animation(runner, &runner->instances[i]);
+  for (bs_instance *inst = bs_game_runner_first_instance(runner); inst != NULL;
+       inst = bs_game_runner_next_instance(runner, inst)) {
+    bs_game_runner_advance_instance_animation(runner, inst);
   }
 
   bs_game_runner_update_views(runner);
@@ -2508,25 +4594,14 @@ void bs_game_runner_step(bs_game_runner *runner) {
   bs_game_runner_dispatch_draw_events_all(runner);
   bs_game_runner_draw_room_backgrounds(runner, true);
 
-  {
-    size_t write_index = 0;
-    for (size_t i = 0; i < runner->instance_count; i++) {
-      if (runner->instances[i].destroyed) {
-        bs_instance_dispose(&runner->instances[i]);
-        continue;
-      }
-      if (write_index != i) {
-        runner->instances[write_index] = runner->instances[i];
-        memset(&runner->instances[i], 0, sizeof(runner->instances[i]));
-      }
-      write_index++;
-    }
-    runner->instance_count = write_index;
+  if (bs_game_runner_release_destroyed(runner) && !runner->event_listeners_ready) {
+    bs_game_runner_rebuild_listeners(runner);
   }
 
   bs_game_runner_trace_intro_state(runner);
 
   if (trace_frame) {
+    printf("  Draw: tiles visited=%zu drawn=%zu\n", runner->tile_stats.tiles_visited, runner->tile_stats.tiles_drawn);
     printf("  Step VM: calls=%llu instructions=%llu\n",
            (unsigned long long)(runner->total_vm_event_calls - calls_before),
            (unsigned long long)(runner->total_vm_instructions - instructions_before));
@@ -2558,6 +4633,17 @@ void bs_game_runner_on_key_up(bs_game_runner *runner, int32_t key) {
   runner->keys_released[key] = true;
 }
 
+void bs_game_runner_tile_stats(const bs_game_runner *runner, bs_tile_draw_stats *out_stats) {
+  if (out_stats == NULL) {
+    return;
+  }
+  if (runner == NULL) {
+    memset(out_stats, 0, sizeof(*out_stats));
+    return;
+  }
+  *out_stats = runner->tile_stats;
+}
+
 void bs_game_runner_dispose(bs_game_runner *runner) {
   if (runner == NULL) {
     return;
@@ -2573,6 +4659,56 @@ void bs_game_runner_dispose(bs_game_runner *runner) {
   bs_game_runner_clear_all_saved_room_states(runner);
   free(runner->saved_room_states);
   free(runner->room_persistent_flags);
+  bs_game_runner_free_listeners(runner);
+  bs_collision_grid_dispose(&runner->collision_grid);
+  free(runner->collision_entry_of_slot);
+  runner->collision_entry_of_slot = NULL;
+  runner->collision_entry_of_slot_capacity = 0;
+  bs_sweep_list_dispose(&runner->solid_sweep);
+  bs_draw_list_dispose(&runner->draw_list);
+  for (size_t i = 0; i < runner->tile_layer_capacity; i++) {
+    bs_collision_grid_dispose(&runner->tile_layers[i].grid);
+  }
+  free(runner->tile_layers);
+  free(runner->tile_layer_indices);
+  runner->tile_layers = NULL;
+  runner->tile_layer_count = 0;
+  runner->tile_layer_capacity = 0;
+  runner->tile_layer_indices = NULL;
+  runner->tile_layer_index_capacity = 0;
+  bs_collision_grid_dispose(&runner->static_grid);
+  free(runner->static_entries);
+  runner->static_entries = NULL;
+  runner->static_entry_count = 0;
+  runner->static_entry_capacity = 0;
+  bs_collision_grid_dispose(&runner->query_grid);
+  runner->query_grid_ready = false;
+  free(runner->query_results);
+  runner->query_results = NULL;
+  runner->query_result_capacity = 0;
+#if defined(BS_HAVE_PTHREADS)
+  bs_game_runner_stop_collision_pool(runner);
+#endif
+  for (size_t w = 0; w < BS_COLLISION_MAX_THREADS; w++) {
+    bs_collision_worker *worker = &runner->collision_workers[w];
+    bs_collision_grid_reader_dispose(&worker->grid_reader);
+    bs_collision_grid_reader_dispose(&worker->static_reader);
+    free(worker->merged);
+    worker->merged = NULL;
+    worker->merged_capacity = 0;
+    free(worker->hits);
+    worker->hits = NULL;
+    worker->hit_count = 0;
+    worker->hit_capacity = 0;
+  }
+  bs_game_runner_free_dispatch(runner);
+  free(runner->ancestry_enter);
+  free(runner->ancestry_exit);
+  runner->ancestry_enter = NULL;
+  runner->ancestry_exit = NULL;
+  free(runner->object_registry);
+  runner->object_registry = NULL;
+  runner->object_registry_count = 0;
   runner->initialized = false;
   runner->game_data = NULL;
   runner->vm = NULL;
@@ -0,0 +1,449 @@
+#include "bs/runtime/instance_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const bs_instance_motion k_zero_motion = {0};
+
+static bs_instance_slot *slot_at(const bs_instance_pool *pool, uint32_t index) {
+  return &pool->blocks[index >> BS_INSTANCE_BLOCK_SHIFT][index & (BS_INSTANCE_BLOCK_SIZE - 1u)];
+}
+
+static bs_instance_slot *slot_of(bs_instance *instance) {
+  return (bs_instance_slot *)(void *)instance;
+}
+
+static size_t id_map_home(const bs_instance_id_map *map, int32_t id) {
+  return (size_t)((uint32_t)id * 2654435761u) & (map->capacity - 1u);
+}
+
+static size_t id_map_find_cell(const bs_instance_id_map *map, int32_t id) {
+  size_t cell = 0;
+  if (map->capacity == 0) {
+    return SIZE_MAX;
+  }
+  cell = id_map_home(map, id);
+  while (map->slots[cell] != BS_INSTANCE_SLOT_NONE) {
+    if (map->ids[cell] == id) {
+      return cell;
+    }
+    cell = (cell + 1u) & (map->capacity - 1u);
+  }
+  return SIZE_MAX;
+}
+
+static void id_map_place(bs_instance_id_map *map, int32_t id, uint32_t slot) {
+  size_t cell = id_map_home(map, id);
+  while (map->slots[cell] != BS_INSTANCE_SLOT_NONE) {
+    cell = (cell + 1u) & (map->capacity - 1u);
+  }
+  map->ids[cell] = id;
+  map->slots[cell] = slot;
+  map->count++;
+}
+
+static bool id_map_grow(bs_instance_id_map *map) {
+  size_t old_capacity = map->capacity;
+  int32_t *old_ids = map->ids;
+  uint32_t *old_slots = map->slots;
+  size_t new_capacity = (old_capacity == 0) ? 256u : (old_capacity * 2u);
+
+  map->ids = (int32_t *)malloc(new_capacity * sizeof(int32_t));
+  map->slots = (uint32_t *)malloc(new_capacity * sizeof(uint32_t));
+  if (map->ids == NULL || map->slots == NULL) {
+    free(map->ids);
+    free(map->slots);
+    map->ids = old_ids;
+    map->slots = old_slots;
+    return false;
+  }
+  memset(map->slots, 0xFF, new_capacity * sizeof(uint32_t));
+  map->capacity = new_capacity;
+  map->count = 0;
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_slots[i] != BS_INSTANCE_SLOT_NONE) {
+      id_map_place(map, old_ids[i], old_slots[i]);
+    }
+  }
+  free(old_ids);
+  free(old_slots);
+  return true;
+}
+
+/* An id that is already mapped keeps its older instance, matching the old first-match scan. */
+static bool id_map_insert(bs_instance_id_map *map, int32_t id, uint32_t slot) {
+  if (id_map_find_cell(map, id) != SIZE_MAX) {
+    map->duplicate_count++;
+    return true;
+  }
+  if ((map->count + 1u) * 2u > map->capacity && !id_map_grow(map)) {
+    return false;
+  }
+  id_map_place(map, id, slot);
+  return true;
+}
+
+/* Backward-shift deletion keeps probe chains intact without tombstones. */
+static void id_map_remove_cell(bs_instance_id_map *map, size_t cell) {
+  size_t hole = cell;
+  size_t next = (cell + 1u) & (map->capacity - 1u);
+  while (map->slots[next] != BS_INSTANCE_SLOT_NONE) {
+    size_t home = id_map_home(map, map->ids[next]);
+    if (((next - home) & (map->capacity - 1u)) >= ((next - hole) & (map->capacity - 1u))) {
+      map->ids[hole] = map->ids[next];
+      map->slots[hole] = map->slots[next];
+      hole = next;
+    }
+    next = (next + 1u) & (map->capacity - 1u);
+  }
+  map->slots[hole] = BS_INSTANCE_SLOT_NONE;
+  map->count--;
+}
+
+static bool grow_column(double **column, size_t capacity) {
+  double *grown = (double *)realloc(*column, capacity * sizeof(double));
+  if (grown == NULL) {
+    return false;
+  }
+  *column = grown;
+  return true;
+}
+
+/* Columns that grew before a failure stay grown; capacity only moves once all of them did. */
+static bool motion_grow(bs_instance_motion_columns *motion, size_t capacity) {
+  uint8_t *bbox_state = NULL;
+  uint8_t *active = NULL;
+
+  if (!grow_column(&motion->x, capacity) ||
+      !grow_column(&motion->y, capacity) ||
+      !grow_column(&motion->xprevious, capacity) ||
+      !grow_column(&motion->yprevious, capacity) ||
+      !grow_column(&motion->hspeed, capacity) ||
+      !grow_column(&motion->vspeed, capacity) ||
+      !grow_column(&motion->speed, capacity) ||
+      !grow_column(&motion->direction, capacity) ||
+      !grow_column(&motion->friction, capacity) ||
+      !grow_column(&motion->gravity, capacity) ||
+      !grow_column(&motion->gravity_direction, capacity) ||
+      !grow_column(&motion->image_index, capacity) ||
+      !grow_column(&motion->image_speed, capacity) ||
+      !grow_column(&motion->gravity_trig_angle, capacity) ||
+      !grow_column(&motion->gravity_cos, capacity) ||
+      !grow_column(&motion->gravity_sin, capacity) ||
+      !grow_column(&motion->direction_trig_angle, capacity) ||
+      !grow_column(&motion->direction_cos, capacity) ||
+      !grow_column(&motion->direction_sin, capacity) ||
+      !grow_column(&motion->bbox_left, capacity) ||
+      !grow_column(&motion->bbox_top, capacity) ||
+      !grow_column(&motion->bbox_right, capacity) ||
+      !grow_column(&motion->bbox_bottom, capacity)) {
+    return false;
+  }
+  bbox_state = (uint8_t *)realloc(motion->bbox_state, capacity);
+  if (bbox_state == NULL) {
+    return false;
+  }
+  memset(bbox_state + motion->capacity, BS_BBOX_DIRTY, capacity - motion->capacity);
+  motion->bbox_state = bbox_state;
+  active = (uint8_t *)realloc(motion->active, capacity);
+  if (active == NULL) {
+    return false;
+  }
+  memset(active + motion->capacity, 0, capacity - motion->capacity);
+  /* Seed the trig caches with the exact values for angle 0 so they are valid from the start. */
+  for (size_t slot = motion->capacity; slot < capacity; slot++) {
+    motion->gravity_trig_angle[slot] = 0.0;
+    motion->gravity_cos[slot] = 1.0;
+    motion->gravity_sin[slot] = 0.0;
+    motion->direction_trig_angle[slot] = 0.0;
+    motion->direction_cos[slot] = 1.0;
+    motion->direction_sin[slot] = 0.0;
+  }
+  motion->active = active;
+  motion->capacity = capacity;
+  return true;
+}
+
+static void motion_free(bs_instance_motion_columns *motion) {
+  free(motion->x);
+  free(motion->y);
+  free(motion->xprevious);
+  free(motion->yprevious);
+  free(motion->hspeed);
+  free(motion->vspeed);
+  free(motion->speed);
+  free(motion->direction);
+  free(motion->friction);
+  free(motion->gravity);
+  free(motion->gravity_direction);
+  free(motion->image_index);
+  free(motion->image_speed);
+  free(motion->gravity_trig_angle);
+  free(motion->gravity_cos);
+  free(motion->gravity_sin);
+  free(motion->direction_trig_angle);
+  free(motion->direction_cos);
+  free(motion->direction_sin);
+  free(motion->bbox_left);
+  free(motion->bbox_top);
+  free(motion->bbox_right);
+  free(motion->bbox_bottom);
+  free(motion->bbox_state);
+  free(motion->active);
+}
+
+void bs_instance_pool_init(bs_instance_pool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+  memset(pool, 0, sizeof(*pool));
+  pool->head = BS_INSTANCE_SLOT_NONE;
+  pool->tail = BS_INSTANCE_SLOT_NONE;
+  pool->free_head = BS_INSTANCE_SLOT_NONE;
+  pool->released_head = BS_INSTANCE_SLOT_NONE;
+}
+
+/* Frees pool memory only; callers dispose instance contents first. */
+void bs_instance_pool_dispose(bs_instance_pool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < pool->block_count; i++) {
+    free(pool->blocks[i]);
+  }
+  free(pool->blocks);
+  free(pool->id_map.ids);
+  free(pool->id_map.slots);
+  motion_free(&pool->motion);
+  bs_instance_pool_init(pool);
+}
+
+static bs_instance_slot *pool_take_slot(bs_instance_pool *pool) {
+  bs_instance_slot *slot = NULL;
+
+  if (pool->free_head != BS_INSTANCE_SLOT_NONE) {
+    slot = slot_at(pool, pool->free_head);
+    pool->free_head = slot->next;
+    return slot;
+  }
+
+  if (pool->slot_count >= (size_t)BS_INSTANCE_SLOT_NONE) {
+    return NULL;
+  }
+  if (pool->slot_count == pool->block_count * BS_INSTANCE_BLOCK_SIZE) {
+    bs_instance_slot **grown = NULL;
+    if (pool->motion.capacity < (pool->block_count + 1u) * BS_INSTANCE_BLOCK_SIZE &&
+        !motion_grow(&pool->motion, (pool->block_count + 1u) * BS_INSTANCE_BLOCK_SIZE)) {
+      return NULL;
+    }
+    grown = (bs_instance_slot **)realloc(pool->blocks, (pool->block_count + 1u) * sizeof(bs_instance_slot *));
+    if (grown == NULL) {
+      return NULL;
+    }
+    pool->blocks = grown;
+    pool->blocks[pool->block_count] = (bs_instance_slot *)calloc(BS_INSTANCE_BLOCK_SIZE, sizeof(bs_instance_slot));
+    if (pool->blocks[pool->block_count] == NULL) {
+      return NULL;
+    }
+    pool->block_count++;
+  }
+  slot = slot_at(pool, (uint32_t)pool->slot_count);
+  slot->pool = pool;
+  slot->index = (uint32_t)pool->slot_count;
+  slot->generation = 0;
+  pool->slot_count++;
+  return slot;
+}
+
+/* Returns a zeroed instance carrying id, linked after every other live instance. */
+bs_instance *bs_instance_pool_acquire(bs_instance_pool *pool, int32_t id) {
+  bs_instance_slot *slot = NULL;
+
+  if (pool == NULL) {
+    return NULL;
+  }
+  slot = pool_take_slot(pool);
+  if (slot == NULL) {
+    return NULL;
+  }
+  if (!id_map_insert(&pool->id_map, id, slot->index)) {
+    slot->next = pool->free_head;
+    pool->free_head = slot->index;
+    return NULL;
+  }
+
+  memset(&slot->instance, 0, sizeof(slot->instance));
+  slot->instance.id = id;
+  bs_instance_pool_store_motion(&slot->instance, &k_zero_motion);
+  pool->motion.active[slot->index] = 1u;
+  slot->sequence = pool->next_sequence++;
+  slot->live = true;
+  slot->release_pending = false;
+  slot->next_released = BS_INSTANCE_SLOT_NONE;
+  slot->prev = pool->tail;
+  slot->next = BS_INSTANCE_SLOT_NONE;
+  if (pool->tail != BS_INSTANCE_SLOT_NONE) {
+    slot_at(pool, pool->tail)->next = slot->index;
+  } else {
+    pool->head = slot->index;
+  }
+  pool->tail = slot->index;
+  pool->count++;
+  return &slot->instance;
+}
+
+/* Queues a destroyed instance; it stays linked and findable until popped and released. */
+void bs_instance_pool_mark_released(bs_instance_pool *pool, bs_instance *instance) {
+  bs_instance_slot *slot = NULL;
+  if (pool == NULL || instance == NULL) {
+    return;
+  }
+  slot = slot_of(instance);
+  if (!slot->live || slot->release_pending) {
+    return;
+  }
+  slot->release_pending = true;
+  pool->motion.active[slot->index] = 0u;
+  slot->next_released = pool->released_head;
+  pool->released_head = slot->index;
+}
+
+bs_instance *bs_instance_pool_pop_released(bs_instance_pool *pool) {
+  bs_instance_slot *slot = NULL;
+  if (pool == NULL || pool->released_head == BS_INSTANCE_SLOT_NONE) {
+    return NULL;
+  }
+  slot = slot_at(pool, pool->released_head);
+  pool->released_head = slot->next_released;
+  slot->next_released = BS_INSTANCE_SLOT_NONE;
+  slot->release_pending = false;
+  return &slot->instance;
+}
+
+/* Unlinks the instance and frees its slot. Must not be called on an instance still queued by
+ * bs_instance_pool_mark_released. */
+void bs_instance_pool_release(bs_instance_pool *pool, bs_instance *instance) {
+  bs_instance_slot *slot = NULL;
+  size_t cell = 0;
+
+  if (pool == NULL || instance == NULL) {
+    return;
+  }
+  slot = slot_of(instance);
+  if (!slot->live) {
+    return;
+  }
+
+  if (slot->prev != BS_INSTANCE_SLOT_NONE) {
+    slot_at(pool, slot->prev)->next = slot->next;
+  } else {
+    pool->head = slot->next;
+  }
+  if (slot->next != BS_INSTANCE_SLOT_NONE) {
+    slot_at(pool, slot->next)->prev = slot->prev;
+  } else {
+    pool->tail = slot->prev;
+  }
+
+  cell = id_map_find_cell(&pool->id_map, instance->id);
+  if (cell != SIZE_MAX && pool->id_map.slots[cell] == slot->index) {
+    id_map_remove_cell(&pool->id_map, cell);
+    if (pool->id_map.duplicate_count > 0) {
+      for (uint32_t at = pool->head; at != BS_INSTANCE_SLOT_NONE; at = slot_at(pool, at)->next) {
+        if (slot_at(pool, at)->instance.id == instance->id) {
+          id_map_place(&pool->id_map, instance->id, at);
+          pool->id_map.duplicate_count--;
+          break;
+        }
+      }
+    }
+  } else if (pool->id_map.duplicate_count > 0) {
+    pool->id_map.duplicate_count--;
+  }
+
+  slot->live = false;
+  pool->motion.active[slot->index] = 0u;
+  slot->generation++;
+  slot->prev = BS_INSTANCE_SLOT_NONE;
+  slot->next = pool->free_head;
+  pool->free_head = slot->index;
+  pool->count--;
+}
+
+void bs_instance_pool_load_motion(const bs_instance *instance, bs_instance_motion *out_motion) {
+  const bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
+  if (instance == NULL || out_motion == NULL) {
+    return;
+  }
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+  out_motion->x = motion->x[slot];
+  out_motion->y = motion->y[slot];
+  out_motion->xprevious = motion->xprevious[slot];
+  out_motion->yprevious = motion->yprevious[slot];
+  out_motion->hspeed = motion->hspeed[slot];
+  out_motion->vspeed = motion->vspeed[slot];
+  out_motion->speed = motion->speed[slot];
+  out_motion->direction = motion->direction[slot];
+  out_motion->friction = motion->friction[slot];
+  out_motion->gravity = motion->gravity[slot];
+  out_motion->gravity_direction = motion->gravity_direction[slot];
+  out_motion->image_index = motion->image_index[slot];
+  out_motion->image_speed = motion->image_speed[slot];
+}
+
+void bs_instance_pool_store_motion(bs_instance *instance, const bs_instance_motion *in_motion) {
+  bs_instance_motion_columns *motion = NULL;
+  uint32_t slot = 0;
+  if (instance == NULL || in_motion == NULL) {
+    return;
+  }
+  motion = bs_instance_motion_of(instance);
+  slot = bs_instance_slot_index(instance);
+  motion->x[slot] = in_motion->x;
+  motion->y[slot] = in_motion->y;
+  motion->xprevious[slot] = in_motion->xprevious;
+  motion->yprevious[slot] = in_motion->yprevious;
+  motion->hspeed[slot] = in_motion->hspeed;
+  motion->vspeed[slot] = in_motion->vspeed;
+  motion->speed[slot] = in_motion->speed;
+  motion->direction[slot] = in_motion->direction;
+  motion->friction[slot] = in_motion->friction;
+  motion->gravity[slot] = in_motion->gravity;
+  motion->gravity_direction[slot] = in_motion->gravity_direction;
+  motion->image_index[slot] = in_motion->image_index;
+  motion->image_speed[slot] = in_motion->image_speed;
+  motion->bbox_state[slot] = BS_BBOX_DIRTY;
+}
+
+bs_instance *bs_instance_pool_find_id(const bs_instance_pool *pool, int32_t id) {
+  size_t cell = 0;
+  if (pool == NULL) {
+    return NULL;
+  }
+  cell = id_map_find_cell(&pool->id_map, id);
+  return cell == SIZE_MAX ? NULL : bs_instance_pool_at(pool, pool->id_map.slots[cell]);
+}
+
+bs_instance_handle bs_instance_pool_handle(const bs_instance *instance) {
+  bs_instance_handle handle = {BS_INSTANCE_SLOT_NONE, 0};
+  if (instance != NULL) {
+    const bs_instance_slot *slot = (const bs_instance_slot *)(const void *)instance;
+    handle.slot = slot->index;
+    handle.generation = slot->generation;
+  }
+  return handle;
+}
+
+bs_instance *bs_instance_pool_resolve(const bs_instance_pool *pool, bs_instance_handle handle) {
+  const bs_instance_slot *slot = NULL;
+  if (pool == NULL || handle.slot >= pool->slot_count) {
+    return NULL;
+  }
+  slot = slot_at(pool, handle.slot);
+  if (!slot->live || slot->generation != handle.generation) {
+    return NULL;
+  }
+  return bs_instance_pool_at(pool, handle.slot);
+}
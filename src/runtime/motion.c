@@ -0,0 +1,189 @@
+#include "bs/runtime/motion.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BS_MOTION_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BS_MOTION_SSE2 1
+#endif
+
+static const double k_pi = 3.14159265358979323846;
+
+/* Bitwise so that -0.0 and 0.0 (whose sines differ in sign) never share a cache entry. */
+static bool same_bits(double lhs, double rhs) {
+  return memcmp(&lhs, &rhs, sizeof(double)) == 0;
+}
+
+/* cos/sin of an angle in degrees, reusing the slot's last result while the angle is unchanged. The
+ * values are the libm ones the uncached code computed, so output does not depend on hit or miss. */
+static void cached_trig(double degrees, double *key, double *cached_cos, double *cached_sin) {
+  if (!same_bits(*key, degrees)) {
+    const double radians = degrees * (k_pi / 180.0);
+    *key = degrees;
+    *cached_cos = cos(radians);
+    *cached_sin = sin(radians);
+  }
+}
+
+void bs_instance_motion_store_previous(bs_instance_motion_columns *motion, size_t slot_count) {
+  size_t slot = 0;
+
+#if defined(BS_MOTION_AVX2)
+  for (; slot + 4u <= slot_count; slot += 4u) {
+    int32_t active_bytes = 0;
+    __m256d active;
+    memcpy(&active_bytes, &motion->active[slot], sizeof(active_bytes));
+    active = _mm256_castsi256_pd(
+        _mm256_cmpgt_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(active_bytes)), _mm256_setzero_si256()));
+    _mm256_storeu_pd(&motion->xprevious[slot],
+                     _mm256_blendv_pd(_mm256_loadu_pd(&motion->xprevious[slot]),
+                                      _mm256_loadu_pd(&motion->x[slot]),
+                                      active));
+    _mm256_storeu_pd(&motion->yprevious[slot],
+                     _mm256_blendv_pd(_mm256_loadu_pd(&motion->yprevious[slot]),
+                                      _mm256_loadu_pd(&motion->y[slot]),
+                                      active));
+  }
+#elif defined(BS_MOTION_SSE2)
+  for (; slot + 2u <= slot_count; slot += 2u) {
+    const __m128d active = _mm_castsi128_pd(
+        _mm_set_epi64x(-(long long)motion->active[slot + 1u], -(long long)motion->active[slot]));
+    _mm_storeu_pd(&motion->xprevious[slot],
+                  _mm_or_pd(_mm_and_pd(active, _mm_loadu_pd(&motion->x[slot])),
+                            _mm_andnot_pd(active, _mm_loadu_pd(&motion->xprevious[slot]))));
+    _mm_storeu_pd(&motion->yprevious[slot],
+                  _mm_or_pd(_mm_and_pd(active, _mm_loadu_pd(&motion->y[slot])),
+                            _mm_andnot_pd(active, _mm_loadu_pd(&motion->yprevious[slot]))));
+  }
+#endif
+
+  for (; slot < slot_count; slot++) {
+    if (!motion->active[slot]) {
+      continue;
+    }
+    motion->xprevious[slot] = motion->x[slot];
+    motion->yprevious[slot] = motion->y[slot];
+  }
+}
+
+/* Gravity and friction are branchy and call libm, so they stay scalar; most instances have
+ * neither and fall straight through. speed and direction are only re-derived when gravity moved
+ * hspeed/vspeed, and trig is only recomputed when an angle actually changed.
+ *
+ * direction is fmod(degrees + 360, 360), and degrees from atan2 lies within a rounding step of
+ * [-180, 180], so the sum is in [180, 540]: fmod subtracts 360 at most once, which is exact there
+ * (Sterbenz). The compare gives the same bits without the libm call. */
+static void apply_forces(bs_instance_motion_columns *motion, size_t slot_count) {
+  for (size_t slot = 0; slot < slot_count; slot++) {
+    if (!motion->active[slot] || (motion->gravity[slot] == 0.0 && motion->friction[slot] == 0.0)) {
+      continue;
+    }
+
+    if (motion->gravity[slot] != 0.0) {
+      double hspeed = 0.0;
+      double vspeed = 0.0;
+      double wrapped = 0.0;
+      cached_trig(motion->gravity_direction[slot],
+                  &motion->gravity_trig_angle[slot],
+                  &motion->gravity_cos[slot],
+                  &motion->gravity_sin[slot]);
+      hspeed = motion->hspeed[slot] + motion->gravity[slot] * motion->gravity_cos[slot];
+      vspeed = motion->vspeed[slot] - motion->gravity[slot] * motion->gravity_sin[slot];
+      motion->hspeed[slot] = hspeed;
+      motion->vspeed[slot] = vspeed;
+      wrapped = (atan2(-vspeed, hspeed) * (180.0 / k_pi)) + 360.0;
+      motion->speed[slot] = sqrt(hspeed * hspeed + vspeed * vspeed);
+      motion->direction[slot] = (wrapped >= 360.0) ? wrapped - 360.0 : wrapped;
+    }
+
+    if (motion->friction[slot] != 0.0 && motion->speed[slot] != 0.0) {
+      const double new_speed = motion->speed[slot] - motion->friction[slot];
+      if (new_speed <= 0.0) {
+        motion->speed[slot] = 0.0;
+        motion->hspeed[slot] = 0.0;
+        motion->vspeed[slot] = 0.0;
+      } else {
+        cached_trig(motion->direction[slot],
+                    &motion->direction_trig_angle[slot],
+                    &motion->direction_cos[slot],
+                    &motion->direction_sin[slot]);
+        motion->speed[slot] = new_speed;
+        motion->hspeed[slot] = new_speed * motion->direction_cos[slot];
+        motion->vspeed[slot] = -new_speed * motion->direction_sin[slot];
+      }
+    }
+  }
+}
+
+#if defined(BS_MOTION_AVX2) || defined(BS_MOTION_SSE2)
+static void mark_moved(bs_instance_motion_columns *motion, size_t slot, int lanes_moved, size_t lane_count) {
+  for (size_t lane = 0; lane < lane_count; lane++) {
+    if ((lanes_moved >> lane) & 1) {
+      motion->bbox_state[slot + lane] = BS_BBOX_DIRTY;
+    }
+  }
+}
+#endif
+
+/* x += hspeed, y += vspeed for active slots that are moving, marking their cached boxes dirty.
+ * Stationary slots are left untouched rather than having 0.0 added, which would turn a -0.0
+ * coordinate into 0.0. */
+static void advance_positions(bs_instance_motion_columns *motion, size_t slot_count) {
+  size_t slot = 0;
+
+#if defined(BS_MOTION_AVX2)
+  const __m256d zero = _mm256_setzero_pd();
+  for (; slot + 4u <= slot_count; slot += 4u) {
+    int32_t active_bytes = 0;
+    __m256d moving;
+    const __m256d hspeed = _mm256_loadu_pd(&motion->hspeed[slot]);
+    const __m256d vspeed = _mm256_loadu_pd(&motion->vspeed[slot]);
+    const __m256d x = _mm256_loadu_pd(&motion->x[slot]);
+    const __m256d y = _mm256_loadu_pd(&motion->y[slot]);
+    memcpy(&active_bytes, &motion->active[slot], sizeof(active_bytes));
+    moving = _mm256_and_pd(
+        _mm256_castsi256_pd(
+            _mm256_cmpgt_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(active_bytes)), _mm256_setzero_si256())),
+        _mm256_or_pd(_mm256_cmp_pd(hspeed, zero, _CMP_NEQ_UQ), _mm256_cmp_pd(vspeed, zero, _CMP_NEQ_UQ)));
+    _mm256_storeu_pd(&motion->x[slot], _mm256_blendv_pd(x, _mm256_add_pd(x, hspeed), moving));
+    _mm256_storeu_pd(&motion->y[slot], _mm256_blendv_pd(y, _mm256_add_pd(y, vspeed), moving));
+    mark_moved(motion, slot, _mm256_movemask_pd(moving), 4u);
+  }
+#elif defined(BS_MOTION_SSE2)
+  const __m128d zero = _mm_setzero_pd();
+  for (; slot + 2u <= slot_count; slot += 2u) {
+    const __m128d hspeed = _mm_loadu_pd(&motion->hspeed[slot]);
+    const __m128d vspeed = _mm_loadu_pd(&motion->vspeed[slot]);
+    const __m128d x = _mm_loadu_pd(&motion->x[slot]);
+    const __m128d y = _mm_loadu_pd(&motion->y[slot]);
+    const __m128d moving = _mm_and_pd(
+        _mm_castsi128_pd(_mm_set_epi64x(-(long long)motion->active[slot + 1u], -(long long)motion->active[slot])),
+        _mm_or_pd(_mm_cmpneq_pd(hspeed, zero), _mm_cmpneq_pd(vspeed, zero)));
+    _mm_storeu_pd(&motion->x[slot],
+                  _mm_or_pd(_mm_and_pd(moving, _mm_add_pd(x, hspeed)), _mm_andnot_pd(moving, x)));
+    _mm_storeu_pd(&motion->y[slot],
+                  _mm_or_pd(_mm_and_pd(moving, _mm_add_pd(y, vspeed)), _mm_andnot_pd(moving, y)));
+    mark_moved(motion, slot, _mm_movemask_pd(moving), 2u);
+  }
+#endif
+
+  for (; slot < slot_count; slot++) {
+    if (motion->active[slot] && (motion->hspeed[slot] != 0.0 || motion->vspeed[slot] != 0.0)) {
+      motion->x[slot] += motion->hspeed[slot];
+      motion->y[slot] += motion->vspeed[slot];
+      motion->bbox_state[slot] = BS_BBOX_DIRTY;
+    }
+  }
+}
+
+/* Per slot this is gravity, then friction, then position, exactly as before; slots are independent
+ * so running each step as its own pass gives the same results. */
+void bs_instance_motion_integrate(bs_instance_motion_columns *motion, size_t slot_count) {
+  apply_forces(motion, slot_count);
+  advance_positions(motion, slot_count);
+}
@@ -0,0 +1,237 @@
+#include "bs/runtime/sweep_list.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BS_SWEEP_POSITION_NONE UINT32_MAX
+
+static bool box_usable(const bs_bbox *bbox) {
+  return bbox->left <= bbox->right && bbox->top <= bbox->bottom;
+}
+
+static void note_width(bs_sweep_list *list, const bs_sweep_entry *entry) {
+  const double width = entry->right - entry->left;
+  if (width > list->max_width) {
+    list->max_width = width;
+  }
+}
+
+/* Shifts the entry at position toward its sorted place, keeping positions in step. */
+static void settle(bs_sweep_list *list, size_t position) {
+  bs_sweep_entry entry = list->entries[position];
+
+  while (position > 0 && list->entries[position - 1u].left > entry.left) {
+    list->entries[position] = list->entries[position - 1u];
+    list->positions[list->entries[position].key] = (uint32_t)position;
+    position--;
+  }
+  while (position + 1u < list->count && list->entries[position + 1u].left < entry.left) {
+    list->entries[position] = list->entries[position + 1u];
+    list->positions[list->entries[position].key] = (uint32_t)position;
+    position++;
+  }
+  list->entries[position] = entry;
+  list->positions[entry.key] = (uint32_t)position;
+}
+
+static bool reserve_keys(bs_sweep_list *list, uint32_t key) {
+  size_t capacity = list->key_capacity;
+  uint32_t *grown = NULL;
+  if ((size_t)key < capacity) {
+    return true;
+  }
+  while (capacity <= (size_t)key) {
+    capacity = (capacity == 0) ? 256u : (capacity * 2u);
+  }
+  grown = (uint32_t *)realloc(list->positions, capacity * sizeof(uint32_t));
+  if (grown == NULL) {
+    return false;
+  }
+  for (size_t i = list->key_capacity; i < capacity; i++) {
+    grown[i] = BS_SWEEP_POSITION_NONE;
+  }
+  list->positions = grown;
+  list->key_capacity = capacity;
+  return true;
+}
+
+void bs_sweep_list_init(bs_sweep_list *list) {
+  if (list == NULL) {
+    return;
+  }
+  memset(list, 0, sizeof(*list));
+}
+
+void bs_sweep_list_dispose(bs_sweep_list *list) {
+  if (list == NULL) {
+    return;
+  }
+  free(list->entries);
+  free(list->positions);
+  memset(list, 0, sizeof(*list));
+}
+
+/* Starts a refresh: every key that is not set again before bs_sweep_list_end_update is dropped. */
+void bs_sweep_list_begin_update(bs_sweep_list *list) {
+  if (list == NULL) {
+    return;
+  }
+  list->epoch++;
+}
+
+/* Inserts key or replaces its box without re-sorting; unusable (NaN) boxes leave the key out
+ * since they overlap nothing. */
+bool bs_sweep_list_set(bs_sweep_list *list, uint32_t key, const bs_bbox *bbox) {
+  bs_sweep_entry *entry = NULL;
+  if (list == NULL || bbox == NULL || key == BS_SWEEP_POSITION_NONE) {
+    return false;
+  }
+  if (!box_usable(bbox)) {
+    return true;
+  }
+  if (!reserve_keys(list, key)) {
+    return false;
+  }
+  if (list->positions[key] != BS_SWEEP_POSITION_NONE) {
+    entry = &list->entries[list->positions[key]];
+  } else {
+    if (list->count == list->capacity) {
+      size_t capacity = (list->capacity == 0) ? 64u : (list->capacity * 2u);
+      bs_sweep_entry *grown = (bs_sweep_entry *)realloc(list->entries, capacity * sizeof(bs_sweep_entry));
+      if (grown == NULL) {
+        return false;
+      }
+      list->entries = grown;
+      list->capacity = capacity;
+    }
+    list->positions[key] = (uint32_t)list->count;
+    entry = &list->entries[list->count++];
+    entry->key = key;
+  }
+  entry->left = bbox->left;
+  entry->right = bbox->right;
+  entry->top = bbox->top;
+  entry->bottom = bbox->bottom;
+  entry->epoch = list->epoch;
+  return true;
+}
+
+/* Drops keys not set since begin_update and restores left-edge order. Boxes move a little per
+ * frame, so the list is nearly sorted and insertion sort does close to one pass. */
+void bs_sweep_list_end_update(bs_sweep_list *list) {
+  size_t kept = 0;
+  if (list == NULL) {
+    return;
+  }
+
+  list->max_width = 0.0;
+  for (size_t i = 0; i < list->count; i++) {
+    const bs_sweep_entry entry = list->entries[i];
+    if (entry.epoch != list->epoch) {
+      list->positions[entry.key] = BS_SWEEP_POSITION_NONE;
+      continue;
+    }
+    list->entries[kept++] = entry;
+  }
+  list->count = kept;
+
+  for (size_t i = 1; i < list->count; i++) {
+    const bs_sweep_entry entry = list->entries[i];
+    size_t j = i;
+    while (j > 0 && list->entries[j - 1u].left > entry.left) {
+      list->entries[j] = list->entries[j - 1u];
+      j--;
+    }
+    list->entries[j] = entry;
+  }
+  for (size_t i = 0; i < list->count; i++) {
+    list->positions[list->entries[i].key] = (uint32_t)i;
+    note_width(list, &list->entries[i]);
+  }
+}
+
+/* Updates one key's box between refreshes and moves it back into order. A NULL or unusable box
+ * takes the key out. */
+void bs_sweep_list_move(bs_sweep_list *list, uint32_t key, const bs_bbox *bbox) {
+  size_t position = 0;
+  if (list == NULL || (size_t)key >= list->key_capacity || list->positions[key] == BS_SWEEP_POSITION_NONE) {
+    return;
+  }
+
+  position = list->positions[key];
+  if (bbox == NULL || !box_usable(bbox)) {
+    list->positions[key] = BS_SWEEP_POSITION_NONE;
+    memmove(&list->entries[position],
+            &list->entries[position + 1u],
+            (list->count - position - 1u) * sizeof(bs_sweep_entry));
+    list->count--;
+    for (size_t i = position; i < list->count; i++) {
+      list->positions[list->entries[i].key] = (uint32_t)i;
+    }
+    return;
+  }
+
+  list->entries[position].left = bbox->left;
+  list->entries[position].right = bbox->right;
+  list->entries[position].top = bbox->top;
+  list->entries[position].bottom = bbox->bottom;
+  note_width(list, &list->entries[position]);
+  settle(list, position);
+}
+
+/* First position whose entry could overlap bbox: entries are sorted by left edge, so only those
+ * whose left edge lies within max_width of the query need visiting. The bound is padded so
+ * rounding in right - left cannot exclude a hit. */
+size_t bs_sweep_list_first_candidate(const bs_sweep_list *list, const bs_bbox *bbox) {
+  double reach = 0.0;
+  size_t lo = 0;
+  size_t hi = 0;
+  if (list == NULL || bbox == NULL || list->count == 0 || !box_usable(bbox)) {
+    return (list != NULL) ? list->count : 0;
+  }
+
+  reach = bbox->left - (list->max_width * 2.0 + 1.0);
+  hi = list->count;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2u;
+    if (list->entries[mid].left < reach) {
+      lo = mid + 1u;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/* Advances *cursor to the next entry other than skip_key whose box overlaps bbox, using the same
+ * strict test as bs_game_runner_instances_overlap, and reports its key. Start the cursor at
+ * bs_sweep_list_first_candidate; the list must not change while it is walked. */
+bool bs_sweep_list_next_overlap(const bs_sweep_list *list,
+                                const bs_bbox *bbox,
+                                uint32_t skip_key,
+                                size_t *cursor,
+                                uint32_t *out_key) {
+  if (list == NULL || bbox == NULL || cursor == NULL || !box_usable(bbox)) {
+    return false;
+  }
+  for (; *cursor < list->count && list->entries[*cursor].left < bbox->right; (*cursor)++) {
+    const bs_sweep_entry *entry = &list->entries[*cursor];
+    if (entry->key == skip_key) {
+      continue;
+    }
+    if (bbox->left < entry->right && bbox->top < entry->bottom && bbox->bottom > entry->top) {
+      if (out_key != NULL) {
+        *out_key = entry->key;
+      }
+      (*cursor)++;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* True if any entry other than skip_key overlaps bbox. */
+bool bs_sweep_list_any_overlap(const bs_sweep_list *list, const bs_bbox *bbox, uint32_t skip_key) {
+  size_t cursor = bs_sweep_list_first_candidate(list, bbox);
+  return bs_sweep_list_next_overlap(list, bbox, skip_key, &cursor, NULL);
+}
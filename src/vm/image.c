@@ -0,0 +1,428 @@
+#include "bs/vm/image.h"
+
+#include "bs/platform/system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BS_IMAGE_VERSION 2u
+#define BS_IMAGE_BYTE_ORDER 0x01020304u
+
+static const char k_image_magic[8] = {'B', 'S', 'I', 'M', 'A', 'G', 'E', '\0'};
+
+/* On-disk layout: header, entry table, instruction array, offset array. Every *_offset field is
+ * relative to the start of the image. */
+typedef struct bs_image_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t instruction_size;
+  uint32_t reserved;
+  uint64_t source_hash;
+  uint64_t source_size;
+  uint64_t code_entry_count;
+  uint64_t entry_table_offset;
+  uint64_t instruction_table_offset;
+  uint64_t offset_table_offset;
+  uint64_t instruction_count;
+  uint64_t image_size;
+  uint32_t resolved_variables;
+  uint32_t resolved_functions;
+} bs_image_header;
+
+typedef struct bs_image_entry {
+  uint64_t first_instruction;
+  uint64_t instruction_count;
+} bs_image_entry;
+
+static uint64_t image_align8(uint64_t value) {
+  return (value + 7u) & ~(uint64_t)7u;
+}
+
+static uint64_t image_hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+static uint64_t image_hash_bytes(uint64_t h, const uint8_t *bytes, size_t size) {
+  size_t i = 0;
+  h ^= (uint64_t)size * 0x100000001b3ull;
+  for (; i + 8u <= size; i += 8u) {
+    uint64_t word = 0;
+    memcpy(&word, bytes + i, sizeof(word));
+    h ^= word * 0x87c37b91114253d5ull;
+    h = ((h << 31) | (h >> 33)) * 0x4cf5ad432745937full;
+  }
+  for (; i < size; i++) {
+    h ^= (uint64_t)bytes[i];
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+/* The chunks decoding and linking read: bytecode version, code entries, and the VARI/FUNC
+ * reference chains. */
+static bool image_source_chunk(const bs_chunk_info *chunk) {
+  return memcmp(chunk->tag, "GEN8", 4) == 0 || memcmp(chunk->tag, "CODE", 4) == 0 ||
+         memcmp(chunk->tag, "VARI", 4) == 0 || memcmp(chunk->tag, "FUNC", 4) == 0;
+}
+
+/* Word-at-a-time hash of the chunks the image was built from, plus any bytecode stored outside
+ * CODE. Textures and audio, most of a data.win, are never read, so checking an image does not page
+ * them in. */
+uint64_t bs_image_hash_source(const bs_game_data *game_data) {
+  uint64_t h = 0x9e3779b97f4a7c15ull;
+  size_t code_begin = 0;
+  size_t code_end = 0;
+
+  if (game_data == NULL || game_data->file_data == NULL) {
+    return 0;
+  }
+
+  h ^= (uint64_t)game_data->file_size * 0x100000001b3ull;
+  for (size_t c = 0; c < game_data->chunk_count; c++) {
+    const bs_chunk_info *chunk = &game_data->chunks[c];
+    if (!image_source_chunk(chunk) ||
+        (size_t)chunk->data_offset > game_data->file_size ||
+        (size_t)chunk->size > game_data->file_size - (size_t)chunk->data_offset) {
+      continue;
+    }
+    h ^= (uint64_t)chunk->data_offset * 0x87c37b91114253d5ull;
+    h = image_hash_bytes(h, game_data->file_data + chunk->data_offset, chunk->size);
+    if (memcmp(chunk->tag, "CODE", 4) == 0) {
+      code_begin = (size_t)chunk->data_offset;
+      code_end = code_begin + (size_t)chunk->size;
+    }
+  }
+  for (size_t i = 0; i < game_data->code_entry_count; i++) {
+    const bs_code_entry_data *entry = &game_data->code_entries[i];
+    const size_t begin = (size_t)entry->bytecode_absolute_offset;
+    if (entry->bytecode == NULL || (begin >= code_begin && begin + entry->bytecode_length <= code_end)) {
+      continue;
+    }
+    h = image_hash_bytes(h, entry->bytecode, entry->bytecode_length);
+  }
+  return image_hash_mix(h);
+}
+
+static bool image_write_padding(FILE *fp, uint64_t *position, uint64_t target) {
+  static const uint8_t zeros[8] = {0};
+  while (*position < target) {
+    size_t chunk = (size_t)(target - *position);
+    if (chunk > sizeof(zeros)) {
+      chunk = sizeof(zeros);
+    }
+    if (fwrite(zeros, 1, chunk, fp) != chunk) {
+      return false;
+    }
+    *position += chunk;
+  }
+  return true;
+}
+
+bool bs_image_write(const char *path,
+                    const bs_game_data *game_data,
+                    const bs_decoded_code *entries,
+                    size_t entry_count,
+                    uint32_t resolved_variables,
+                    uint32_t resolved_functions) {
+  bs_image_header header;
+  uint64_t instruction_count = 0;
+  uint64_t position = 0;
+  bool ok = true;
+  FILE *fp = NULL;
+
+  if (path == NULL || game_data == NULL || (entries == NULL && entry_count > 0)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < entry_count; i++) {
+    instruction_count += entries[i].instruction_count;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, k_image_magic, sizeof(header.magic));
+  header.version = BS_IMAGE_VERSION;
+  header.byte_order = BS_IMAGE_BYTE_ORDER;
+  header.instruction_size = (uint32_t)sizeof(bs_instruction);
+  header.source_hash = bs_image_hash_source(game_data);
+  header.source_size = game_data->file_size;
+  header.code_entry_count = entry_count;
+  header.entry_table_offset = image_align8(sizeof(header));
+  header.instruction_table_offset =
+      image_align8(header.entry_table_offset + (uint64_t)entry_count * sizeof(bs_image_entry));
+  header.offset_table_offset =
+      image_align8(header.instruction_table_offset + instruction_count * sizeof(bs_instruction));
+  header.instruction_count = instruction_count;
+  header.image_size = header.offset_table_offset + instruction_count * sizeof(uint32_t);
+  header.resolved_variables = resolved_variables;
+  header.resolved_functions = resolved_functions;
+
+  fp = fopen(path, "wb");
+  if (fp == NULL) {
+    fprintf(stderr, "Failed to open image for writing: %s\n", path);
+    return false;
+  }
+
+  ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  position = sizeof(header);
+
+  ok = ok && image_write_padding(fp, &position, header.entry_table_offset);
+  {
+    uint64_t first = 0;
+    for (size_t i = 0; ok && i < entry_count; i++) {
+      bs_image_entry entry;
+      entry.first_instruction = first;
+      entry.instruction_count = entries[i].instruction_count;
+      ok = fwrite(&entry, sizeof(entry), 1, fp) == 1;
+      position += sizeof(entry);
+      first += entries[i].instruction_count;
+    }
+  }
+
+  ok = ok && image_write_padding(fp, &position, header.instruction_table_offset);
+  for (size_t i = 0; ok && i < entry_count; i++) {
+    size_t count = entries[i].instruction_count;
+    if (count > 0) {
+      ok = fwrite(entries[i].instructions, sizeof(bs_instruction), count, fp) == count;
+      position += (uint64_t)count * sizeof(bs_instruction);
+    }
+  }
+
+  ok = ok && image_write_padding(fp, &position, header.offset_table_offset);
+  for (size_t i = 0; ok && i < entry_count; i++) {
+    size_t count = entries[i].instruction_count;
+    if (count > 0) {
+      ok = fwrite(entries[i].instruction_offsets, sizeof(uint32_t), count, fp) == count;
+      position += (uint64_t)count * sizeof(uint32_t);
+    }
+  }
+
+  if (fclose(fp) != 0) {
+    ok = false;
+  }
+  if (!ok) {
+    fprintf(stderr, "Failed to write image: %s\n", path);
+    (void)remove(path);
+  }
+  return ok;
+}
+
+static bool image_read_file(const char *path, bs_image *image) {
+  FILE *fp = fopen(path, "rb");
+  long file_len = 0;
+  uint8_t *bytes = NULL;
+
+  if (fp == NULL) {
+    return false;
+  }
+  if (fseek(fp, 0, SEEK_END) != 0 || (file_len = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0) {
+    fclose(fp);
+    return false;
+  }
+
+  bytes = (uint8_t *)malloc((size_t)file_len);
+  if (bytes == NULL || fread(bytes, 1, (size_t)file_len, fp) != (size_t)file_len) {
+    free(bytes);
+    fclose(fp);
+    return false;
+  }
+  fclose(fp);
+
+  image->bytes = bytes;
+  image->size = (size_t)file_len;
+  image->mapped = false;
+  return true;
+}
+
+static bool image_map_file(const char *path, bs_image *image) {
+  bs_file_view view;
+  if (!bs_system_map_file(path, &view)) {
+    return false;
+  }
+  image->bytes = view.bytes;
+  image->size = view.size;
+  image->mapping = view.mapping;
+  image->mapped = true;
+  return true;
+}
+
+static bool image_section_fits(const bs_image *image, uint64_t offset, uint64_t count, uint64_t elem_size) {
+  if (offset > image->size || (offset & 7u) != 0) {
+    return false;
+  }
+  return count <= ((uint64_t)image->size - offset) / elem_size;
+}
+
+/* -1 is what the decoder leaves in instructions that name no variable or function. */
+static bool image_index_in_range(int32_t index, size_t count) {
+  return index == -1 || (index >= 0 && (size_t)index < count);
+}
+
+static bool image_validate(const bs_image *image, const bs_game_data *game_data, const char *path) {
+  bs_image_header header;
+  const bs_image_entry *entries = NULL;
+  const bs_instruction *instructions = NULL;
+  uint64_t next = 0;
+
+  if (image->size < sizeof(header)) {
+    fprintf(stderr, "Image %s is truncated\n", path);
+    return false;
+  }
+  memcpy(&header, image->bytes, sizeof(header));
+  if (memcmp(header.magic, k_image_magic, sizeof(header.magic)) != 0 ||
+      header.version != BS_IMAGE_VERSION ||
+      header.byte_order != BS_IMAGE_BYTE_ORDER ||
+      header.instruction_size != sizeof(bs_instruction)) {
+    fprintf(stderr, "Image %s was built for a different format; ignoring it\n", path);
+    return false;
+  }
+  if (header.source_size != game_data->file_size ||
+      header.code_entry_count != game_data->code_entry_count ||
+      header.source_hash != bs_image_hash_source(game_data)) {
+    fprintf(stderr, "Image %s does not match %s; ignoring it\n", path, game_data->game_path);
+    return false;
+  }
+  if (header.image_size != image->size ||
+      !image_section_fits(image, header.entry_table_offset, header.code_entry_count, sizeof(bs_image_entry)) ||
+      !image_section_fits(image, header.instruction_table_offset, header.instruction_count, sizeof(bs_instruction)) ||
+      !image_section_fits(image, header.offset_table_offset, header.instruction_count, sizeof(uint32_t))) {
+    fprintf(stderr, "Image %s is corrupt\n", path);
+    return false;
+  }
+
+  entries = (const bs_image_entry *)(const void *)(image->bytes + header.entry_table_offset);
+  for (uint64_t i = 0; i < header.code_entry_count; i++) {
+    if (entries[i].first_instruction != next ||
+        entries[i].instruction_count > header.instruction_count - next) {
+      fprintf(stderr, "Image %s is corrupt\n", path);
+      return false;
+    }
+    next += entries[i].instruction_count;
+  }
+
+  /* The VM indexes the VARI and FUNC tables with these directly, so an image that points past
+   * them is rejected here rather than trusted at dispatch time. */
+  instructions = (const bs_instruction *)(const void *)(image->bytes + header.instruction_table_offset);
+  for (uint64_t i = 0; i < header.instruction_count; i++) {
+    if (!image_index_in_range(instructions[i].variable_index, game_data->variable_count) ||
+        !image_index_in_range(instructions[i].function_index, game_data->function_count)) {
+      fprintf(stderr, "Image %s is corrupt\n", path);
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Opens path and checks it against the loaded data.win. A missing file is not an error; a stale or
+ * foreign image is reported and rejected so the caller falls back to decoding. */
+bool bs_image_open(const char *path, const bs_game_data *game_data, bs_image *out_image) {
+  bs_image_header header;
+
+  if (path == NULL || game_data == NULL || out_image == NULL) {
+    return false;
+  }
+  memset(out_image, 0, sizeof(*out_image));
+
+  if (!image_map_file(path, out_image) && !image_read_file(path, out_image)) {
+    return false;
+  }
+  if (!image_validate(out_image, game_data, path)) {
+    bs_image_close(out_image);
+    return false;
+  }
+
+  memcpy(&header, out_image->bytes, sizeof(header));
+  out_image->source_hash = header.source_hash;
+  out_image->code_entry_count = (size_t)header.code_entry_count;
+  out_image->resolved_variables = header.resolved_variables;
+  out_image->resolved_functions = header.resolved_functions;
+  return true;
+}
+
+/* Fills out_code with views into the image. The VM only reads decoded code, so the read-only
+ * mapping is never written through these pointers. */
+bool bs_image_code_entry(const bs_image *image, size_t index, bs_decoded_code *out_code) {
+  bs_image_header header;
+  const bs_image_entry *entry = NULL;
+
+  if (image == NULL || image->bytes == NULL || out_code == NULL || index >= image->code_entry_count) {
+    return false;
+  }
+
+  memcpy(&header, image->bytes, sizeof(header));
+  entry = (const bs_image_entry *)(const void *)(image->bytes + header.entry_table_offset) + index;
+  out_code->instruction_count = (size_t)entry->instruction_count;
+  if (entry->instruction_count == 0) {
+    out_code->instructions = NULL;
+    out_code->instruction_offsets = NULL;
+    return true;
+  }
+  out_code->instructions =
+      (bs_instruction *)(void *)(uintptr_t)(image->bytes + header.instruction_table_offset) +
+      entry->first_instruction;
+  out_code->instruction_offsets =
+      (uint32_t *)(void *)(uintptr_t)(image->bytes + header.offset_table_offset) + entry->first_instruction;
+  return true;
+}
+
+void bs_image_close(bs_image *image) {
+  if (image == NULL) {
+    return;
+  }
+  if (image->bytes != NULL && image->mapped) {
+    bs_file_view view;
+    view.bytes = image->bytes;
+    view.size = image->size;
+    view.mapping = image->mapping;
+    bs_system_unmap_file(&view);
+  } else if (image->bytes != NULL) {
+    free((void *)(uintptr_t)image->bytes);
+  }
+  memset(image, 0, sizeof(*image));
+}
+
+static bool image_disabled_by_env(void) {
+  const char *env = getenv("BS_DISABLE_IMAGE");
+  return env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0);
+}
+
+/* BS_IMAGE overrides the image location; otherwise it sits next to the game as <game>.bsimg. */
+bool bs_image_default_path(const char *game_path, char *out_path, size_t out_size) {
+  const char *env = getenv("BS_IMAGE");
+  int written = 0;
+
+  if (out_path == NULL || out_size == 0) {
+    return false;
+  }
+  if (env != NULL && env[0] != '\0') {
+    written = snprintf(out_path, out_size, "%s", env);
+  } else if (game_path != NULL) {
+    written = snprintf(out_path, out_size, "%s.bsimg", game_path);
+  } else {
+    return false;
+  }
+  return written > 0 && (size_t)written < out_size;
+}
+
+bool bs_image_open_for_game(const bs_game_data *game_data, bs_image *out_image) {
+  char path[4096];
+
+  if (game_data == NULL || out_image == NULL) {
+    return false;
+  }
+  memset(out_image, 0, sizeof(*out_image));
+  if (image_disabled_by_env() || !bs_image_default_path(game_data->game_path, path, sizeof(path))) {
+    return false;
+  }
+  if (!bs_image_open(path, game_data, out_image)) {
+    return false;
+  }
+  printf("IMAGE: %s (%zu bytes, %s)\n", path, out_image->size, out_image->mapped ? "mapped" : "read");
+  return true;
+}
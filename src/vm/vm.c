@@ -1,6 +1,13 @@
+#if defined(BS_HAVE_PTHREADS)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "bs/vm/vm.h"
 
+#include "bs/platform/system.h"
 #include "bs/runtime/game_runner.h"
+#include "bs/vm/image.h"
+#include "vm/vm_internal.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -8,7 +15,17 @@
 #include <string.h>
 #include <time.h>
 
+#if defined(BS_HAVE_PTHREADS)
+#include <pthread.h>
+#endif
+
 #define BS_VM_MAX_CALL_DEPTH 32u
+#define BS_VM_SPECIALIZE_HOT_COUNT 32u
+#define BS_VM_SPECIALIZE_MAX_THRESHOLD 4096u
+#define BS_VM_SPECIALIZE_WARMUP 4096u
+#define BS_VM_OPCODE_NOP 0x00u
+#define BS_VM_DECODE_BATCH 64u
+#define BS_VM_MAX_INIT_THREADS 64u
 
 typedef struct bs_vm_stack {
   bs_vm_value *items;
@@ -35,9 +52,7 @@ typedef struct bs_vm_locals {
 } bs_vm_locals;
 
 typedef struct bs_vm_env_iteration {
-  int32_t *instance_ids;
-  size_t instance_count;
-  size_t current_index;
+  bs_instance_iterator instances;
   int32_t prev_self_id;
   int32_t prev_other_id;
 } bs_vm_env_iteration;
@@ -326,14 +341,6 @@ static void bs_vm_env_stack_dispose(bs_vm_env_stack *stack) {
   if (stack == NULL) {
     return;
   }
-  if (stack->items != NULL) {
-    for (size_t i = 0; i < stack->count; i++) {
-      free(stack->items[i].instance_ids);
-      stack->items[i].instance_ids = NULL;
-      stack->items[i].instance_count = 0;
-      stack->items[i].current_index = 0;
-    }
-  }
   free(stack->items);
   stack->items = NULL;
   stack->count = 0;
@@ -371,10 +378,6 @@ static void bs_vm_env_stack_pop(bs_vm_env_stack *stack) {
     return;
   }
   stack->count--;
-  free(stack->items[stack->count].instance_ids);
-  stack->items[stack->count].instance_ids = NULL;
-  stack->items[stack->count].instance_count = 0;
-  stack->items[stack->count].current_index = 0;
 }
 
 static bool bs_vm_locals_set(bs_vm *vm, bs_vm_locals *locals, int32_t variable_index, bs_vm_value value) {
@@ -828,16 +831,11 @@ static int32_t bs_vm_resolve_single_instance_target(bs_vm *vm, int32_t instance_
     return instance_target;
   }
   if (instance_target >= 0) {
-    for (size_t i = 0; i < vm->runner->instance_count; i++) {
-      const bs_instance *inst = &vm->runner->instances[i];
-      if (inst->destroyed) {
-        continue;
-      }
-      if (bs_game_runner_object_is_child_of(vm->runner, inst->object_index, instance_target)) {
-        return inst->id;
-      }
-    }
-    return -4;
+    bs_instance_iterator instances;
+    const bs_instance *first = NULL;
+    bs_game_runner_iterate_instances(vm->runner, instance_target, &instances);
+    first = bs_game_runner_iterator_next(vm->runner, &instances);
+    return (first != NULL) ? first->id : -4;
   }
 
   return vm->current_self_id;
@@ -884,7 +882,7 @@ static bool bs_vm_try_get_known_global_builtin(const bs_vm *vm,
     return true;
   }
   if (strcmp(name, "instance_count") == 0) {
-    *out_value = (double)vm->runner->instance_count;
+    *out_value = (double)vm->runner->instance_pool.count;
     return true;
   }
   if (strcmp(name, "keyboard_key") == 0) {
@@ -1442,14 +1440,11 @@ static bool bs_vm_instance_set_for_target(bs_vm *vm,
   }
 
   if (target_instance >= 0 && target_instance < 100000) {
-    for (size_t i = 0; i < vm->runner->instance_count; i++) {
-      bs_instance *inst = &vm->runner->instances[i];
-      if (inst->destroyed) {
-        continue;
-      }
-      if (bs_game_runner_object_is_child_of(vm->runner, inst->object_index, target_instance)) {
-        ok = bs_vm_instance_set_for_id(vm, variable_index, inst->id, value) && ok;
-      }
+    bs_instance_iterator instances;
+    bs_game_runner_iterate_instances(vm->runner, target_instance, &instances);
+    for (const bs_instance *inst = bs_game_runner_iterator_next(vm->runner, &instances); inst != NULL;
+         inst = bs_game_runner_iterator_next(vm->runner, &instances)) {
+      ok = bs_vm_instance_set_for_id(vm, variable_index, inst->id, value) && ok;
     }
     return ok;
   }
@@ -1481,14 +1476,11 @@ static bool bs_vm_instance_set_array_for_target(bs_vm *vm,
     }
 
     if (target_instance >= 0 && target_instance < 100000) {
-      for (size_t i = 0; i < vm->runner->instance_count; i++) {
-        bs_instance *inst = &vm->runner->instances[i];
-        if (inst->destroyed) {
-          continue;
-        }
-        if (bs_game_runner_object_is_child_of(vm->runner, inst->object_index, target_instance)) {
-          inst->alarm[index] = (int32_t)bs_vm_value_to_number(value);
-        }
+      bs_instance_iterator instances;
+      bs_game_runner_iterate_instances(vm->runner, target_instance, &instances);
+      for (bs_instance *inst = bs_game_runner_iterator_next(vm->runner, &instances); inst != NULL;
+           inst = bs_game_runner_iterator_next(vm->runner, &instances)) {
+        inst->alarm[index] = (int32_t)bs_vm_value_to_number(value);
       }
       return true;
     }
@@ -1503,14 +1495,11 @@ static bool bs_vm_instance_set_array_for_target(bs_vm *vm,
   }
 
   if (target_instance >= 0 && target_instance < 100000) {
-    for (size_t i = 0; i < vm->runner->instance_count; i++) {
-      bs_instance *inst = &vm->runner->instances[i];
-      if (inst->destroyed) {
-        continue;
-      }
-      if (bs_game_runner_object_is_child_of(vm->runner, inst->object_index, target_instance)) {
-        ok = bs_vm_instance_dynamic_array_set(vm, variable_index, index, inst->id, value) && ok;
-      }
+    bs_instance_iterator instances;
+    bs_game_runner_iterate_instances(vm->runner, target_instance, &instances);
+    for (const bs_instance *inst = bs_game_runner_iterator_next(vm->runner, &instances); inst != NULL;
+         inst = bs_game_runner_iterator_next(vm->runner, &instances)) {
+      ok = bs_vm_instance_dynamic_array_set(vm, variable_index, index, inst->id, value) && ok;
     }
     return ok;
   }
@@ -1554,6 +1543,7 @@ static bool bs_vm_global_set(bs_vm *vm, int32_t variable_index, bs_vm_value valu
   if (!bs_vm_make_storable_value(vm, value, &stored_value)) {
     return false;
   }
+  bs_vm_note_global_write(vm, variable_index);
 
   for (size_t i = 0; i < vm->global_variable_count; i++) {
     if (vm->global_variable_indices[i] == variable_index) {
@@ -1652,6 +1642,7 @@ static bool bs_vm_global_array_set(bs_vm *vm,
   if (!bs_vm_make_storable_value(vm, value, &stored_value)) {
     return false;
   }
+  bs_vm_note_global_write(vm, variable_index);
 
   for (size_t i = 0; i < vm->global_array_count; i++) {
     if (vm->global_array_variable_indices[i] == variable_index &&
@@ -1730,6 +1721,7 @@ static void bs_vm_global_array_clear_variable(bs_vm *vm, int32_t variable_index)
   if (vm == NULL || variable_index < 0) {
     return;
   }
+  bs_vm_note_global_write(vm, variable_index);
   for (size_t i = 0; i < vm->global_array_count; i++) {
     if (vm->global_array_variable_indices[i] == variable_index) {
       continue;
@@ -2053,95 +2045,6 @@ static bool bs_vm_find_branch_target(const bs_decoded_code *decoded,
   return true;
 }
 
-static bool bs_vm_collect_target_instance_ids(bs_vm *vm,
-                                              int32_t target_id,
-                                              int32_t **out_ids,
-                                              size_t *out_count) {
-  size_t count = 0;
-  int32_t *ids = NULL;
-  if (out_ids == NULL || out_count == NULL) {
-    return false;
-  }
-  *out_ids = NULL;
-  *out_count = 0;
-
-  if (vm == NULL || vm->runner == NULL || vm->runner->game_data == NULL) {
-    return true;
-  }
-
-  if (target_id >= 100000) {
-    bs_instance *inst = bs_game_runner_find_instance_by_id(vm->runner, target_id);
-    if (inst != NULL && !inst->destroyed) {
-      ids = (int32_t *)malloc(sizeof(int32_t));
-      if (ids == NULL) {
-        return false;
-      }
-      ids[0] = inst->id;
-      count = 1;
-    }
-  } else {
-    for (size_t i = 0; i < vm->runner->instance_count; i++) {
-      const bs_instance *inst = &vm->runner->instances[i];
-      if (inst->destroyed) {
-        continue;
-      }
-      if (!bs_game_runner_object_is_child_of(vm->runner, inst->object_index, target_id)) {
-        continue;
-      }
-      count++;
-    }
-
-    if (count > 0) {
-      size_t write = 0;
-      ids = (int32_t *)malloc(count * sizeof(int32_t));
-      if (ids == NULL) {
-        return false;
-      }
-      for (size_t i = 0; i < vm->runner->instance_count; i++) {
-        const bs_instance *inst = &vm->runner->instances[i];
-        if (inst->destroyed) {
-          continue;
-        }
-        if (!bs_game_runner_object_is_child_of(vm->runner, inst->object_index, target_id)) {
-          continue;
-        }
-        ids[write] = inst->id;
-        write++;
-      }
-    }
-  }
-
-  *out_ids = ids;
-  *out_count = count;
-  return true;
-}
-
-static bool bs_vm_find_next_alive_instance_id(bs_vm *vm,
-                                              const int32_t *instance_ids,
-                                              size_t instance_count,
-                                              size_t start_index,
-                                              size_t *out_index,
-                                              int32_t *out_instance_id) {
-  if (vm == NULL ||
-      vm->runner == NULL ||
-      instance_ids == NULL ||
-      out_index == NULL ||
-      out_instance_id == NULL) {
-    return false;
-  }
-
-  for (size_t i = start_index; i < instance_count; i++) {
-    bs_instance *inst = bs_game_runner_find_instance_by_id(vm->runner, instance_ids[i]);
-    if (inst != NULL && !inst->destroyed) {
-      *out_index = i;
-      *out_instance_id = inst->id;
-      return true;
-    }
-  }
-
-  return false;
-}
-
 static bool bs_vm_push_binary_numeric(bs_vm_stack *stack, double value) {
   return bs_vm_stack_push(stack, bs_vm_value_number(value));
 }
@@ -2629,116 +2532,837 @@ static const bs_code_range *bs_find_code_range(const bs_vm *vm, uint32_t absolut
   return NULL;
 }
 
-static uint32_t bs_resolve_variable_chains(bs_vm *vm) {
+static bool bs_code_patch_list_push(bs_code_patch_list *list, bs_code_patch patch) {
+  if (list == NULL) {
+    return false;
+  }
+
+  if (list->count == list->capacity) {
+    size_t new_capacity = (list->capacity == 0) ? 16u : (list->capacity * 2u);
+    bs_code_patch *grown = (bs_code_patch *)realloc(list->patches, new_capacity * sizeof(bs_code_patch));
+    if (grown == NULL) {
+      return false;
+    }
+    list->patches = grown;
+    list->capacity = new_capacity;
+  }
+
+  list->patches[list->count++] = patch;
+  return true;
+}
+
+static bool bs_code_reference_opcode_matches(uint8_t opcode, bool is_function) {
+  if (is_function) {
+    return opcode == BS_OPCODE_CALL || opcode == BS_OPCODE_PUSH;
+  }
+  return opcode == BS_OPCODE_PUSH ||
+         opcode == BS_OPCODE_PUSHLOC ||
+         opcode == BS_OPCODE_PUSHGLB ||
+         opcode == BS_OPCODE_PUSHBLTN ||
+         opcode == BS_OPCODE_POP;
+}
+
+/* Walks one VARI/FUNC occurrence chain through the raw bytecode. Already-decoded entries are
+ * patched in place; otherwise a patch is recorded so the entry can be resolved once decoded. */
+static uint32_t bs_resolve_reference_chain(bs_vm *vm,
+                                           bs_decoded_code *decoded_entries,
+                                           int32_t first_occurrence_offset,
+                                           int32_t occ_count,
+                                           int32_t target_index,
+                                           bool is_function) {
   uint32_t resolved = 0;
-  if (vm == NULL || vm->game_data == NULL) {
+  uint32_t instr_addr = 0;
+
+  if (occ_count <= 0 || first_occurrence_offset < 0) {
     return 0;
   }
 
-  for (size_t var_idx = 0; var_idx < vm->game_data->variable_count; var_idx++) {
-    const bs_variable_data *variable = &vm->game_data->variables[var_idx];
-    int32_t occ_count = variable->occurrence_count;
-    uint32_t instr_addr = 0;
+  instr_addr = (uint32_t)first_occurrence_offset;
+  for (int32_t occ_i = 0; occ_i < occ_count; occ_i++) {
+    const bs_code_range *range = bs_find_code_range(vm, instr_addr);
+    const bs_code_entry_data *entry = NULL;
+    uint32_t local_offset = 0;
 
-    if (occ_count <= 0 || variable->first_occurrence_offset < 0) {
-      continue;
+    if (range == NULL) {
+      break;
     }
 
-    instr_addr = (uint32_t)variable->first_occurrence_offset;
-    for (int32_t occ_i = 0; occ_i < occ_count; occ_i++) {
-      const bs_code_range *range = bs_find_code_range(vm, instr_addr);
-      uint32_t local_offset = 0;
-      const bs_decoded_code *decoded = NULL;
-      int32_t instr_index = -1;
+    entry = &vm->game_data->code_entries[range->code_entry_index];
+    local_offset = instr_addr - range->start;
+    if (!bs_can_read(entry->bytecode_length, local_offset, 4) ||
+        !bs_code_reference_opcode_matches(entry->bytecode[local_offset + 3u], is_function)) {
+      break;
+    }
 
-      if (range == NULL) {
+    if (decoded_entries != NULL) {
+      bs_decoded_code *decoded = &decoded_entries[range->code_entry_index];
+      int32_t instr_index = bs_decoded_lookup_instruction_index(decoded, local_offset);
+      if (instr_index >= 0) {
+        if (is_function) {
+          decoded->instructions[(size_t)instr_index].function_index = target_index;
+        } else {
+          decoded->instructions[(size_t)instr_index].variable_index = target_index;
+        }
+      }
+    } else {
+      bs_code_patch patch = {0};
+      patch.local_offset = local_offset;
+      patch.target_index = target_index;
+      patch.is_function = is_function;
+      if (!bs_code_patch_list_push(&vm->entry_patches[range->code_entry_index], patch)) {
         break;
       }
+    }
+    resolved++;
+
+    if (occ_i < occ_count - 1) {
+      int32_t raw = 0;
+      uint32_t ref_offset = local_offset + 4u;
+      uint32_t next_offset = 0;
 
-      local_offset = instr_addr - range->start;
-      decoded = &vm->decoded_entries[range->code_entry_index];
-      instr_index = bs_decoded_lookup_instruction_index(decoded, local_offset);
-      if (instr_index < 0) {
+      if (!bs_read_i32_le_bytes(entry->bytecode, entry->bytecode_length, ref_offset, &raw)) {
         break;
       }
 
-      vm->decoded_entries[range->code_entry_index].instructions[(size_t)instr_index].variable_index =
-          (int32_t)var_idx;
-      resolved++;
+      next_offset = ((uint32_t)raw) & 0x07FFFFFFu;
+      instr_addr += next_offset;
+    }
+  }
 
-      if (occ_i < occ_count - 1) {
-        const bs_code_entry_data *entry = &vm->game_data->code_entries[range->code_entry_index];
-        int32_t raw = 0;
-        uint32_t ref_offset = local_offset + 4u;
-        uint32_t next_offset = 0;
+  return resolved;
+}
 
-        if (!bs_read_i32_le_bytes(entry->bytecode, entry->bytecode_length, ref_offset, &raw)) {
-          break;
-        }
+/* Variables and functions are split round-robin across threads; each occurrence belongs to a
+ * single chain, so no two threads touch the same instruction field. */
+static uint32_t bs_resolve_variable_chains(bs_vm *vm,
+                                           bs_decoded_code *decoded_entries,
+                                           size_t thread_index,
+                                           size_t thread_count) {
+  uint32_t resolved = 0;
+  if (vm == NULL || vm->game_data == NULL || vm->entry_patches == NULL || thread_count == 0) {
+    return 0;
+  }
 
-        next_offset = ((uint32_t)raw) & 0x07FFFFFFu;
-        instr_addr += next_offset;
-      }
-    }
+  for (size_t var_idx = thread_index; var_idx < vm->game_data->variable_count; var_idx += thread_count) {
+    const bs_variable_data *variable = &vm->game_data->variables[var_idx];
+    resolved += bs_resolve_reference_chain(vm,
+                                           decoded_entries,
+                                           variable->first_occurrence_offset,
+                                           variable->occurrence_count,
+                                           (int32_t)var_idx,
+                                           false);
   }
 
   return resolved;
 }
 
-static uint32_t bs_resolve_function_chains(bs_vm *vm) {
+static uint32_t bs_resolve_function_chains(bs_vm *vm,
+                                           bs_decoded_code *decoded_entries,
+                                           size_t thread_index,
+                                           size_t thread_count) {
   uint32_t resolved = 0;
-  if (vm == NULL || vm->game_data == NULL) {
+  if (vm == NULL || vm->game_data == NULL || vm->entry_patches == NULL || thread_count == 0) {
     return 0;
   }
 
-  for (size_t func_idx = 0; func_idx < vm->game_data->function_count; func_idx++) {
+  for (size_t func_idx = thread_index; func_idx < vm->game_data->function_count; func_idx += thread_count) {
     const bs_function_data *function = &vm->game_data->functions[func_idx];
-    int32_t occ_count = function->occurrence_count;
-    uint32_t instr_addr = 0;
+    resolved += bs_resolve_reference_chain(vm,
+                                           decoded_entries,
+                                           function->first_occurrence_offset,
+                                           function->occurrence_count,
+                                           (int32_t)func_idx,
+                                           true);
+  }
+
+  return resolved;
+}
 
-    if (occ_count <= 0 || function->first_occurrence_offset < 0) {
+static void bs_apply_code_patches(bs_decoded_code *decoded, const bs_code_patch_list *list) {
+  for (size_t i = 0; i < list->count; i++) {
+    const bs_code_patch *patch = &list->patches[i];
+    int32_t instr_index = bs_decoded_lookup_instruction_index(decoded, patch->local_offset);
+    if (instr_index < 0) {
       continue;
     }
+    if (patch->is_function) {
+      decoded->instructions[(size_t)instr_index].function_index = patch->target_index;
+    } else {
+      decoded->instructions[(size_t)instr_index].variable_index = patch->target_index;
+    }
+  }
+}
 
-    instr_addr = (uint32_t)function->first_occurrence_offset;
-    for (int32_t occ_i = 0; occ_i < occ_count; occ_i++) {
-      const bs_code_range *range = bs_find_code_range(vm, instr_addr);
-      uint32_t local_offset = 0;
-      const bs_decoded_code *decoded = NULL;
-      int32_t instr_index = -1;
+static void bs_vm_mark_decoded(bs_vm *vm, size_t code_entry_index) {
+  vm->decoded_entry_ready[code_entry_index] = true;
+  vm->decoded_ready_count++;
+  vm->decoded_resident_bytes +=
+      vm->decoded_entries[code_entry_index].instruction_count * (sizeof(bs_instruction) + sizeof(uint32_t));
+}
 
-      if (range == NULL) {
-        break;
+static bool bs_vm_ensure_decoded(bs_vm *vm, size_t code_entry_index) {
+  bs_decoded_code *decoded = NULL;
+  bs_code_patch_list *patches = NULL;
+
+  if (vm->decoded_entry_ready[code_entry_index]) {
+    return true;
+  }
+
+  decoded = &vm->decoded_entries[code_entry_index];
+  if (!bs_decode_bytecode(&vm->game_data->code_entries[code_entry_index], decoded)) {
+    fprintf(stderr, "Failed to decode bytecode for CODE[%zu] '%s'\n",
+            code_entry_index,
+            vm->game_data->code_entries[code_entry_index].name != NULL
+                ? vm->game_data->code_entries[code_entry_index].name
+                : "<unnamed>");
+    return false;
+  }
+
+  patches = &vm->entry_patches[code_entry_index];
+  bs_apply_code_patches(decoded, patches);
+  free(patches->patches);
+  patches->patches = NULL;
+  patches->count = 0;
+  patches->capacity = 0;
+
+  bs_vm_mark_decoded(vm, code_entry_index);
+  return true;
+}
+
+static bool bs_vm_eager_decode_requested(void) {
+  const char *env = getenv("BS_EAGER_DECODE");
+  return env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0);
+}
+
+typedef struct bs_vm_init_worker {
+  bs_vm *vm;
+  bs_decoded_code *decoded_entries;
+  size_t thread_index;
+  size_t thread_count;
+  size_t failed_entry_index;
+  uint32_t resolved_variables;
+  uint32_t resolved_functions;
+  size_t batch_count;
+  double max_batch_millis;
+  size_t decoded_bytes;
+  bool ok;
+} bs_vm_init_worker;
+
+static void bs_vm_init_worker_decode(bs_vm_init_worker *worker) {
+  const bs_game_data *game_data = worker->vm->game_data;
+  size_t stride = worker->thread_count * BS_VM_DECODE_BATCH;
+
+  worker->ok = true;
+  for (size_t batch = worker->thread_index * BS_VM_DECODE_BATCH;
+       batch < game_data->code_entry_count;
+       batch += stride) {
+    size_t end = batch + BS_VM_DECODE_BATCH;
+    double batch_start_millis = bs_vm_now_millis();
+    double batch_millis = 0.0;
+    if (end > game_data->code_entry_count) {
+      end = game_data->code_entry_count;
+    }
+    for (size_t i = batch; i < end; i++) {
+      if (!bs_decode_bytecode(&game_data->code_entries[i], &worker->decoded_entries[i])) {
+        worker->failed_entry_index = i;
+        worker->ok = false;
+        return;
       }
+      worker->decoded_bytes +=
+          worker->decoded_entries[i].instruction_count * (sizeof(bs_instruction) + sizeof(uint32_t));
+    }
+    batch_millis = bs_vm_now_millis() - batch_start_millis;
+    if (batch_millis > worker->max_batch_millis) {
+      worker->max_batch_millis = batch_millis;
+    }
+    worker->batch_count++;
+  }
+}
 
-      local_offset = instr_addr - range->start;
-      decoded = &vm->decoded_entries[range->code_entry_index];
-      instr_index = bs_decoded_lookup_instruction_index(decoded, local_offset);
-      if (instr_index < 0) {
-        break;
+static void bs_vm_init_worker_resolve(bs_vm_init_worker *worker) {
+  worker->resolved_variables =
+      bs_resolve_variable_chains(worker->vm, worker->decoded_entries, worker->thread_index, worker->thread_count);
+  worker->resolved_functions =
+      bs_resolve_function_chains(worker->vm, worker->decoded_entries, worker->thread_index, worker->thread_count);
+}
+
+#if defined(BS_HAVE_PTHREADS)
+/* Holds the launched workers between decode and resolve, so one set of threads runs both phases.
+ * Each thread checks in after decoding and waits for the main thread to release it, with or
+ * without the resolve phase. */
+typedef struct bs_vm_init_gate {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  size_t decoded;
+  bool released;
+  bool resolve;
+} bs_vm_init_gate;
+
+typedef struct bs_vm_init_thread_arg {
+  bs_vm_init_worker *worker;
+  bs_vm_init_gate *gate;
+} bs_vm_init_thread_arg;
+
+static void *bs_vm_init_thread(void *arg) {
+  const bs_vm_init_thread_arg *self = (const bs_vm_init_thread_arg *)arg;
+  bs_vm_init_gate *gate = self->gate;
+  bool resolve = false;
+
+  bs_vm_init_worker_decode(self->worker);
+  pthread_mutex_lock(&gate->lock);
+  gate->decoded++;
+  pthread_cond_broadcast(&gate->changed);
+  while (!gate->released) {
+    pthread_cond_wait(&gate->changed, &gate->lock);
+  }
+  resolve = gate->resolve;
+  pthread_mutex_unlock(&gate->lock);
+  if (resolve) {
+    bs_vm_init_worker_resolve(self->worker);
+  }
+  return NULL;
+}
+#endif
+
+/* The workers of one eager decode. Workers that got no thread (index 0, a failed launch, or a
+ * build without pthreads) run inline on the caller. */
+typedef struct bs_vm_init_team {
+  bs_vm_init_worker *workers;
+  size_t thread_count;
+#if defined(BS_HAVE_PTHREADS)
+  bs_vm_init_gate gate;
+  bs_vm_init_thread_arg args[BS_VM_MAX_INIT_THREADS];
+  pthread_t threads[BS_VM_MAX_INIT_THREADS];
+  bool launched[BS_VM_MAX_INIT_THREADS];
+  size_t launched_count;
+  bool gate_ready;
+#endif
+} bs_vm_init_team;
+
+/* Starts the team and returns once every worker has finished decoding. */
+static void bs_vm_init_team_decode(bs_vm_init_team *team) {
+#if defined(BS_HAVE_PTHREADS)
+  bs_vm_init_gate *gate = &team->gate;
+
+  team->launched_count = 0;
+  memset(team->launched, 0, sizeof(team->launched));
+  gate->decoded = 0;
+  gate->released = false;
+  gate->resolve = false;
+  team->gate_ready = false;
+  if (team->thread_count > 1 && pthread_mutex_init(&gate->lock, NULL) == 0) {
+    team->gate_ready = pthread_cond_init(&gate->changed, NULL) == 0;
+    if (!team->gate_ready) {
+      pthread_mutex_destroy(&gate->lock);
+    }
+  }
+  for (size_t t = 1; t < team->thread_count && team->gate_ready; t++) {
+    team->args[t].worker = &team->workers[t];
+    team->args[t].gate = gate;
+    team->launched[t] = pthread_create(&team->threads[t], NULL, bs_vm_init_thread, &team->args[t]) == 0;
+    team->launched_count += team->launched[t] ? 1u : 0u;
+  }
+  for (size_t t = 0; t < team->thread_count; t++) {
+    if (!team->launched[t]) {
+      bs_vm_init_worker_decode(&team->workers[t]);
+    }
+  }
+  if (team->gate_ready) {
+    pthread_mutex_lock(&gate->lock);
+    while (gate->decoded < team->launched_count) {
+      pthread_cond_wait(&gate->changed, &gate->lock);
+    }
+    pthread_mutex_unlock(&gate->lock);
+  }
+#else
+  for (size_t t = 0; t < team->thread_count; t++) {
+    bs_vm_init_worker_decode(&team->workers[t]);
+  }
+#endif
+}
+
+/* Runs the resolve phase on the same workers when resolve is set, then stops the team. */
+static void bs_vm_init_team_finish(bs_vm_init_team *team, bool resolve) {
+#if defined(BS_HAVE_PTHREADS)
+  bs_vm_init_gate *gate = &team->gate;
+
+  if (team->gate_ready) {
+    pthread_mutex_lock(&gate->lock);
+    gate->released = true;
+    gate->resolve = resolve;
+    pthread_cond_broadcast(&gate->changed);
+    pthread_mutex_unlock(&gate->lock);
+  }
+  for (size_t t = 0; t < team->thread_count && resolve; t++) {
+    if (!team->launched[t]) {
+      bs_vm_init_worker_resolve(&team->workers[t]);
+    }
+  }
+  for (size_t t = 1; t < team->thread_count; t++) {
+    if (team->launched[t]) {
+      pthread_join(team->threads[t], NULL);
+    }
+  }
+  if (team->gate_ready) {
+    pthread_cond_destroy(&gate->changed);
+    pthread_mutex_destroy(&gate->lock);
+  }
+#else
+  for (size_t t = 0; t < team->thread_count && resolve; t++) {
+    bs_vm_init_worker_resolve(&team->workers[t]);
+  }
+#endif
+}
+
+/* Eagerly decodes every entry into decoded_entries and resolves all chains in place. The output
+ * does not depend on thread_count. Phase timings go to stats when it is set. */
+static bool bs_vm_decode_all_entries(bs_vm *vm,
+                                     bs_decoded_code *decoded_entries,
+                                     size_t thread_count,
+                                     uint32_t *out_resolved_variables,
+                                     uint32_t *out_resolved_functions,
+                                     bs_load_stats *stats) {
+  bs_vm_init_worker workers[BS_VM_MAX_INIT_THREADS];
+  bs_vm_init_team team;
+  uint32_t resolved_variables = 0;
+  uint32_t resolved_functions = 0;
+  double phase_start_millis = 0.0;
+  bs_load_phase *phase = NULL;
+
+  if (thread_count == 0) {
+    thread_count = 1;
+  }
+  if (thread_count > BS_VM_MAX_INIT_THREADS) {
+    thread_count = BS_VM_MAX_INIT_THREADS;
+  }
+
+  for (size_t t = 0; t < thread_count; t++) {
+    workers[t].vm = vm;
+    workers[t].decoded_entries = decoded_entries;
+    workers[t].thread_index = t;
+    workers[t].thread_count = thread_count;
+    workers[t].failed_entry_index = 0;
+    workers[t].resolved_variables = 0;
+    workers[t].resolved_functions = 0;
+    workers[t].batch_count = 0;
+    workers[t].max_batch_millis = 0.0;
+    workers[t].decoded_bytes = 0;
+    workers[t].ok = false;
+  }
+
+  team.workers = workers;
+  team.thread_count = thread_count;
+
+  phase_start_millis = bs_vm_now_millis();
+  bs_vm_init_team_decode(&team);
+  for (size_t t = 0; t < thread_count; t++) {
+    if (!workers[t].ok) {
+      size_t i = workers[t].failed_entry_index;
+      bs_vm_init_team_finish(&team, false);
+      fprintf(stderr, "Failed to decode bytecode for CODE[%zu] '%s'\n",
+              i,
+              vm->game_data->code_entries[i].name != NULL ? vm->game_data->code_entries[i].name : "<unnamed>");
+      return false;
+    }
+  }
+  phase = bs_load_stats_add(stats, "vm", "decode", bs_vm_now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->max_millis = 0.0;
+    for (size_t t = 0; t < thread_count; t++) {
+      phase->items += workers[t].batch_count;
+      phase->bytes += workers[t].decoded_bytes;
+      if (workers[t].max_batch_millis > phase->max_millis) {
+        phase->max_millis = workers[t].max_batch_millis;
       }
+    }
+    for (size_t i = 0; i < vm->game_data->code_entry_count; i++) {
+      phase->allocations += decoded_entries[i].instruction_count > 0 ? 2u : 0u;
+    }
+  }
 
-      vm->decoded_entries[range->code_entry_index].instructions[(size_t)instr_index].function_index =
-          (int32_t)func_idx;
-      resolved++;
+  phase_start_millis = bs_vm_now_millis();
+  bs_vm_init_team_finish(&team, true);
+  for (size_t t = 0; t < thread_count; t++) {
+    resolved_variables += workers[t].resolved_variables;
+    resolved_functions += workers[t].resolved_functions;
+  }
+  phase = bs_load_stats_add(stats, "vm", "resolve_chains", bs_vm_now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->items = (size_t)resolved_variables + (size_t)resolved_functions;
+  }
 
-      if (occ_i < occ_count - 1) {
-        const bs_code_entry_data *entry = &vm->game_data->code_entries[range->code_entry_index];
-        int32_t raw = 0;
-        uint32_t ref_offset = local_offset + 4u;
-        uint32_t next_offset = 0;
+  if (out_resolved_variables != NULL) {
+    *out_resolved_variables = resolved_variables;
+  }
+  if (out_resolved_functions != NULL) {
+    *out_resolved_functions = resolved_functions;
+  }
+  return true;
+}
+
+/* Decodes and resolves every entry into out_entries, leaving vm's own decode state alone. */
+bool bs_vm_decode_all(bs_vm *vm, bs_decoded_code *out_entries, size_t thread_count) {
+  if (vm == NULL || vm->game_data == NULL || out_entries == NULL) {
+    return false;
+  }
+  return bs_vm_decode_all_entries(vm, out_entries, thread_count, NULL, NULL, NULL);
+}
+
+void bs_vm_free_decoded(bs_decoded_code *entries, size_t count) {
+  if (entries == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    bs_decoded_code_free(&entries[i]);
+  }
+}
 
-        if (!bs_read_i32_le_bytes(entry->bytecode, entry->bytecode_length, ref_offset, &raw)) {
+static bool bs_vm_trace_specialize_enabled(void) {
+  static int initialized = 0;
+  static bool enabled = false;
+  if (!initialized) {
+    const char *env = getenv("BS_TRACE_SPECIALIZE");
+    enabled = (env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0));
+    initialized = 1;
+  }
+  return enabled;
+}
+
+static bool bs_vm_specialize_disabled_by_env(void) {
+  const char *env = getenv("BS_DISABLE_SPECIALIZE");
+  return env != NULL && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0);
+}
+
+static bool bs_vm_instruction_constant_number(const bs_instruction *instr, double *out_value) {
+  if (instr == NULL || out_value == NULL) {
+    return false;
+  }
+  if (instr->opcode == BS_OPCODE_PUSHI) {
+    *out_value = (double)instr->int_value;
+    return true;
+  }
+  if (instr->opcode != BS_OPCODE_PUSH) {
+    return false;
+  }
+  switch (instr->type1) {
+    case BS_DATA_TYPE_DOUBLE:
+      *out_value = instr->double_value;
+      return true;
+    case BS_DATA_TYPE_FLOAT:
+      *out_value = (double)instr->float_value;
+      return true;
+    case BS_DATA_TYPE_INT32:
+    case BS_DATA_TYPE_INT16:
+      *out_value = (double)instr->int_value;
+      return true;
+    case BS_DATA_TYPE_INT64:
+      *out_value = (double)instr->long_value;
+      return true;
+    case BS_DATA_TYPE_BOOLEAN:
+      *out_value = (instr->int_value != 0) ? 1.0 : 0.0;
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void bs_vm_instruction_make_constant(bs_instruction *instr, double value) {
+  instr->opcode = BS_OPCODE_PUSH;
+  instr->type1 = BS_DATA_TYPE_DOUBLE;
+  instr->type2 = 0;
+  instr->extra = 0;
+  instr->variable_index = -1;
+  instr->variable_type = -1;
+  instr->function_index = -1;
+  instr->double_value = value;
+}
+
+static void bs_vm_instruction_make_nop(bs_instruction *instr) {
+  instr->opcode = BS_VM_OPCODE_NOP;
+  instr->variable_index = -1;
+  instr->function_index = -1;
+}
+
+/* Returns the global read by instr when its value has been stable for the warm-up window. */
+static int32_t bs_vm_stable_global_read(bs_vm *vm, const bs_instruction *instr, double *out_value) {
+  int32_t variable_index = -1;
+  double builtin_value = 0.0;
+  bs_vm_value value = bs_vm_value_zero();
+
+  if (vm == NULL || instr == NULL || out_value == NULL || bs_vm_instruction_is_array(instr)) {
+    return -1;
+  }
+
+  if (instr->opcode == BS_OPCODE_PUSHGLB) {
+    if (!bs_vm_variable_is_global(vm, instr->variable_index)) {
+      return -1;
+    }
+  } else if (instr->opcode == BS_OPCODE_PUSH && instr->type1 == BS_DATA_TYPE_VARIABLE) {
+    if (bs_vm_instruction_is_stacktop(instr) ||
+        bs_vm_variable_effective_instance_type(vm, instr) != BS_INSTANCE_GLOBAL) {
+      return -1;
+    }
+  } else {
+    return -1;
+  }
+
+  variable_index = instr->variable_index;
+  if (variable_index < 0 ||
+      (size_t)variable_index >= vm->global_write_tracking_count ||
+      bs_vm_variable_is_argument_slot(vm, variable_index) ||
+      bs_vm_variable_is_argument_array(vm, variable_index) ||
+      vm->global_write_counts[(size_t)variable_index] == 0 ||
+      vm->execution_serial - vm->global_last_write_serials[(size_t)variable_index] < BS_VM_SPECIALIZE_WARMUP ||
+      !bs_vm_global_has_scalar(vm, variable_index) ||
+      bs_vm_try_get_known_global_builtin(vm, variable_index, &builtin_value)) {
+    return -1;
+  }
+
+  value = bs_vm_global_get_or_zero(vm, variable_index);
+  if (value.type != BS_VM_VALUE_NUMBER) {
+    return -1;
+  }
+
+  *out_value = value.number;
+  return variable_index;
+}
+
+static void bs_vm_mark_branch_targets(const bs_decoded_code *decoded, bool *targets) {
+  for (size_t i = 0; i < decoded->instruction_count; i++) {
+    const bs_instruction *instr = &decoded->instructions[i];
+    size_t target = 0;
+    if (instr->opcode != BS_OPCODE_B &&
+        instr->opcode != BS_OPCODE_BT &&
+        instr->opcode != BS_OPCODE_BF &&
+        instr->opcode != BS_OPCODE_PUSHENV &&
+        instr->opcode != BS_OPCODE_POPENV) {
+      continue;
+    }
+    if (bs_vm_find_branch_target(decoded, i, bs_vm_branch_offset(instr->raw_operand), &target)) {
+      targets[target] = true;
+    }
+  }
+}
+
+/* Folds constant pushes into CMP/NOT/CONV/BT/BF. Instruction count and offsets are preserved so
+ * specialized and generic code share pc values and branch targets. */
+static uint32_t bs_vm_fold_constant_branches(bs_instruction *instructions, size_t count, const bool *targets) {
+  uint32_t folded_branches = 0;
+
+  for (size_t i = 1; i < count; i++) {
+    bs_instruction *instr = &instructions[i];
+    double lhs = 0.0;
+    double rhs = 0.0;
+
+    if (targets[i] || !bs_vm_instruction_constant_number(&instructions[i - 1], &rhs)) {
+      continue;
+    }
+
+    switch (instr->opcode) {
+      case BS_OPCODE_CMP: {
+        uint8_t comparison_type = (uint8_t)((instr->raw_operand >> 8) & 0xFFu);
+        int cmp = 0;
+        if (i < 2 || targets[i - 1] || !bs_vm_instruction_constant_number(&instructions[i - 2], &lhs)) {
           break;
         }
+        cmp = bs_vm_compare_values(bs_vm_value_number(lhs), bs_vm_value_number(rhs));
+        bs_vm_instruction_make_nop(&instructions[i - 2]);
+        bs_vm_instruction_make_nop(&instructions[i - 1]);
+        bs_vm_instruction_make_constant(instr, bs_vm_compare_bool(cmp, comparison_type) ? 1.0 : 0.0);
+        break;
+      }
+
+      case BS_OPCODE_NOT:
+        bs_vm_instruction_make_nop(&instructions[i - 1]);
+        bs_vm_instruction_make_constant(instr, (rhs != 0.0) ? 0.0 : 1.0);
+        break;
+
+      case BS_OPCODE_CONV:
+        bs_vm_instruction_make_nop(&instructions[i - 1]);
+        bs_vm_instruction_make_constant(instr, rhs);
+        break;
 
-        next_offset = ((uint32_t)raw) & 0x07FFFFFFu;
-        instr_addr += next_offset;
+      case BS_OPCODE_BT:
+      case BS_OPCODE_BF: {
+        bool cond = bs_vm_value_to_bool(bs_vm_value_number(rhs));
+        bool should_branch = ((instr->opcode == BS_OPCODE_BT && cond) ||
+                              (instr->opcode == BS_OPCODE_BF && !cond));
+        bs_vm_instruction_make_nop(&instructions[i - 1]);
+        if (should_branch) {
+          instr->opcode = BS_OPCODE_B;
+        } else {
+          bs_vm_instruction_make_nop(instr);
+        }
+        folded_branches++;
+        break;
       }
+
+      default:
+        break;
     }
   }
 
-  return resolved;
+  return folded_branches;
+}
+
+static void bs_vm_deoptimize_entry(bs_vm *vm, size_t code_entry_index) {
+  bs_specialized_code *spec = &vm->specialized_entries[code_entry_index];
+
+  for (size_t i = 0; i < spec->global_count; i++) {
+    int32_t variable_index = spec->global_indices[i];
+    if (vm->global_specialized_refs[(size_t)variable_index] > 0) {
+      vm->global_specialized_refs[(size_t)variable_index]--;
+    }
+  }
+  spec->global_count = 0;
+  spec->valid = false;
+  spec->execution_count = 0;
+  vm->deoptimized_entry_total++;
+
+  if (bs_vm_trace_specialize_enabled()) {
+    printf("  [VM DEOPT] code=%zu '%s'\n",
+           code_entry_index,
+           vm->game_data->code_entries[code_entry_index].name != NULL
+               ? vm->game_data->code_entries[code_entry_index].name
+               : "<unnamed>");
+  }
+}
+
+void bs_vm_note_global_write(bs_vm *vm, int32_t variable_index) {
+  if (vm == NULL ||
+      variable_index < 0 ||
+      (size_t)variable_index >= vm->global_write_tracking_count) {
+    return;
+  }
+
+  vm->global_write_counts[(size_t)variable_index]++;
+  vm->global_last_write_serials[(size_t)variable_index] = vm->execution_serial;
+  if (vm->global_specialized_refs[(size_t)variable_index] == 0 || vm->specialized_entries == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+    bs_specialized_code *spec = &vm->specialized_entries[i];
+    if (!spec->valid) {
+      continue;
+    }
+    for (size_t j = 0; j < spec->global_count; j++) {
+      if (spec->global_indices[j] == variable_index) {
+        bs_vm_deoptimize_entry(vm, i);
+        break;
+      }
+    }
+  }
+}
+
+static bool bs_vm_specialize_entry(bs_vm *vm, size_t code_entry_index) {
+  const bs_decoded_code *generic = &vm->decoded_entries[code_entry_index];
+  bs_specialized_code *spec = &vm->specialized_entries[code_entry_index];
+  size_t count = generic->instruction_count;
+  bool *targets = NULL;
+  uint32_t folded_loads = 0;
+  uint32_t folded_branches = 0;
+
+  if (count == 0) {
+    return false;
+  }
+
+  if (spec->code.instructions == NULL) {
+    spec->code.instructions = (bs_instruction *)malloc(count * sizeof(bs_instruction));
+    spec->global_indices = (int32_t *)malloc(count * sizeof(int32_t));
+    if (spec->code.instructions == NULL || spec->global_indices == NULL) {
+      free(spec->code.instructions);
+      free(spec->global_indices);
+      spec->code.instructions = NULL;
+      spec->global_indices = NULL;
+      return false;
+    }
+  }
+  spec->code.instruction_offsets = generic->instruction_offsets;
+  spec->code.instruction_count = count;
+  spec->global_count = 0;
+  memcpy(spec->code.instructions, generic->instructions, count * sizeof(bs_instruction));
+
+  for (size_t i = 0; i < count; i++) {
+    double value = 0.0;
+    int32_t variable_index = bs_vm_stable_global_read(vm, &spec->code.instructions[i], &value);
+    bool seen = false;
+    if (variable_index < 0) {
+      continue;
+    }
+    bs_vm_instruction_make_constant(&spec->code.instructions[i], value);
+    folded_loads++;
+    for (size_t j = 0; j < spec->global_count; j++) {
+      if (spec->global_indices[j] == variable_index) {
+        seen = true;
+        break;
+      }
+    }
+    if (!seen) {
+      spec->global_indices[spec->global_count++] = variable_index;
+    }
+  }
+
+  if (folded_loads == 0) {
+    return false;
+  }
+
+  targets = (bool *)calloc(count, sizeof(bool));
+  if (targets == NULL) {
+    spec->global_count = 0;
+    return false;
+  }
+  bs_vm_mark_branch_targets(generic, targets);
+  folded_branches = bs_vm_fold_constant_branches(spec->code.instructions, count, targets);
+  free(targets);
+
+  for (size_t j = 0; j < spec->global_count; j++) {
+    vm->global_specialized_refs[(size_t)spec->global_indices[j]]++;
+  }
+  spec->valid = true;
+  vm->specialized_entry_total++;
+
+  if (bs_vm_trace_specialize_enabled()) {
+    printf("  [VM SPECIALIZE] code=%zu '%s' globals=%zu loads=%u branches=%u\n",
+           code_entry_index,
+           vm->game_data->code_entries[code_entry_index].name != NULL
+               ? vm->game_data->code_entries[code_entry_index].name
+               : "<unnamed>",
+           spec->global_count,
+           folded_loads,
+           folded_branches);
+  }
+  return true;
+}
+
+static const bs_decoded_code *bs_vm_enter_code_entry(bs_vm *vm, size_t code_entry_index) {
+  bs_specialized_code *spec = NULL;
+
+  vm->execution_serial++;
+  if (vm->specialized_entries == NULL) {
+    return &vm->decoded_entries[code_entry_index];
+  }
+
+  spec = &vm->specialized_entries[code_entry_index];
+  if (!spec->valid && vm->specialize_enabled && vm->runner != NULL && spec->active_depth == 0) {
+    spec->execution_count++;
+    if (spec->execution_count >= spec->attempt_threshold) {
+      spec->execution_count = 0;
+      if (!bs_vm_specialize_entry(vm, code_entry_index) &&
+          spec->attempt_threshold < BS_VM_SPECIALIZE_MAX_THRESHOLD) {
+        spec->attempt_threshold *= 2u;
+      }
+    }
+  }
+
+  spec->active_depth++;
+  return spec->valid ? &spec->code : &vm->decoded_entries[code_entry_index];
+}
+
+static void bs_vm_leave_code_entry(bs_vm *vm, size_t code_entry_index) {
+  if (vm->specialized_entries != NULL && vm->specialized_entries[code_entry_index].active_depth > 0) {
+    vm->specialized_entries[code_entry_index].active_depth--;
+  }
 }
 
 static bool bs_vm_execute_code_internal(bs_vm *vm,
@@ -2755,6 +3379,7 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
   bs_vm_locals locals = {0};
   bs_vm_env_stack env_stack = {0};
   const bs_decoded_code *decoded = NULL;
+  const bs_decoded_code *generic_decoded = NULL;
   size_t pc = 0;
   int32_t entry_self_id = -4;
   int32_t entry_other_id = -4;
@@ -2769,14 +3394,16 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
       !vm->initialized ||
       vm->game_data == NULL ||
       code_entry_index >= vm->decoded_entry_count ||
-      code_entry_index >= vm->game_data->code_entry_count) {
+      code_entry_index >= vm->game_data->code_entry_count ||
+      !bs_vm_ensure_decoded(vm, code_entry_index)) {
     if (out_result != NULL) {
       *out_result = result;
     }
     return false;
   }
 
-  decoded = &vm->decoded_entries[code_entry_index];
+  generic_decoded = &vm->decoded_entries[code_entry_index];
+  decoded = bs_vm_enter_code_entry(vm, code_entry_index);
   entry_self_id = vm->current_self_id;
   entry_other_id = vm->current_other_id;
   if (max_instructions == 0) {
@@ -2787,6 +3414,9 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
   }
 
   while (pc < decoded->instruction_count && result.instructions_executed < max_instructions) {
+    if (decoded != generic_decoded && !vm->specialized_entries[code_entry_index].valid) {
+      decoded = generic_decoded;
+    }
     const bs_instruction *instr = &decoded->instructions[pc];
     size_t current_instr_index = pc;
     uint8_t opcode = instr->opcode;
@@ -3446,26 +4076,15 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
       }
 
       case BS_OPCODE_PUSHENV: {
-        int32_t *instance_ids = NULL;
-        size_t instance_count = 0;
-        size_t first_index = 0;
-        int32_t first_instance_id = -4;
+        const bs_instance *first = NULL;
         bs_vm_env_iteration frame = {0};
         int32_t branch_offset = bs_vm_branch_offset(instr->raw_operand);
         int32_t target_id = (int32_t)bs_vm_value_to_number(bs_vm_stack_pop_or_zero(&stack));
 
-        if (!bs_vm_collect_target_instance_ids(vm, target_id, &instance_ids, &instance_count)) {
-          goto execution_error;
-        }
-
-        if (!bs_vm_find_next_alive_instance_id(vm,
-                                               instance_ids,
-                                               instance_count,
-                                               0u,
-                                               &first_index,
-                                               &first_instance_id)) {
+        bs_game_runner_iterate_instances(vm->runner, target_id, &frame.instances);
+        first = bs_game_runner_iterator_next(vm->runner, &frame.instances);
+        if (first == NULL) {
           size_t target = 0;
-          free(instance_ids);
           if (!bs_vm_find_branch_target(decoded, current_instr_index, branch_offset, &target)) {
             if (trace) {
               uint32_t cur_off = decoded->instruction_offsets[current_instr_index];
@@ -3484,37 +4103,25 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
           break;
         }
 
-        frame.instance_ids = instance_ids;
-        frame.instance_count = instance_count;
-        frame.current_index = first_index;
         frame.prev_self_id = vm->current_self_id;
         frame.prev_other_id = vm->current_other_id;
         if (!bs_vm_env_stack_push(&env_stack, frame)) {
-          free(instance_ids);
           goto execution_error;
         }
 
         vm->current_other_id = vm->current_self_id;
-        vm->current_self_id = first_instance_id;
+        vm->current_self_id = first->id;
         break;
       }
 
       case BS_OPCODE_POPENV: {
         bs_vm_env_iteration *iter = bs_vm_env_stack_last(&env_stack);
         if (iter != NULL) {
-          size_t next_index = iter->current_index + 1u;
-          size_t found_index = 0;
-          int32_t found_instance_id = -4;
-          if (bs_vm_find_next_alive_instance_id(vm,
-                                                iter->instance_ids,
-                                                iter->instance_count,
-                                                next_index,
-                                                &found_index,
-                                                &found_instance_id)) {
+          const bs_instance *next = bs_game_runner_iterator_next(vm->runner, &iter->instances);
+          if (next != NULL) {
             size_t target = 0;
             int32_t branch_offset = bs_vm_branch_offset(instr->raw_operand);
-            iter->current_index = found_index;
-            vm->current_self_id = found_instance_id;
+            vm->current_self_id = next->id;
             if (!bs_vm_find_branch_target(decoded, current_instr_index, branch_offset, &target)) {
               if (trace) {
                 uint32_t cur_off = decoded->instruction_offsets[current_instr_index];
@@ -3628,6 +4235,7 @@ static bool bs_vm_execute_code_internal(bs_vm *vm,
   goto execution_done;
 
 execution_error:
+  bs_vm_leave_code_entry(vm, code_entry_index);
   vm->current_self_id = entry_self_id;
   vm->current_other_id = entry_other_id;
   result.ok = false;
@@ -3641,6 +4249,7 @@ execution_error:
   return false;
 
 execution_done:
+  bs_vm_leave_code_entry(vm, code_entry_index);
   vm->current_self_id = entry_self_id;
   vm->current_other_id = entry_other_id;
   result.ok = true;
@@ -3688,9 +4297,18 @@ bool bs_vm_execute_code_with_args(bs_vm *vm,
 }
 
 void bs_vm_init(bs_vm *vm, const bs_game_data *game_data) {
+  bs_vm_init_with_image(vm, game_data, NULL);
+}
+
+/* With a validated image every entry is adopted as a view into it: nothing is decoded and no
+ * reference chain is walked. The image must outlive the VM. */
+void bs_vm_init_with_image(bs_vm *vm, const bs_game_data *game_data, const bs_image *image) {
   uint32_t resolved_variables = 0;
   uint32_t resolved_functions = 0;
   const char *debug_code_env = NULL;
+  double init_start_millis = bs_vm_now_millis();
+  double phase_start_millis = 0.0;
+  bs_load_phase *phase = NULL;
 
   if (vm == NULL) {
     return;
@@ -3700,12 +4318,31 @@ void bs_vm_init(bs_vm *vm, const bs_game_data *game_data) {
   vm->runner = NULL;
   vm->decoded_entries = NULL;
   vm->decoded_entry_count = 0;
+  vm->decoded_entry_ready = NULL;
+  vm->entry_patches = NULL;
+  vm->decoded_ready_count = 0;
+  vm->decoded_resident_bytes = 0;
+  vm->lazy_decode = !bs_vm_eager_decode_requested();
+  vm->image_backed = false;
+  vm->resolved_variable_count = 0;
+  vm->resolved_function_count = 0;
+  vm->init_millis = 0.0;
+  bs_load_stats_reset(&vm->load_stats);
   vm->code_ranges = NULL;
   vm->code_range_count = 0;
+  vm->specialized_entries = NULL;
+  vm->specialize_enabled = !bs_vm_specialize_disabled_by_env();
+  vm->execution_serial = 0;
+  vm->specialized_entry_total = 0;
+  vm->deoptimized_entry_total = 0;
   vm->global_variable_indices = NULL;
   vm->global_variable_values = NULL;
   vm->global_variable_count = 0;
   vm->global_variable_capacity = 0;
+  vm->global_write_counts = NULL;
+  vm->global_last_write_serials = NULL;
+  vm->global_specialized_refs = NULL;
+  vm->global_write_tracking_count = 0;
   vm->global_array_variable_indices = NULL;
   vm->global_array_element_indices = NULL;
   vm->global_array_values = NULL;
@@ -3762,33 +4399,99 @@ void bs_vm_init(bs_vm *vm, const bs_game_data *game_data) {
   }
   vm->unknown_function_logged_count = game_data->function_count;
 
+  if (game_data->variable_count > 0) {
+    vm->global_write_counts = (uint32_t *)calloc(game_data->variable_count, sizeof(uint32_t));
+    vm->global_last_write_serials = (uint64_t *)calloc(game_data->variable_count, sizeof(uint64_t));
+    vm->global_specialized_refs = (uint32_t *)calloc(game_data->variable_count, sizeof(uint32_t));
+    if (vm->global_write_counts == NULL ||
+        vm->global_last_write_serials == NULL ||
+        vm->global_specialized_refs == NULL) {
+      bs_vm_dispose(vm);
+      return;
+    }
+  }
+  vm->global_write_tracking_count = game_data->variable_count;
+
   if (game_data->code_entry_count > 0) {
     vm->decoded_entries =
         (bs_decoded_code *)calloc(game_data->code_entry_count, sizeof(bs_decoded_code));
-    if (vm->decoded_entries == NULL) {
+    vm->decoded_entry_ready = (bool *)calloc(game_data->code_entry_count, sizeof(bool));
+    vm->entry_patches =
+        (bs_code_patch_list *)calloc(game_data->code_entry_count, sizeof(bs_code_patch_list));
+    if (vm->decoded_entries == NULL || vm->decoded_entry_ready == NULL || vm->entry_patches == NULL) {
+      bs_vm_dispose(vm);
       return;
     }
   }
   vm->decoded_entry_count = game_data->code_entry_count;
 
-  for (size_t i = 0; i < vm->decoded_entry_count; i++) {
-    if (!bs_decode_bytecode(&game_data->code_entries[i], &vm->decoded_entries[i])) {
-      fprintf(stderr, "Failed to decode bytecode for CODE[%zu] '%s'\n",
-              i,
-              game_data->code_entries[i].name != NULL ? game_data->code_entries[i].name : "<unnamed>");
+  if (vm->decoded_entry_count > 0) {
+    vm->specialized_entries =
+        (bs_specialized_code *)calloc(vm->decoded_entry_count, sizeof(bs_specialized_code));
+    if (vm->specialized_entries == NULL) {
       bs_vm_dispose(vm);
       return;
     }
+    for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+      vm->specialized_entries[i].attempt_threshold = BS_VM_SPECIALIZE_HOT_COUNT;
+    }
   }
 
+  phase_start_millis = bs_vm_now_millis();
   if (!bs_build_code_ranges(vm)) {
     fprintf(stderr, "Failed to build CODE ranges for VM\n");
     bs_vm_dispose(vm);
     return;
   }
+  phase = bs_load_stats_add(&vm->load_stats, "vm", "code_ranges", bs_vm_now_millis() - phase_start_millis);
+  if (phase != NULL) {
+    phase->items = vm->code_range_count;
+    phase->allocations = vm->code_range_count > 0 ? 1u : 0u;
+    phase->bytes = vm->code_range_count * sizeof(bs_code_range);
+  }
 
-  resolved_variables = bs_resolve_variable_chains(vm);
-  resolved_functions = bs_resolve_function_chains(vm);
+  phase_start_millis = bs_vm_now_millis();
+  if (image != NULL && image->code_entry_count == vm->decoded_entry_count) {
+    for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+      if (!bs_image_code_entry(image, i, &vm->decoded_entries[i])) {
+        bs_vm_dispose(vm);
+        return;
+      }
+      bs_vm_mark_decoded(vm, i);
+    }
+    vm->image_backed = true;
+    vm->lazy_decode = false;
+    resolved_variables = image->resolved_variables;
+    resolved_functions = image->resolved_functions;
+    phase = bs_load_stats_add(&vm->load_stats, "vm", "image_adopt", bs_vm_now_millis() - phase_start_millis);
+    if (phase != NULL) {
+      phase->items = vm->decoded_entry_count;
+    }
+  } else if (vm->lazy_decode) {
+    resolved_variables = bs_resolve_variable_chains(vm, NULL, 0, 1);
+    resolved_functions = bs_resolve_function_chains(vm, NULL, 0, 1);
+    phase = bs_load_stats_add(&vm->load_stats, "vm", "resolve_chains", bs_vm_now_millis() - phase_start_millis);
+    if (phase != NULL) {
+      phase->items = (size_t)resolved_variables + (size_t)resolved_functions;
+      for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+        phase->allocations += vm->entry_patches[i].capacity > 0 ? 1u : 0u;
+        phase->bytes += vm->entry_patches[i].capacity * sizeof(bs_code_patch);
+      }
+    }
+  } else {
+    if (!bs_vm_decode_all_entries(vm,
+                                  vm->decoded_entries,
+                                  bs_system_thread_count("BS_DECODE_THREADS", BS_VM_MAX_INIT_THREADS),
+                                  &resolved_variables,
+                                  &resolved_functions,
+                                  &vm->load_stats)) {
+      bs_vm_dispose(vm);
+      return;
+    }
+    for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+      bs_vm_mark_decoded(vm, i);
+    }
+  }
 
   if (debug_code_env != NULL && strcmp(debug_code_env, "1") == 0) {
     int debug_codes[] = {419, 420, 522, 524, 5507};
@@ -3797,6 +4500,9 @@ void bs_vm_init(bs_vm *vm, const bs_game_data *game_data) {
       if (code_id >= 0 && (size_t)code_id < vm->game_data->code_entry_count) {
         const bs_code_entry_data *entry = &vm->game_data->code_entries[(size_t)code_id];
         const bs_decoded_code *decoded = &vm->decoded_entries[(size_t)code_id];
+        if (!bs_vm_ensure_decoded(vm, (size_t)code_id)) {
+          continue;
+        }
         printf("  [DEBUG CODE] id=%d name=%s bytecode_len=%u instr_count=%zu\n",
                code_id,
                entry->name != NULL ? entry->name : "<unnamed>",
@@ -3806,8 +4512,16 @@ void bs_vm_init(bs_vm *vm, const bs_game_data *game_data) {
     }
   }
 
+  vm->resolved_variable_count = resolved_variables;
+  vm->resolved_function_count = resolved_functions;
   vm->initialized = true;
-  printf("VM initialized: %zu code entries decoded\n", vm->decoded_entry_count);
+  vm->init_millis = bs_vm_now_millis() - init_start_millis;
+  printf("VM initialized: %zu/%zu code entries decoded (%s) in %.2f ms, %zu bytes resident\n",
+         vm->decoded_ready_count,
+         vm->decoded_entry_count,
+         vm->image_backed ? "image" : (vm->lazy_decode ? "lazy" : "eager"),
+         vm->init_millis,
+         vm->decoded_resident_bytes);
   printf("  Resolved %u variable references\n", resolved_variables);
   printf("  Resolved %u function references\n", resolved_functions);
 }
@@ -3817,14 +4531,38 @@ void bs_vm_dispose(bs_vm *vm) {
     return;
   }
 
-  if (vm->decoded_entries != NULL) {
+  if (vm->specialized_entries != NULL) {
     for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+      free(vm->specialized_entries[i].code.instructions);
+      free(vm->specialized_entries[i].global_indices);
+    }
+    free(vm->specialized_entries);
+  }
+  vm->specialized_entries = NULL;
+  vm->execution_serial = 0;
+  vm->specialized_entry_total = 0;
+  vm->deoptimized_entry_total = 0;
+
+  if (vm->decoded_entries != NULL) {
+    for (size_t i = 0; i < vm->decoded_entry_count && !vm->image_backed; i++) {
       bs_decoded_code_free(&vm->decoded_entries[i]);
     }
     free(vm->decoded_entries);
   }
+  if (vm->entry_patches != NULL) {
+    for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+      free(vm->entry_patches[i].patches);
+    }
+    free(vm->entry_patches);
+  }
+  free(vm->decoded_entry_ready);
   vm->decoded_entries = NULL;
   vm->decoded_entry_count = 0;
+  vm->decoded_entry_ready = NULL;
+  vm->entry_patches = NULL;
+  vm->decoded_ready_count = 0;
+  vm->decoded_resident_bytes = 0;
+  vm->image_backed = false;
 
   free(vm->code_ranges);
   vm->code_ranges = NULL;
@@ -3845,6 +4583,14 @@ void bs_vm_dispose(bs_vm *vm) {
   vm->global_array_count = 0;
   vm->global_array_capacity = 0;
 
+  free(vm->global_write_counts);
+  free(vm->global_last_write_serials);
+  free(vm->global_specialized_refs);
+  vm->global_write_counts = NULL;
+  vm->global_last_write_serials = NULL;
+  vm->global_specialized_refs = NULL;
+  vm->global_write_tracking_count = 0;
+
   free(vm->instance_variable_instance_ids);
   free(vm->instance_variable_indices);
   free(vm->instance_variable_values);
@@ -3902,3 +4648,23 @@ void bs_vm_dispose(bs_vm *vm) {
   vm->unknown_function_logged = NULL;
   vm->unknown_function_logged_count = 0;
 }
+
+/* Decodes whatever lazy init left pending and writes the linked code for the current data.win. */
+bool bs_vm_write_image(bs_vm *vm, const char *path) {
+  if (vm == NULL || !vm->initialized || path == NULL) {
+    return false;
+  }
+
+  for (size_t i = 0; i < vm->decoded_entry_count; i++) {
+    if (!bs_vm_ensure_decoded(vm, i)) {
+      return false;
+    }
+  }
+
+  return bs_image_write(path,
+                        vm->game_data,
+                        vm->decoded_entries,
+                        vm->decoded_entry_count,
+                        vm->resolved_variable_count,
+                        vm->resolved_function_count);
+}
@@ -0,0 +1,10 @@
+#ifndef BS_VM_VM_INTERNAL_H
+#define BS_VM_VM_INTERNAL_H
+
+#include "bs/vm/vm.h"
+
+/* Decoder entry points for the bench executable; not part of the public API. */
+bool bs_vm_decode_all(bs_vm *vm, bs_decoded_code *out_entries, size_t thread_count);
+void bs_vm_free_decoded(bs_decoded_code *entries, size_t count);
+
+#endif